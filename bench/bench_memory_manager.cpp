@@ -0,0 +1,634 @@
+/*
+ *  bench_memory_manager.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module measures the performance of the MemoryManager and
+ *      MemoryAllocator relative to malloc(), operator new, and the std::pmr
+ *      pool resources.  The following workloads are measured:
+ *
+ *          pairs       Allocate and immediately free a block
+ *          burst       Allocate a number of blocks, then free them all
+ *          cross       One thread allocates blocks that another thread frees
+ *          contention  Several threads allocate and free blocks at once
+ *          vector      Grow a std::vector one element at a time
+ *          list        Push and pop elements on a std::list
+ *          map         Insert and erase elements in a std::map
+ *
+ *      To measure a new allocator or MemoryManager configuration, add an
+ *      entry to the vector returned by Subjects() (or Allocators() for the
+ *      container workloads).
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include <terra/memory_manager/memory_manager.h>
+#include <terra/memory_manager/memory_allocator.h>
+#include <terra/memory_manager/memory_resource.h>
+#include <terra/memory_manager/static_memory_manager.h>
+#include "benchmark.h"
+
+namespace
+{
+
+using namespace Terra::MemoryManager;
+using namespace Terra::MemoryManager::Bench;
+
+// Define an interface to the allocators measured
+class Subject
+{
+    public:
+        virtual ~Subject() = default;
+        virtual void *Allocate(std::size_t size) = 0;
+        virtual void Free(void *p, std::size_t size) = 0;
+};
+
+// Subject using malloc() and free()
+class MallocSubject : public Subject
+{
+    public:
+        void *Allocate(std::size_t size) override { return std::malloc(size); }
+        void Free(void *p, std::size_t) override { std::free(p); }
+};
+
+// Subject using operator new and operator delete
+class NewSubject : public Subject
+{
+    public:
+        void *Allocate(std::size_t size) override
+        {
+            return ::operator new(size);
+        }
+        void Free(void *p, std::size_t size) override
+        {
+            ::operator delete(p, size);
+        }
+};
+
+// Subject using a std::pmr memory resource
+template<typename Resource>
+class ResourceSubject : public Subject
+{
+    public:
+        void *Allocate(std::size_t size) override
+        {
+            return resource.allocate(size);
+        }
+        void Free(void *p, std::size_t size) override
+        {
+            resource.deallocate(p, size);
+        }
+
+    protected:
+        Resource resource;
+};
+
+// Subject using the MemoryManager
+class ManagerSubject : public Subject
+{
+    public:
+        ManagerSubject(const MemoryProfile &profile,
+                       const ManagerOptions &options) :
+            memory_manager(profile, options, {}, false)
+        {
+        }
+        void *Allocate(std::size_t size) override
+        {
+            return memory_manager.Allocate(size);
+        }
+        void Free(void *p, std::size_t size) override
+        {
+            memory_manager.Free(p, size);
+        }
+
+    protected:
+        MemoryManager memory_manager;
+};
+
+// Memory profile used by the StaticMemoryManager, which requires maximums
+using StaticBenchmarkManager = StaticMemoryManager<
+    // Size, Minimum, Maximum, Excess Allowed
+    MemoryDescriptor{    32,    1024,    4096, true },
+    MemoryDescriptor{    64,    1024,    4096, true },
+    MemoryDescriptor{   128,    1024,    4096, true },
+    MemoryDescriptor{   256,     512,    2048, true },
+    MemoryDescriptor{   512,     256,    1024, true },
+    MemoryDescriptor{  1024,     256,    1024, true },
+    MemoryDescriptor{  1500,     512,    2048, true },
+    MemoryDescriptor{  4096,      64,     256, true },
+    MemoryDescriptor{ 16384,      16,      64, true },
+    MemoryDescriptor{ 65536,       4,      16, true },
+    MemoryDescriptor{262144,       0,       4, true }>;
+
+// Subject using the StaticMemoryManager
+class StaticManagerSubject : public Subject
+{
+    public:
+        void *Allocate(std::size_t size) override
+        {
+            return memory_manager.Allocate(size);
+        }
+        void Free(void *p, std::size_t size) override
+        {
+            memory_manager.Free(p, size);
+        }
+
+    protected:
+        StaticBenchmarkManager memory_manager;
+};
+
+// Define a structure describing how to create a subject
+struct SubjectFactory
+{
+    std::string name;                           // Name used in results
+    bool thread_safe;                           // May be used by many threads
+    std::function<std::unique_ptr<Subject>()> create;
+};
+
+// Memory profile used by all MemoryManager configurations
+MemoryProfile BenchmarkProfile()
+{
+    return
+    {
+        // Size, Minimum, Maximum, Excess Allowed, Slab Blocks
+        {    32,    1024,       0, true,           256 },
+        {    64,    1024,       0, true,           256 },
+        {   128,    1024,       0, true,           256 },
+        {   256,     512,       0, true,           128 },
+        {   512,     256,       0, true,           64  },
+        {  1024,     256,       0, true,           64  },
+        {  1500,     512,       0, true,           64  },
+        {  4096,      64,       0, true,           16  },
+        { 16384,      16,       0, true                },
+        { 65536,       4,       0, true                },
+        {262144,       0,       0, true                }
+    };
+}
+
+// Memory profile with each descriptor's free list split into stripes
+MemoryProfile StripedProfile()
+{
+    MemoryProfile profile = BenchmarkProfile();
+    for (MemoryDescriptor &descriptor : profile) descriptor.stripes = 8;
+
+    return profile;
+}
+
+// Return a factory for the MemoryManager with the given options
+SubjectFactory ManagerFactory(const std::string &name,
+                              const ManagerOptions &options,
+                              const MemoryProfile &profile = BenchmarkProfile())
+{
+    return {name,
+            true,
+            [options, profile]() -> std::unique_ptr<Subject>
+            {
+                return std::make_unique<ManagerSubject>(profile, options);
+            }};
+}
+
+// Return the list of subjects to measure
+std::vector<SubjectFactory> Subjects()
+{
+    std::vector<SubjectFactory> subjects =
+    {
+        {"malloc",
+         true,
+         []() -> std::unique_ptr<Subject>
+         {
+             return std::make_unique<MallocSubject>();
+         }},
+        {"new",
+         true,
+         []() -> std::unique_ptr<Subject>
+         {
+             return std::make_unique<NewSubject>();
+         }},
+        {"pmr_unsync",
+         false,
+         []() -> std::unique_ptr<Subject>
+         {
+             return std::make_unique<
+                 ResourceSubject<std::pmr::unsynchronized_pool_resource>>();
+         }},
+        {"pmr_sync",
+         true,
+         []() -> std::unique_ptr<Subject>
+         {
+             return std::make_unique<
+                 ResourceSubject<std::pmr::synchronized_pool_resource>>();
+         }}
+    };
+
+    ManagerOptions options{};
+    subjects.push_back(ManagerFactory("mm", options));
+
+    options = {};
+    options.validate_blocks = false;
+    subjects.push_back(ManagerFactory("mm_novalidate", options));
+
+    options = {};
+    options.compact_headers = true;
+    subjects.push_back(ManagerFactory("mm_compact", options));
+
+    options = {};
+    options.thread_cache = true;
+    subjects.push_back(ManagerFactory("mm_cache", options));
+
+    options = {};
+    subjects.push_back(ManagerFactory("mm_striped", options, StripedProfile()));
+
+    options = {};
+    options.lock_free = true;
+    subjects.push_back(ManagerFactory("mm_lockfree", options));
+
+    subjects.push_back({"mm_static",
+                        true,
+                        []() -> std::unique_ptr<Subject>
+                        {
+                            return std::make_unique<StaticManagerSubject>();
+                        }});
+
+    return subjects;
+}
+
+// Allocate and immediately free a block
+std::size_t Pairs(Subject &subject, std::size_t size, std::size_t operations)
+{
+    for (std::size_t i = 0; i < operations; i++)
+    {
+        void *p = subject.Allocate(size);
+        DoNotOptimize(p);
+        subject.Free(p, size);
+    }
+
+    return operations;
+}
+
+// Allocate a burst of blocks, then free them all
+std::size_t Burst(Subject &subject,
+                  std::size_t size,
+                  std::size_t burst,
+                  std::size_t operations)
+{
+    std::vector<void *> blocks(burst);
+
+    const std::size_t rounds = std::max(operations / burst, std::size_t{1});
+    for (std::size_t round = 0; round < rounds; round++)
+    {
+        for (auto &p : blocks)
+        {
+            p = subject.Allocate(size);
+            DoNotOptimize(p);
+        }
+        for (auto *p : blocks) subject.Free(p, size);
+    }
+
+    return rounds * burst;
+}
+
+// One thread allocates blocks that are freed by another thread
+std::size_t CrossThread(Subject &subject,
+                        std::size_t size,
+                        std::size_t operations)
+{
+    constexpr std::size_t Ring_Size = 1024;
+    std::vector<std::atomic<void *>> ring(Ring_Size);
+
+    std::thread consumer(
+        [&]()
+        {
+            for (std::size_t i = 0; i < operations; i++)
+            {
+                std::atomic<void *> &slot = ring[i % Ring_Size];
+                void *p = nullptr;
+                while (p == nullptr)
+                {
+                    p = slot.exchange(nullptr, std::memory_order_acquire);
+                    if (p == nullptr) std::this_thread::yield();
+                }
+                subject.Free(p, size);
+            }
+        });
+
+    for (std::size_t i = 0; i < operations; i++)
+    {
+        std::atomic<void *> &slot = ring[i % Ring_Size];
+        void *p = subject.Allocate(size);
+        DoNotOptimize(p);
+        while (slot.load(std::memory_order_relaxed) != nullptr)
+        {
+            std::this_thread::yield();
+        }
+        slot.store(p, std::memory_order_release);
+    }
+
+    consumer.join();
+
+    return operations;
+}
+
+// Several threads allocate and free blocks at once, each keeping a small
+// number of blocks outstanding
+std::size_t Contention(Subject &subject,
+                       std::size_t size,
+                       std::size_t thread_count,
+                       std::size_t operations)
+{
+    constexpr std::size_t Outstanding = 16;
+    const std::size_t per_thread = operations / thread_count;
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < thread_count; t++)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                void *blocks[Outstanding] = {};
+                for (std::size_t i = 0; i < per_thread; i++)
+                {
+                    void *&p = blocks[i % Outstanding];
+                    if (p != nullptr) subject.Free(p, size);
+                    p = subject.Allocate(size);
+                    DoNotOptimize(p);
+                }
+                for (void *p : blocks)
+                {
+                    if (p != nullptr) subject.Free(p, size);
+                }
+            });
+    }
+    for (auto &thread : threads) thread.join();
+
+    return per_thread * thread_count;
+}
+
+// Define a structure describing an allocator for the container workloads
+struct AllocatorFactory
+{
+    std::string name;                           // Name used in results
+    std::function<std::size_t(const std::string &, std::size_t)> run;
+};
+
+// Grow a vector one element at a time, clearing it periodically
+template<typename Allocator>
+std::size_t VectorWorkload(const Allocator &allocator, std::size_t operations)
+{
+    using IntAllocator =
+        typename std::allocator_traits<Allocator>::template rebind_alloc<int>;
+    constexpr std::size_t Maximum_Elements = 16384;
+
+    std::size_t performed = 0;
+    while (performed < operations)
+    {
+        std::vector<int, IntAllocator> v{IntAllocator(allocator)};
+        for (std::size_t i = 0; i < Maximum_Elements; i++)
+        {
+            v.push_back(static_cast<int>(i));
+        }
+        DoNotOptimize(v.data());
+        performed += Maximum_Elements;
+    }
+
+    return performed;
+}
+
+// Push elements to the back of a list and pop them from the front
+template<typename Allocator>
+std::size_t ListWorkload(const Allocator &allocator, std::size_t operations)
+{
+    using IntAllocator =
+        typename std::allocator_traits<Allocator>::template rebind_alloc<int>;
+    constexpr std::size_t Length = 256;
+
+    std::list<int, IntAllocator> l{IntAllocator(allocator)};
+    for (std::size_t i = 0; i < Length; i++) l.push_back(static_cast<int>(i));
+    for (std::size_t i = 0; i < operations; i++)
+    {
+        l.push_back(static_cast<int>(i));
+        l.pop_front();
+    }
+    DoNotOptimize(&l.front());
+
+    return operations;
+}
+
+// Insert and erase elements in a map
+template<typename Allocator>
+std::size_t MapWorkload(const Allocator &allocator, std::size_t operations)
+{
+    using PairAllocator = typename std::allocator_traits<
+        Allocator>::template rebind_alloc<std::pair<const std::size_t, int>>;
+    constexpr std::size_t Keys = 1024;
+
+    std::map<std::size_t, int, std::less<std::size_t>, PairAllocator> m{
+        PairAllocator(allocator)};
+    for (std::size_t i = 0; i < operations; i++)
+    {
+        // Use a multiplicative hash to visit keys in a scattered order
+        const std::size_t key = (i * 2654435761U) % Keys;
+        const auto [it, inserted] = m.try_emplace(key, static_cast<int>(i));
+        if (!inserted) m.erase(it);
+    }
+    DoNotOptimize(&m);
+
+    return operations;
+}
+
+// Run the named container workload with the given allocator
+template<typename Allocator>
+std::size_t RunWorkload(const std::string &workload,
+                        const Allocator &allocator,
+                        std::size_t operations)
+{
+    if (workload == "vector") return VectorWorkload(allocator, operations);
+    if (workload == "list") return ListWorkload(allocator, operations);
+    return MapWorkload(allocator, operations);
+}
+
+// Return a container allocator factory for the MemoryManager
+AllocatorFactory ManagerAllocatorFactory(const std::string &name,
+                                         const ManagerOptions &options)
+{
+    auto memory_manager = std::make_shared<MemoryManager>(BenchmarkProfile(),
+                                                          options,
+                                                          nullptr,
+                                                          false);
+    return {name,
+            [memory_manager](const std::string &workload,
+                             std::size_t operations)
+            {
+                return RunWorkload(workload,
+                                   MemoryAllocator<int>(memory_manager),
+                                   operations);
+            }};
+}
+
+// Return the list of allocators used with the container workloads
+std::vector<AllocatorFactory> Allocators()
+{
+    auto pool = std::make_shared<std::pmr::unsynchronized_pool_resource>();
+
+    std::vector<AllocatorFactory> allocators =
+    {
+        {"std::allocator",
+         [](const std::string &workload, std::size_t operations)
+         {
+             return RunWorkload(workload, std::allocator<int>(), operations);
+         }},
+        {"pmr_unsync",
+         [pool](const std::string &workload, std::size_t operations)
+         {
+             return RunWorkload(workload,
+                                std::pmr::polymorphic_allocator<int>(
+                                    pool.get()),
+                                operations);
+         }}
+    };
+
+    ManagerOptions options{};
+    allocators.push_back(ManagerAllocatorFactory("mm", options));
+
+    options = {};
+    options.thread_cache = true;
+    allocators.push_back(ManagerAllocatorFactory("mm_cache", options));
+
+    // The same Memory Manager used without reference counting on each copy
+    auto memory_manager = std::make_shared<MemoryManager>(BenchmarkProfile(),
+                                                          ManagerOptions{},
+                                                          nullptr,
+                                                          false);
+    allocators.push_back(
+        {"mm_nonowning",
+         [memory_manager](const std::string &workload, std::size_t operations)
+         {
+             return RunWorkload(workload,
+                                NonOwningMemoryAllocator<int>(*memory_manager),
+                                operations);
+         }});
+
+    auto memory_resource = std::make_shared<MemoryResource>(memory_manager);
+    allocators.push_back(
+        {"mm_pmr",
+         [memory_resource](const std::string &workload, std::size_t operations)
+         {
+             return RunWorkload(workload,
+                                std::pmr::polymorphic_allocator<int>(
+                                    memory_resource.get()),
+                                operations);
+         }});
+
+    auto static_manager = std::make_shared<StaticBenchmarkManager>();
+    allocators.push_back(
+        {"mm_static",
+         [static_manager](const std::string &workload, std::size_t operations)
+         {
+             return RunWorkload(
+                 workload,
+                 MemoryAllocator<int, StaticBenchmarkManager>(static_manager),
+                 operations);
+         }});
+
+    return allocators;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    Harness harness(argc, argv);
+
+    // Determine the thread counts to use for the contention workload
+    std::vector<std::size_t> thread_counts;
+    const std::size_t hardware_threads =
+        std::max(std::thread::hardware_concurrency(), 1U);
+    for (std::size_t threads = 1; threads < hardware_threads; threads *= 2)
+    {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(hardware_threads);
+
+    // Measure each subject with each allocation workload
+    for (const SubjectFactory &factory : Subjects())
+    {
+        const std::unique_ptr<Subject> subject = factory.create();
+
+        for (std::size_t size : {64, 1500})
+        {
+            const std::string suffix =
+                std::string("/").append(std::to_string(size)) + "/" +
+                factory.name;
+
+            harness.Run("pairs" + suffix,
+                        [&](std::size_t operations)
+                        {
+                            return Pairs(*subject, size, operations);
+                        });
+
+            for (std::size_t burst : {32, 256})
+            {
+                harness.Run("burst:" + std::to_string(burst) + suffix,
+                            [&](std::size_t operations)
+                            {
+                                return Burst(*subject,
+                                             size,
+                                             burst,
+                                             operations);
+                            });
+            }
+
+            // The remaining workloads use multiple threads
+            if (!factory.thread_safe) continue;
+
+            harness.Run("cross" + suffix,
+                        [&](std::size_t operations)
+                        {
+                            return CrossThread(*subject, size, operations);
+                        });
+
+            for (std::size_t threads : thread_counts)
+            {
+                harness.Run("contention:" + std::to_string(threads) + suffix,
+                            [&](std::size_t operations)
+                            {
+                                return Contention(*subject,
+                                                  size,
+                                                  threads,
+                                                  operations);
+                            });
+            }
+        }
+    }
+
+    // Measure each allocator with each container workload
+    for (const AllocatorFactory &factory : Allocators())
+    {
+        for (const std::string workload : {"vector", "list", "map"})
+        {
+            harness.Run(workload + "/" + factory.name,
+                        [&](std::size_t operations)
+                        {
+                            return factory.run(workload, operations);
+                        });
+        }
+    }
+
+    return 0;
+}
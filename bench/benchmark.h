@@ -0,0 +1,257 @@
+/*
+ *  benchmark.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This file defines a small benchmark harness used to measure the
+ *      performance of the MemoryManager relative to other allocators.
+ *
+ *      Benchmarks are registered with a Harness object by giving a name and
+ *      a function.  The function is given the number of operations to
+ *      perform and returns the number of operations actually performed.
+ *      Each benchmark is run several times and the fastest run is reported
+ *      as nanoseconds per operation, along with the resident set size of the
+ *      process when the run completes.
+ *
+ *      Benchmarks may be selected by passing one or more substrings on the
+ *      command line; only benchmarks whose names contain one of the given
+ *      strings are run.  The following options are also recognized:
+ *
+ *          --operations <n>    Number of operations per run
+ *          --repetitions <n>   Number of runs per benchmark
+ *          --csv               Produce output in CSV format
+ *
+ *  Portability Issues:
+ *      The resident set size is only reported on Linux.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace Terra::MemoryManager::Bench
+{
+
+// Function that performs the given number of operations, returning the
+// number of operations performed
+using BenchmarkFunction = std::function<std::size_t(std::size_t)>;
+
+// Define a structure to hold benchmark results
+struct BenchmarkResult
+{
+    std::string name;                           // Benchmark name
+    std::size_t operations;                     // Operations performed
+    double ns_per_op;                           // Nanoseconds per operation
+    std::size_t rss_kib;                        // Resident set size (KiB)
+};
+
+/*
+ *  ResidentSetSize()
+ *
+ *  Description:
+ *      Return the current resident set size of the process.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The resident set size in KiB, or 0 if it cannot be determined.
+ *
+ *  Comments:
+ *      None.
+ */
+inline std::size_t ResidentSetSize()
+{
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    std::size_t total = 0;
+    std::size_t resident = 0;
+    if (statm >> total >> resident)
+    {
+        return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE)) /
+               1024;
+    }
+#endif
+
+    return 0;
+}
+
+/*
+ *  DoNotOptimize()
+ *
+ *  Description:
+ *      Prevent the compiler from optimizing away the allocation of, or
+ *      accesses to, the memory at the given location.
+ *
+ *  Parameters:
+ *      p [in]
+ *          The location of the memory.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+inline void DoNotOptimize(void *p)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(p) : "memory");
+#else
+    static void *volatile sink;
+    sink = p;
+#endif
+}
+
+// Define the Harness object
+class Harness
+{
+    public:
+        Harness(int argc, char *argv[])
+        {
+            for (int i = 1; i < argc; i++)
+            {
+                const std::string argument = argv[i];
+                if ((argument == "--operations") && (i + 1 < argc))
+                {
+                    operations = std::stoul(argv[++i]);
+                }
+                else if ((argument == "--repetitions") && (i + 1 < argc))
+                {
+                    repetitions =
+                        std::max<std::size_t>(1, std::stoul(argv[++i]));
+                }
+                else if (argument == "--csv")
+                {
+                    csv = true;
+                }
+                else
+                {
+                    filters.push_back(argument);
+                }
+            }
+        }
+        ~Harness() = default;
+
+        std::size_t Operations() const { return operations; }
+
+        /*
+         *  Harness::Run()
+         *
+         *  Description:
+         *      Run the named benchmark if it is selected by the filters
+         *      given on the command line, reporting the result.
+         *
+         *  Parameters:
+         *      name [in]
+         *          The name of the benchmark.
+         *
+         *      function [in]
+         *          The function that performs the benchmark operations.
+         *
+         *  Returns:
+         *      Nothing.
+         *
+         *  Comments:
+         *      None.
+         */
+        void Run(const std::string &name, const BenchmarkFunction &function)
+        {
+            if (!Selected(name)) return;
+
+            BenchmarkResult result{name, 0, 0.0, 0};
+
+            for (std::size_t i = 0; i < repetitions; i++)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                const std::size_t performed = function(operations);
+                const auto stop = std::chrono::steady_clock::now();
+
+                const double elapsed =
+                    std::chrono::duration<double, std::nano>(stop - start)
+                        .count();
+                const double ns_per_op =
+                    elapsed / static_cast<double>(std::max(performed,
+                                                           std::size_t{1}));
+
+                if ((i == 0) || (ns_per_op < result.ns_per_op))
+                {
+                    result.operations = performed;
+                    result.ns_per_op = ns_per_op;
+                }
+                result.rss_kib = std::max(result.rss_kib, ResidentSetSize());
+            }
+
+            Report(result);
+            results.push_back(result);
+        }
+
+        const std::vector<BenchmarkResult> &Results() const { return results; }
+
+    protected:
+        bool Selected(const std::string &name) const
+        {
+            if (filters.empty()) return true;
+
+            return std::any_of(filters.begin(),
+                               filters.end(),
+                               [&](const std::string &filter)
+                               {
+                                   return name.find(filter) !=
+                                          std::string::npos;
+                               });
+        }
+
+        void Report(const BenchmarkResult &result)
+        {
+            if (csv)
+            {
+                if (results.empty())
+                {
+                    std::cout << "name,operations,ns_per_op,rss_kib"
+                              << std::endl;
+                }
+                std::cout << result.name << "," << result.operations << ","
+                          << result.ns_per_op << "," << result.rss_kib
+                          << std::endl;
+                return;
+            }
+
+            if (results.empty())
+            {
+                std::cout << std::left << std::setw(48) << "Benchmark"
+                          << std::right << std::setw(12) << "Operations"
+                          << std::setw(12) << "ns/op" << std::setw(12)
+                          << "RSS (KiB)" << std::endl;
+                std::cout << std::string(84, '-') << std::endl;
+            }
+            std::cout << std::left << std::setw(48) << result.name
+                      << std::right << std::setw(12) << result.operations
+                      << std::setw(12) << std::fixed << std::setprecision(2)
+                      << result.ns_per_op << std::setw(12) << result.rss_kib
+                      << std::endl;
+        }
+
+        std::size_t operations = 1'000'000;
+        std::size_t repetitions = 3;
+        bool csv = false;
+        std::vector<std::string> filters;
+        std::vector<BenchmarkResult> results;
+};
+
+} // namespace Terra::MemoryManager::Bench
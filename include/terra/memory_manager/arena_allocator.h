@@ -0,0 +1,142 @@
+/*
+ *  arena_allocator.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This object defines an allocator that will utilize a MemoryArena
+ *      to allocate memory.  It is intended for use with STL containers
+ *      and such that take an allocator as an argument, in the same way as
+ *      the MemoryAllocator.  For example, the following defines a vector of
+ *      integers that uses a MemoryArena.
+ *
+ *          std::vector<int, ArenaAllocator<int>> my_vector(memory_arena);
+ *
+ *      Calls to deallocate() do nothing, as memory is released only when
+ *      the MemoryArena is reset.  Containers using the ArenaAllocator must
+ *      therefore be destroyed (or no longer used) before the arena is reset.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstdlib>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include "memory_arena.h"
+
+namespace Terra::MemoryManager
+{
+
+// Define the ArenaAllocator class
+template<typename T>
+struct ArenaAllocator
+{
+    // Required type specification
+    using value_type = T;
+
+    // Default constructor
+    constexpr ArenaAllocator(const MemoryArenaPointer &memory_arena) :
+        memory_arena(memory_arena)
+    {
+    }
+
+    // Trivial copy constructor
+    template<typename U>
+    constexpr ArenaAllocator(const ArenaAllocator<U> &other) :
+        memory_arena(other.memory_arena)
+    {
+    }
+
+    // Default destructor
+    constexpr ~ArenaAllocator() = default;
+
+    /*
+     *  ArenaAllocator::allocate()
+     *
+     *  Description:
+     *      Allocates the specified number of type T items.
+     *
+     *  Parameters:
+     *      n [in]
+     *          Number of items of type T for which memory should be
+     *          allocated.
+     *
+     *  Returns:
+     *      A pointer to the allocated memory.
+     *
+     *  Comments:
+     *      This function will throw an exception on failure.
+     */
+    [[nodiscard]] constexpr T *allocate(std::size_t n) const
+    {
+        // If the request is too large, throw an exception
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+        {
+            throw std::bad_array_new_length();
+        }
+
+        // Attempt to allocate the requested memory
+        void *p = memory_arena->Allocate(sizeof(T) * n, alignof(T));
+        if (p == nullptr) throw std::bad_alloc();
+
+        return static_cast<T *>(p);
+    }
+
+    /*
+     *  ArenaAllocator::deallocate()
+     *
+     *  Description:
+     *      Free memory previously allocated by allocate().
+     *
+     *  Parameters:
+     *      p [in]
+     *          A pointer to the memory to be freed.
+     *
+     *      n [in]
+     *          The number of items of type T that were previously allocated.
+     *
+     *  Returns:
+     *      Nothing.
+     *
+     *  Comments:
+     *      Memory is released only when the MemoryArena is reset.
+     */
+    constexpr void deallocate([[maybe_unused]] T *p,
+                              [[maybe_unused]] std::size_t n) const noexcept
+    {
+    }
+
+    /*
+     *  ArenaAllocator::operator==()
+     *
+     *  Description:
+     *      Checks to see if memory allocated by one allocator can be freed
+     *      by another allocator.
+     *
+     *  Parameters:
+     *      other [in]
+     *          A reference to the other allocator object.
+     *
+     *  Returns:
+     *      Returns true if the MemoryArena objects for this and the other
+     *      objects are the same.
+     *
+     *  Comments:
+     *      None.
+     */
+    template<typename U>
+    constexpr bool operator==(const ArenaAllocator<U> &other) const noexcept
+    {
+        return memory_arena.get() == other.memory_arena.get();
+    }
+
+    MemoryArenaPointer memory_arena;
+};
+
+} // namespace Terra::MemoryManager
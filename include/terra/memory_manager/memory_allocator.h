@@ -1,7 +1,7 @@
 /*
  *  memory_allocator.h
  *
- *  Copyright (C) 2024
+ *  Copyright (C) 2024, 2026
  *  Terrapane Corporation
  *  All Rights Reserved
  *
@@ -21,6 +21,46 @@
  *      understand that the global MemoryManager created for use with
  *      MemoryAllocator will never free memory.
  *
+ *      The MemoryAllocator holds a shared pointer to the MemoryManager, so
+ *      each copy (including those made when a container rebinds the
+ *      allocator) updates the reference count.  The NonOwningMemoryAllocator
+ *      instead holds a plain pointer to the MemoryManager, making copies
+ *      free; the MemoryManager must then outlive any containers using it.
+ *
+ *          std::vector<int, NonOwningMemoryAllocator<int>> my_vector(
+ *              *memory_manager);
+ *
+ *      The PoolAllocator is intended for node-based containers such as
+ *      std::list, std::map, and std::unordered_map, which allocate one node
+ *      of a fixed size at a time.  Rather than requesting each node from the
+ *      MemoryManager, which places a header before every block, it carves
+ *      nodes from larger chunks obtained from the MemoryManager and keeps
+ *      freed nodes on a free list linked through the nodes themselves.  Each
+ *      node therefore occupies only its own size (rounded up to its
+ *      alignment), and allocating or freeing a node is a matter of moving a
+ *      pointer.  When a container rebinds the allocator to its node type,
+ *      the rebound allocator binds to the free list (bucket) for nodes of
+ *      that size, so no search is required.  Requests for more than one
+ *      object (or for objects too large or too strictly aligned for a chunk)
+ *      are made of the MemoryManager directly.
+ *
+ *          std::list<int, PoolAllocator<int>> my_list(memory_manager);
+ *
+ *      Copies of a PoolAllocator, including rebound copies, share a single
+ *      NodePool.  Chunks are returned to the MemoryManager only when the
+ *      last allocator sharing the NodePool is destroyed, so memory freed by
+ *      a container remains available to containers sharing the pool but not
+ *      to others.  Chunks are 4096 octets unless another size is given to
+ *      the constructor; the MemoryManager's profile should have a descriptor
+ *      of that size.  Like the MemoryArena, a NodePool is not thread safe:
+ *      containers sharing one must be used by one thread at a time, while
+ *      containers using separately constructed PoolAllocators may be used
+ *      concurrently.
+ *
+ *      All of these allocators use the MemoryManager by default.  The type of
+ *      any object providing the same Allocate() and Free() functions, such as
+ *      a StaticMemoryManager, may be given as the second template argument.
+ *
  *  Portability Issues:
  *      None.
  */
@@ -29,29 +69,35 @@
 
 #include <cstdlib>
 #include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <iterator>
 #include <limits>
+#include <memory>
 #include <new>
+#include <vector>
 #include "memory_manager.h"
 
 namespace Terra::MemoryManager
 {
 
 // Define the MemoryAllocator class
-template<typename T>
+template<typename T, typename Manager = MemoryManager>
 struct MemoryAllocator
 {
     // Required type specification
     using value_type = T;
 
     // Default constructor
-    constexpr MemoryAllocator(const MemoryManagerPointer &memory_manager) :
+    constexpr MemoryAllocator(
+        const std::shared_ptr<Manager> &memory_manager) :
         memory_manager(memory_manager)
     {
     }
 
     // Trivial copy constructor
     template<typename U>
-    constexpr MemoryAllocator(const MemoryAllocator<U> &other) :
+    constexpr MemoryAllocator(const MemoryAllocator<U, Manager> &other) :
         memory_manager(other.memory_manager)
     {
     }
@@ -85,7 +131,8 @@ struct MemoryAllocator
         }
 
         // Attempt to allocate the requested memory (exception on failure)
-        return static_cast<T *>(memory_manager->Allocate(sizeof(T) * n));
+        return static_cast<T *>(
+            memory_manager->Allocate(sizeof(T) * n, alignof(T)));
     }
 
     /*
@@ -107,14 +154,13 @@ struct MemoryAllocator
      *  Comments:
      *      None.
      */
-    constexpr void deallocate(T *p,
-                            [[maybe_unused]] std::size_t n) const noexcept
+    constexpr void deallocate(T *p, std::size_t n) const noexcept
     {
         // If the pointer is nullptr, just return
         if (p == nullptr) return;
 
         // Delete the previously allocated memory
-        memory_manager->Free(p);
+        memory_manager->Free(p, sizeof(T) * n);
     }
 
     /*
@@ -136,12 +182,477 @@ struct MemoryAllocator
      *      None.
      */
     template<typename U>
-    constexpr bool operator==(const MemoryAllocator<U> &other) const noexcept
+    constexpr bool operator==(
+        const MemoryAllocator<U, Manager> &other) const noexcept
     {
         return memory_manager.get() == other.memory_manager.get();
     }
 
-    MemoryManagerPointer memory_manager;
+    std::shared_ptr<Manager> memory_manager;
+};
+
+// Define the NonOwningMemoryAllocator class
+template<typename T, typename Manager = MemoryManager>
+struct NonOwningMemoryAllocator
+{
+    // Required type specification
+    using value_type = T;
+
+    // Default constructor
+    constexpr NonOwningMemoryAllocator(Manager &memory_manager) noexcept :
+        memory_manager(&memory_manager)
+    {
+    }
+
+    // Trivial copy constructor
+    template<typename U>
+    constexpr NonOwningMemoryAllocator(
+        const NonOwningMemoryAllocator<U, Manager> &other) noexcept :
+        memory_manager(other.memory_manager)
+    {
+    }
+
+    // Construct from a MemoryAllocator, which must outlive this object
+    template<typename U>
+    constexpr NonOwningMemoryAllocator(
+        const MemoryAllocator<U, Manager> &other) noexcept :
+        memory_manager(other.memory_manager.get())
+    {
+    }
+
+    // Default destructor
+    constexpr ~NonOwningMemoryAllocator() = default;
+
+    /*
+     *  NonOwningMemoryAllocator::allocate()
+     *
+     *  Description:
+     *      Allocates the specified number of type T items.
+     *
+     *  Parameters:
+     *      n [in]
+     *          Number of items of type T for which memory should be
+     *          allocated.
+     *
+     *  Returns:
+     *      A pointer to the allocated memory.
+     *
+     *  Comments:
+     *      This function will throw an exception on failure.
+     */
+    [[nodiscard]] constexpr T *allocate(std::size_t n) const
+    {
+        // If the request is too large, throw an exception
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+        {
+            throw std::bad_array_new_length();
+        }
+
+        // Attempt to allocate the requested memory (exception on failure)
+        return static_cast<T *>(
+            memory_manager->Allocate(sizeof(T) * n, alignof(T)));
+    }
+
+    /*
+     *  NonOwningMemoryAllocator::deallocate()
+     *
+     *  Description:
+     *      Free memory previously allocated by allocate().
+     *
+     *  Parameters:
+     *      p [in]
+     *          A pointer to the memory to be freed.
+     *
+     *      n [in]
+     *          The number of items of type T that were previously allocated.
+     *
+     *  Returns:
+     *      Nothing.
+     *
+     *  Comments:
+     *      None.
+     */
+    constexpr void deallocate(T *p, std::size_t n) const noexcept
+    {
+        // If the pointer is nullptr, just return
+        if (p == nullptr) return;
+
+        // Delete the previously allocated memory
+        memory_manager->Free(p, sizeof(T) * n);
+    }
+
+    /*
+     *  NonOwningMemoryAllocator::operator==()
+     *
+     *  Description:
+     *      Checks to see if memory allocated by one allocator can be freed
+     *      by another allocator.
+     *
+     *  Parameters:
+     *      other [in]
+     *          A reference to the other allocator object.
+     *
+     *  Returns:
+     *      Returns true if the Memory Manager objects for this and the other
+     *      objects are the same.
+     *
+     *  Comments:
+     *      None.
+     */
+    template<typename U>
+    constexpr bool operator==(
+        const NonOwningMemoryAllocator<U, Manager> &other) const noexcept
+    {
+        return memory_manager == other.memory_manager;
+    }
+
+    Manager *memory_manager;
+};
+
+// Default size of the chunks from which a NodePool carves nodes
+constexpr std::size_t Node_Pool_Chunk_Size = 4096;
+
+// Define the NodePool class used by the PoolAllocator
+template<typename Manager = MemoryManager>
+class NodePool
+{
+    public:
+        // Free nodes of a single size, linked through the nodes themselves
+        struct Bucket
+        {
+            std::size_t size;                   // Size of each node
+            std::size_t alignment;              // Alignment of each node
+            void *head;                         // Most recently freed node
+        };
+
+        NodePool(const std::shared_ptr<Manager> &memory_manager,
+                 std::size_t chunk_size) :
+            memory_manager(memory_manager),
+            chunk_size(chunk_size),
+            position(nullptr),
+            end(nullptr)
+        {
+        }
+
+        NodePool(const NodePool &other) = delete;
+        NodePool(const NodePool &&other) = delete;
+
+        /*
+         *  NodePool::~NodePool()
+         *
+         *  Description:
+         *      Return all chunks to the Memory Manager.
+         *
+         *  Parameters:
+         *      None.
+         *
+         *  Returns:
+         *      Nothing.
+         *
+         *  Comments:
+         *      All nodes must have been freed (or no longer be used).
+         */
+        ~NodePool()
+        {
+            for (void *chunk : chunks) memory_manager->Free(chunk);
+        }
+
+        NodePool &operator=(const NodePool &other) = delete;
+        NodePool &operator=(const NodePool &&other) = delete;
+
+        Manager &GetMemoryManager() const { return *memory_manager; }
+
+        /*
+         *  NodePool::GetBucket()
+         *
+         *  Description:
+         *      Find (or create) the bucket holding nodes of the given size and
+         *      alignment.
+         *
+         *  Parameters:
+         *      size [in]
+         *          The size of each node.
+         *
+         *      alignment [in]
+         *          The required alignment of each node.
+         *
+         *  Returns:
+         *      A pointer to the bucket, which remains valid for the lifetime
+         *      of the NodePool, or nullptr if nodes of this size or alignment
+         *      are not carved from chunks.
+         *
+         *  Comments:
+         *      Nodes are only carved from chunks if at least eight fit into
+         *      a chunk and the alignment is no stricter than that of
+         *      std::max_align_t, which chunks are given.
+         */
+        Bucket *GetBucket(std::size_t size, std::size_t alignment)
+        {
+            // Nodes must be able to hold the free list link
+            alignment = std::max(alignment, alignof(void *));
+            size = std::max(size, sizeof(void *));
+            size = ((size + alignment - 1) / alignment) * alignment;
+
+            if ((alignment > alignof(std::max_align_t)) ||
+                (size > chunk_size / Chunk_Node_Minimum))
+            {
+                return nullptr;
+            }
+
+            // Locate an existing bucket for nodes of this size and alignment
+            for (const auto &bucket : buckets)
+            {
+                if ((bucket->size == size) && (bucket->alignment == alignment))
+                {
+                    return bucket.get();
+                }
+            }
+
+            buckets.push_back(
+                std::make_unique<Bucket>(Bucket{size, alignment, nullptr}));
+
+            return buckets.back().get();
+        }
+
+        /*
+         *  NodePool::Allocate()
+         *
+         *  Description:
+         *      Allocate a node from the given bucket.
+         *
+         *  Parameters:
+         *      bucket [in]
+         *          The bucket from which to allocate the node.
+         *
+         *  Returns:
+         *      A pointer to the node or nullptr if a chunk could not be
+         *      allocated.
+         *
+         *  Comments:
+         *      Freed nodes are reused first; otherwise, the node is carved
+         *      from the current chunk.
+         */
+        void *Allocate(Bucket &bucket)
+        {
+            // Take the most recently freed node, if any
+            if (bucket.head != nullptr)
+            {
+                void *node = bucket.head;
+                bucket.head = *static_cast<void **>(node);
+                return node;
+            }
+
+            // Determine the padding needed to align the node
+            const std::uintptr_t address =
+                reinterpret_cast<std::uintptr_t>(position);
+            const std::size_t padding =
+                ((address + bucket.alignment - 1) & ~(bucket.alignment - 1)) -
+                address;
+
+            // Carve the node from the current chunk if it fits, else
+            // allocate a new chunk
+            if (static_cast<std::size_t>(std::distance(position, end)) >=
+                padding + bucket.size)
+            {
+                position =
+                    std::next(position, static_cast<std::ptrdiff_t>(padding));
+            }
+            else
+            {
+                void *chunk = memory_manager->Allocate(
+                    chunk_size,
+                    alignof(std::max_align_t));
+                if (chunk == nullptr) return nullptr;
+                chunks.push_back(chunk);
+                position = static_cast<std::uint8_t *>(chunk);
+                end = std::next(position,
+                                static_cast<std::ptrdiff_t>(chunk_size));
+            }
+
+            void *node = position;
+            position =
+                std::next(position, static_cast<std::ptrdiff_t>(bucket.size));
+
+            return node;
+        }
+
+        /*
+         *  NodePool::Free()
+         *
+         *  Description:
+         *      Return a node to the given bucket.
+         *
+         *  Parameters:
+         *      bucket [in]
+         *          The bucket from which the node was allocated.
+         *
+         *      node [in]
+         *          The node to free.
+         *
+         *  Returns:
+         *      Nothing.
+         *
+         *  Comments:
+         *      Nodes are retained for reuse until the NodePool is destroyed.
+         */
+        void Free(Bucket &bucket, void *node) noexcept
+        {
+            *static_cast<void **>(node) = bucket.head;
+            bucket.head = node;
+        }
+
+    protected:
+        // Fewest nodes that must fit into a chunk for nodes to be pooled
+        static constexpr std::size_t Chunk_Node_Minimum = 8;
+
+        std::shared_ptr<Manager> memory_manager;
+        std::size_t chunk_size;
+        std::vector<std::unique_ptr<Bucket>> buckets;
+        std::vector<void *> chunks;
+        std::uint8_t *position;
+        std::uint8_t *end;
+};
+
+// Define the PoolAllocator class
+template<typename T, typename Manager = MemoryManager>
+struct PoolAllocator
+{
+    // Required type specification
+    using value_type = T;
+
+    // Default constructor
+    PoolAllocator(const std::shared_ptr<Manager> &memory_manager) :
+        PoolAllocator(memory_manager, Node_Pool_Chunk_Size)
+    {
+    }
+
+    // Constructor specifying the size of the chunks from which nodes are
+    // carved
+    PoolAllocator(const std::shared_ptr<Manager> &memory_manager,
+                  std::size_t chunk_size) :
+        node_pool(
+            std::make_shared<NodePool<Manager>>(memory_manager, chunk_size)),
+        bucket(node_pool->GetBucket(sizeof(T), alignof(T)))
+    {
+    }
+
+    // Rebinding copy constructor, which binds to the bucket for type T
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U, Manager> &other) :
+        node_pool(other.node_pool),
+        bucket(node_pool->GetBucket(sizeof(T), alignof(T)))
+    {
+    }
+
+    // Default destructor
+    ~PoolAllocator() = default;
+
+    /*
+     *  PoolAllocator::allocate()
+     *
+     *  Description:
+     *      Allocates the specified number of type T items.
+     *
+     *  Parameters:
+     *      n [in]
+     *          Number of items of type T for which memory should be
+     *          allocated.
+     *
+     *  Returns:
+     *      A pointer to the allocated memory.
+     *
+     *  Comments:
+     *      This function will throw an exception on failure.  A single item
+     *      is taken from the bound bucket, if any; otherwise, the memory is
+     *      allocated from the Memory Manager.
+     */
+    [[nodiscard]] T *allocate(std::size_t n) const
+    {
+        void *p = nullptr;
+
+        if ((n == 1) && (bucket != nullptr))
+        {
+            // Allocate a node from the bucket
+            p = node_pool->Allocate(*bucket);
+        }
+        else
+        {
+            // If the request is too large, throw an exception
+            if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            {
+                throw std::bad_array_new_length();
+            }
+
+            // Allocate the requested memory from the Memory Manager
+            p = node_pool->GetMemoryManager().Allocate(sizeof(T) * n,
+                                                       alignof(T));
+        }
+
+        if (p == nullptr) throw std::bad_alloc();
+
+        return static_cast<T *>(p);
+    }
+
+    /*
+     *  PoolAllocator::deallocate()
+     *
+     *  Description:
+     *      Free memory previously allocated by allocate().
+     *
+     *  Parameters:
+     *      p [in]
+     *          A pointer to the memory to be freed.
+     *
+     *      n [in]
+     *          The number of items of type T that were previously allocated.
+     *
+     *  Returns:
+     *      Nothing.
+     *
+     *  Comments:
+     *      None.
+     */
+    void deallocate(T *p, std::size_t n) const noexcept
+    {
+        // If the pointer is nullptr, just return
+        if (p == nullptr) return;
+
+        // Return a single item to the bucket, else to the Memory Manager
+        if ((n == 1) && (bucket != nullptr))
+        {
+            node_pool->Free(*bucket, p);
+        }
+        else
+        {
+            node_pool->GetMemoryManager().Free(p, sizeof(T) * n);
+        }
+    }
+
+    /*
+     *  PoolAllocator::operator==()
+     *
+     *  Description:
+     *      Checks to see if memory allocated by one allocator can be freed
+     *      by another allocator.
+     *
+     *  Parameters:
+     *      other [in]
+     *          A reference to the other allocator object.
+     *
+     *  Returns:
+     *      Returns true if this and the other objects share a NodePool.
+     *
+     *  Comments:
+     *      None.
+     */
+    template<typename U>
+    bool operator==(const PoolAllocator<U, Manager> &other) const noexcept
+    {
+        return node_pool.get() == other.node_pool.get();
+    }
+
+    std::shared_ptr<NodePool<Manager>> node_pool;
+    typename NodePool<Manager>::Bucket *bucket;
 };
 
 } // namespace Terra::MemoryManager
@@ -0,0 +1,87 @@
+/*
+ *  memory_arena.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This file defines the MemoryArena object, which provides fast
+ *      allocation of short-lived memory that is released all at once.
+ *
+ *      The MemoryArena obtains large chunks of memory from a MemoryManager
+ *      and satisfies each call to Allocate() by advancing a pointer within
+ *      the current chunk.  Memory is not freed individually; instead, calling
+ *      Reset() returns every chunk to the Memory Manager in a single call to
+ *      FreeBatch(), after which all memory previously allocated from the
+ *      arena must no longer be used.  The arena is also reset when it is
+ *      destroyed.
+ *
+ *      This is well suited to work such as handling a single request, where
+ *      many small objects are allocated and then all discarded together.
+ *      For example, the following uses the 64KiB blocks of a Memory Manager
+ *      as arena chunks:
+ *
+ *          MemoryArena arena(memory_manager, 65536);
+ *          void *p = arena.Allocate(100);
+ *          // ...
+ *          arena.Reset();
+ *
+ *      The chunk size should match the size of a descriptor in the Memory
+ *      Manager's profile.  Requests larger than the chunk size are satisfied
+ *      using a dedicated allocation from the Memory Manager, which is also
+ *      released by Reset().
+ *
+ *      The ArenaAllocator (see arena_allocator.h) allows STL containers to
+ *      allocate memory from a MemoryArena.
+ *
+ *      A MemoryArena is not thread safe; it is intended to be used by one
+ *      thread at a time.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include "memory_manager.h"
+
+namespace Terra::MemoryManager
+{
+
+// Define the MemoryArena object
+class MemoryArena
+{
+    public:
+        MemoryArena(const MemoryManagerPointer &memory_manager,
+                    std::size_t chunk_size);
+        MemoryArena(const MemoryArena &other) = delete;
+        MemoryArena(const MemoryArena &&other) = delete;
+        virtual ~MemoryArena();
+
+        MemoryArena &operator=(const MemoryArena &other) = delete;
+        MemoryArena &operator=(const MemoryArena &&other) = delete;
+
+        void *Allocate(std::size_t size,
+                       std::size_t alignment = alignof(std::max_align_t));
+        void Reset();
+        std::size_t ChunkCount() const { return chunks.size(); }
+
+    protected:
+        std::uint8_t *AllocateChunk(std::size_t size);
+
+        MemoryManagerPointer memory_manager;
+        std::size_t chunk_size;
+        std::vector<void *> chunks;
+        std::uint8_t *position;
+        std::uint8_t *limit;
+};
+
+// Define a shared pointer type
+using MemoryArenaPointer = std::shared_ptr<MemoryArena>;
+
+} // namespace Terra::MemoryManager
@@ -32,6 +32,15 @@
  *
  *      It is important is that the same Memory Manager that allocates a
  *      given chunk of memory be the same one used to free that memory.
+ *      Code that passes memory between parts of an application using
+ *      different Memory Managers may instead call FreeAny(), which locates
+ *      the Memory Manager that allocated the memory and frees it there.
+ *      The owner is found using the block header or, for blocks having
+ *      compact headers, the slabs each such Memory Manager records when its
+ *      free_any option is true, so FreeAny() is somewhat slower than calling
+ *      Free() on the owner.  Only memory provided by a MemoryManager object
+ *      that still exists may be given to FreeAny(), and memory from a Memory
+ *      Manager using compact headers only if its free_any option is true.
  *
  *      When initializing the Memory Manager, the developer provides a
  *      MemoryProfile to the constructor.  The profile defines the various
@@ -61,8 +70,10 @@
  *          };
  *
  *      When memory if freed, the memory chunks are placed back into the
- *      appropriate vector automatically.  This is made possible via special
- *      header placed at the start of the memory.  If additional allocations
+ *      appropriate free list automatically.  This is made possible via special
+ *      header placed at the start of the memory, which also holds the link to
+ *      the next block in the free list, so the pool does not itself allocate
+ *      memory as blocks are freed.  If additional allocations
  *      were necessary from the heap, they will be returned retained until
  *      the maximum number of allocations is reached.  Any beyond that size
  *      will be returned to the heap.  (Ideally, one should perform tests
@@ -86,20 +97,304 @@
  *      exception is when the maximum value is zero, which indicates no maximum.
  *
  *      When calling Allocate(), the first descriptor with a size value large
- *      enough to satisfy the request will be used.
+ *      enough to satisfy the request will be used.  The descriptor is located
+ *      using a table computed at construction that maps the requested size to
+ *      a size class, so the cost of finding the descriptor does not depend on
+ *      the number of descriptors in the profile.
+ *
+ *      If that descriptor has no free block and cannot allocate one, the
+ *      request spills to the next larger descriptor.  A burst of small
+ *      requests may then consume the blocks intended for large requests, so
+ *      the first descriptor's spill value controls spilling.  By default
+ *      (SpillPolicy::Any), any larger descriptor may be used.  With
+ *      SpillPolicy::Limited, only the next spill_limit larger descriptors may
+ *      be used, and with SpillPolicy::Never, the request fails instead.  With
+ *      SpillPolicy::Budget, any larger descriptor may be used, but no more than
+ *      spill_limit spilled blocks may be outstanding at once; the budget may
+ *      be briefly exceeded by concurrent requests and requires the standard
+ *      block headers.  The spilled statistic of the first descriptor counts
+ *      the allocations that were satisfied by a larger descriptor.
+ *
+ *              // Size, Minimum, Maximum, Excess Allowed, Slab Blocks,
+ *              // Alignment, Source, Prefault, Lock Pages, Stripes, Spill,
+ *              // Spill Limit
+ *              {    64,     256,     256, false,          0,    0,
+ *                   MemorySource::Heap, false, false, 0,
+ *                   SpillPolicy::Budget, 16 },
+ *              { 65535,      16,      16, false }
  *
  *      All memory allocations are aligned to an Allocation_Alignment boundary,
  *      which is important for applications that need to use data that is
- *      aligned accordingly.
+ *      aligned accordingly.  A descriptor may request a stricter alignment
+ *      via its alignment value, which must be a power of two (e.g., 64 for
+ *      cache line alignment or 4096 for page alignment).  A value of 0 uses
+ *      the default alignment.  Allocate() may also be given the alignment
+ *      required, in which case only descriptors whose blocks are aligned at
+ *      least that strictly are used to satisfy the request.  For example,
+ *      with the following profile, Allocate(1500) and Allocate(1500, 64) may
+ *      use either descriptor, but Allocate(1500, 4096) uses only the second.
+ *
+ *              // Size, Minimum, Maximum, Excess Allowed, Slab Blocks,
+ *              // Alignment
+ *              {  2048,     256,    1024, true,           0,    0 },
+ *              {  4096,      64,     256, true,           0, 4096 }
+ *
+ *      By default, each memory block is allocated from the heap separately.
+ *      If a descriptor's slab_blocks value is non-zero, blocks are instead
+ *      carved from contiguous slabs, each holding up to slab_blocks blocks.
+ *      This reduces the number of heap allocations and improves locality.
+ *      Blocks within a slab are never returned to the heap individually;
+ *      slabs are freed when the Memory Manager is destroyed.  If a maximum is
+ *      specified, slabs will hold at most that many blocks in total and any
+ *      excess allocations are made individually from the heap, so they may
+ *      be returned to the heap when freed.  For example, the following
+ *      descriptor pre-allocates 4096 blocks using 16 heap allocations:
+ *
+ *              // Size, Minimum, Maximum, Excess Allowed, Slab Blocks
+ *              {  1500,    4096,    8192, true,           256 }
+ *
+ *      By default, slabs are allocated from the heap.  A descriptor's source
+ *      value may instead request that slabs be mapped directly from the
+ *      operating system as regular pages (MemorySource::Pages) or as huge
+ *      pages (MemorySource::HugePages), which reduces TLB misses for
+ *      descriptors holding many large blocks.  Huge pages reserved by the
+ *      system are used if available; otherwise, the Memory Manager requests
+ *      that the system back the slab with transparent huge pages.  If the
+ *      prefault value is true, all pages of a slab are faulted in when the
+ *      slab is created, and if lock_pages is true, the pages are locked in
+ *      memory so they are never swapped.  A descriptor using mapped memory
+ *      always uses slabs; if slab_blocks is 0, slabs of about 64KiB (or one
+ *      huge page) are used.  Blocks allocated individually, such as those in
+ *      excess of the maximum, are always allocated from the heap.  Mapped
+ *      memory is only supported on Linux; elsewhere, the heap is used.
+ *      For example, the following descriptor places 4096 blocks on huge
+ *      pages that are faulted in when the Memory Manager is constructed:
+ *
+ *              {  1500,    4096,    8192, true,           0,  0,
+ *                 MemorySource::HugePages, true }
+ *
+ *      AllocateBatch() and FreeBatch() allocate or free several blocks while
+ *      locking the mutex only once, which is useful when blocks are allocated
+ *      and freed in bursts.  AllocateBatch() returns the number of blocks
+ *      allocated, which may be fewer than requested if the profile cannot
+ *      satisfy the entire request.
+ *
+ *      Each descriptor's pool is protected by its own lock, placed on its own
+ *      cache line, so that threads using different descriptors do not
+ *      contend.  If a descriptor's stripes value is greater than 1, its free
+ *      list is further divided into that many stripes, each with its own
+ *      lock, and each thread uses one stripe (threads are assigned stripes in
+ *      turn).  Like a thread cache, a stripe holds free blocks apart from the
+ *      shared pool, moving blocks to and from the shared pool in batches
+ *      according to cache_low_watermark and cache_high_watermark.  When both
+ *      a stripe and the shared pool are empty, half of another stripe's
+ *      blocks are taken before allocating from the heap.  Stripes are not
+ *      used with thread caches or the lock-free engine.
+ *
+ *      If the size of the memory requested from Allocate() is known when
+ *      freeing memory, it may be passed to Free() so the Memory Manager can
+ *      verify that the caller did not use more memory than the block holds.
+ *
+ *      Since a block may be larger than the size requested, UsableSize()
+ *      returns the number of octets the caller may actually use.
+ *      Reallocate() changes the size of a block, returning the same block if
+ *      it is already large enough.  Otherwise, the contents are moved to a
+ *      block from a larger descriptor (selected as with Allocate()) and the
+ *      original block is freed; if that is not possible, nullptr is returned
+ *      and the original block remains valid.
+ *
+ *      AllocateWait() and AllocateAsync() behave like Allocate(), except that
+ *      a request that cannot be satisfied waits (blocking the thread or
+ *      suspending the coroutine that awaits the result) for a block of the
+ *      first descriptor large enough to be freed.  Each Free() hands blocks
+ *      to waiting requests in the order in which they began waiting, though
+ *      a concurrent Allocate() may take a freed block first.  Blocks held in
+ *      other threads' caches or in pool stripes are not seen by waiting
+ *      requests.  A suspended coroutine is resumed by the thread that frees
+ *      the block.  All requests must have stopped waiting before the Memory
+ *      Manager is destroyed.
+ *
+ *      Statistics are held in atomic counters that are read without locking
+ *      the mutex, so GetStatistics() does not block Allocate() or Free().
+ *      If the library is built with TERRA_MEMORY_MANAGER_NO_STATISTICS
+ *      defined, statistics are not collected and counters remain zero.
+ *
+ *      If the library is built with TERRA_MEMORY_MANAGER_DIAGNOSTICS defined
+ *      (the memory_manager_DIAGNOSTICS CMake option), GetDiagnostics()
+ *      reports for each descriptor histograms of the time taken by
+ *      Allocate() and Free(), how often and for how long threads waited on
+ *      the descriptor's pool locks, and how many blocks or slabs were
+ *      allocated from or freed to the heap.  Requests to Allocate() are
+ *      attributed to the first descriptor large enough to satisfy them.
+ *      Each histogram bucket counts operations taking at least
+ *      LatencyBucketFloor() of that bucket, but less than that of the next
+ *      bucket, with four buckets for each power of two nanoseconds.
+ *      Otherwise, no measurements are taken and the diagnostics are zero.
+ *
+ *      Optional behavior is controlled via the ManagerOptions structure that
+ *      may be provided to the constructor.
+ *
+ *      When lock_free is true, the Memory Manager uses a lock-free engine in
+ *      which the free blocks for each descriptor are held on a lock-free
+ *      stack linked through the block headers and statistics are maintained
+ *      using relaxed atomic counters.  This is useful when blocks are
+ *      frequently allocated on one thread and freed on another.  The same
+ *      MemoryProfile format is used, though with this engine a maximum
+ *      limits the number of blocks retained by the pool (free or in use),
+ *      since blocks that have been placed into the pool are not returned to
+ *      the heap until the Memory Manager is destroyed.  Slabs are used only
+ *      for blocks pre-allocated during construction.
+ *
+ *      When thread_cache is true, each thread keeps a small cache of free
+ *      blocks for each descriptor.  Most calls to Allocate() and Free() are
+ *      then satisfied from that cache without locking the mutex.  When a
+ *      thread's cache for a descriptor is empty, up to cache_low_watermark
+ *      blocks are taken from the shared pool in one operation.  When the
+ *      cache grows beyond cache_high_watermark blocks, the excess is returned
+ *      to the shared pool, leaving cache_low_watermark blocks in the cache.
+ *      Note that blocks held in a thread's cache count against the
+ *      descriptor's maximum, so watermarks should be small relative to the
+ *      maximum when excess is not allowed.  Blocks cached by a thread are
+ *      returned to the shared pool when the thread exits.  Statistics remain
+ *      accurate, though max_outstanding may be approximate when several
+ *      threads use the same descriptor at once.
+ *
+ *      When remote_free is also true, a block freed by a thread other than
+ *      the one that allocated it is not placed in the freeing thread's
+ *      cache.  Instead, it is pushed onto a lock-free queue belonging to the
+ *      allocating thread, as recorded in the block header, and that thread
+ *      collects all such blocks at once when its cache is next empty.  This
+ *      suits pipelines in which one thread allocates buffers that other
+ *      threads free, since neither the allocating thread's cache is drained
+ *      nor the freeing thread's cache filled.  Blocks whose allocating
+ *      thread has exited, or that were not allocated from a thread cache,
+ *      are kept by the freeing thread.  If more than 64 threads use the
+ *      Memory Manager, some threads share a queue.  Remote frees require
+ *      thread caches and cannot be used with compact headers.
+ *
+ *      When adaptive is true, the Memory Manager adjusts the profile to the
+ *      observed usage.  When a descriptor's blocks are exhausted or a block
+ *      would be freed to the heap because the maximum has been reached, the
+ *      descriptor's minimum is raised to the peak number of blocks in use
+ *      (plus 25% headroom), the maximum of descriptors allowing excess is
+ *      raised to at least that minimum, and a limited number of blocks are
+ *      pre-allocated toward the new minimum.  The maximum of a descriptor
+ *      that does not allow excess is never changed.  Whether or not adaptive
+ *      is true, GetRecommendedProfile() returns a MemoryProfile reflecting the
+ *      observed usage that may be used when constructing a Memory Manager in
+ *      the future.  Adaptive tuning is not used with the lock-free engine.
+ *
+ *      When replenish is true, a background thread keeps blocks available
+ *      in each descriptor's pool so that Allocate() and Free() do not
+ *      allocate from or free to the heap while holding the mutex.  When
+ *      fewer than replenish_watermark free blocks remain in a pool, the
+ *      thread allocates blocks until the pool holds twice that number (or
+ *      until the maximum is reached).  Blocks freed beyond the maximum are
+ *      retained by Free() and later returned to the heap by the thread.
+ *      Allocate() only allocates from the heap itself if a pool is empty.
+ *      Background replenishment is not used with the lock-free engine.
+ *
+ *      By default, the constructor creates each descriptor's minimum number
+ *      of blocks, which may delay startup when the profile holds many blocks.
+ *      With PreallocationPolicy::Lazy, the constructor instead reserves a
+ *      single slab large enough for the minimum number of blocks (mapped
+ *      from the operating system on Linux, so that no pages are touched) and
+ *      blocks are carved from it, a batch at a time, only when a pool is
+ *      empty.  With PreallocationPolicy::Background, a background thread
+ *      carves the reserved blocks incrementally after construction, while
+ *      requests made meanwhile carve blocks as with lazy pre-allocation.
+ *      Either way, WarmUp() creates any blocks not yet carved and touches
+ *      every page of the free blocks so that page faults do not occur once
+ *      traffic arrives.  Reserved slabs are not used with the lock-free
+ *      engine, nor with guarded blocks (see below).
+ *
+ *      Free blocks retained in the pools (e.g., after a burst of traffic
+ *      when the maximum is 0) may be returned to the heap or operating
+ *      system on request.  Trim() releases free blocks beyond each
+ *      descriptor's minimum, starting with the largest blocks, until no more
+ *      than the given number of bytes remains in such blocks.  ReleaseIdle()
+ *      releases free blocks beyond the minimum for each descriptor whose pool
+ *      has not been used for at least the given time.  A slab is released
+ *      once all of its blocks are free and beyond the minimum.  When
+ *      decay_time is non-zero, a background thread calls ReleaseIdle() with
+ *      that time at that interval, so the memory held follows the load
+ *      without adding work to Allocate() or Free().  Blocks held in thread
+ *      caches and stripes are not released, and neither trimming nor idle
+ *      release is used with the lock-free engine, which retains its blocks.
+ *
+ *      By default, Free() verifies that each block belongs to this Memory
+ *      Manager and checks the header and trailer markers to detect memory
+ *      corruption.  The validation option selects a different policy.  With
+ *      ValidationPolicy::Release, these checks are skipped, the block header
+ *      is trusted, and blocks have no trailer, which is faster (the far end
+ *      of a large block is never touched) but means that corruption is not
+ *      detected and freeing memory not allocated by this Memory Manager
+ *      results in undefined behavior.  Setting validate_blocks to false is
+ *      equivalent to ValidationPolicy::Release.  ValidationPolicy::Sampling
+ *      fully checks only one in every validation_interval calls to Free()
+ *      on each thread, trusting the header otherwise, so corruption is
+ *      still detected eventually at a fraction of the cost.
+ *
+ *      ValidationPolicy::Debug checks every block and additionally places
+ *      each block in its own mapping, ending just before an inaccessible
+ *      guard page, so that writing beyond the end of a block faults at once
+ *      rather than being found when the block is freed.  New blocks are
+ *      filled with 0xCD and freed blocks with 0xDD so that reading
+ *      uninitialized or freed memory is apparent.  Since every block then
+ *      occupies at least two pages, this is intended only for testing.
+ *      Slabs (and so compact headers) are not used in this mode, and guard
+ *      pages are used only on Linux and for alignments no stricter than the
+ *      page size.
+ *
+ *      When compact_headers is true, each block carries an 8-byte header in
+ *      place of the larger standard header, reducing the overhead
+ *      for small blocks.  Every block then resides within a slab whose
+ *      header identifies the owning Memory Manager, and the compact header
+ *      holds only the distance to that slab header, the descriptor index,
+ *      and a marker.  If a descriptor's slab_blocks value is 0, slabs of
+ *      about 64KiB are used.  Blocks allocated in excess of the slabs (or
+ *      when no more slabs may be created due to the maximum) are placed in
+ *      slabs of their own so that they may be returned to the heap.  With
+ *      compact headers, user data is aligned to a boundary suitable for any
+ *      scalar type (alignof(std::max_align_t)) unless the descriptor
+ *      requests a stricter alignment.  Compact headers cannot be used with
+ *      more than 65535 descriptors.
+ *
+ *      When free_any is also true, the Memory Manager records the extent of
+ *      each slab it creates so that FreeAny() can locate the owner of a
+ *      block having a compact header.  Since this adds a small cost to the
+ *      creation and release of every slab, including the slabs holding
+ *      excess blocks, it should be set only when FreeAny() is used.  The
+ *      free_any option has no effect without compact headers.
+ *
+ *      When numa is true, the Memory Manager maintains a separate set of
+ *      pools for each NUMA node in the system.  Allocate() serves requests
+ *      from the pools of the node on which the calling thread is running, and
+ *      Free() returns each block to the pools of the node from which it was
+ *      allocated, as recorded in the block header.  Each node uses the given
+ *      profile, so the minimum and maximum values apply to each node
+ *      separately.  Slabs are placed in memory local to their node and are
+ *      used even if slab_blocks is 0 (in which case slabs of about 64KiB are
+ *      used); blocks allocated individually are placed by the operating
+ *      system, which generally uses the node of the thread that first touches
+ *      them.  The statistics reported are the sum over all nodes, so
+ *      max_outstanding may exceed the true peak.  NUMA pools are supported
+ *      only on Linux; elsewhere, a single node is used.
  *
  *  Portability Issues:
- *      None.
+ *      NUMA node placement and mapped memory are only supported on Linux.
  */
 
 #pragma once
 
 #include <cstdlib>
 #include <cstdint>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <limits>
+#include <semaphore>
 #include <vector>
 #include <utility>
 #include <memory>
@@ -109,6 +404,24 @@
 namespace Terra::MemoryManager
 {
 
+// Define the sources from which slab memory may be obtained
+enum class MemorySource
+{
+    Heap,                                       // The C++ heap
+    Pages,                                      // Pages mapped from the system
+    HugePages                                   // Huge pages, where available
+};
+
+// Define the policies controlling whether a request that cannot be satisfied
+// by the first descriptor large enough may spill to a larger descriptor
+enum class SpillPolicy
+{
+    Any,                                        // Any larger descriptor
+    Limited,                                    // Up to spill_limit larger
+    Budget,                                     // Up to spill_limit blocks
+    Never                                       // No larger descriptor
+};
+
 // Define a MemoryDescriptor structure
 struct MemoryDescriptor
 {
@@ -116,6 +429,14 @@ struct MemoryDescriptor
     std::size_t minimum;                        // Minimum to preallocate
     std::size_t maximum;                        // Maximum to retain available
     bool excess_allowed;                        // Allow excess heap allocations
+    std::size_t slab_blocks = 0;                // Blocks per slab (0 = none)
+    std::size_t alignment = 0;                  // Data alignment (0 = default)
+    MemorySource source = MemorySource::Heap;   // Source of slab memory
+    bool prefault = false;                      // Fault in mapped pages
+    bool lock_pages = false;                    // Lock mapped pages in memory
+    std::size_t stripes = 0;                    // Free lists (0 = unstriped)
+    SpillPolicy spill = SpillPolicy::Any;       // Use of larger descriptors
+    std::size_t spill_limit = 0;                // Descriptors or blocks
 };
 
 // Define a structure to hold various statistics per bucket
@@ -128,11 +449,106 @@ struct Statistics
     std::uint64_t max_outstanding;              // Maximum blocks outstanding
     std::uint64_t outstanding;                  // Blocks outstanding
     std::uint64_t unfulfilled;                  // Allocations unfulfilled
+    std::uint64_t spilled;                      // Allocations spilled
 };
 
+// Define the number of buckets in each latency histogram
+constexpr std::size_t Latency_Buckets = 128;
+
+// Define a histogram of operation durations
+using LatencyHistogram = std::array<std::uint64_t, Latency_Buckets>;
+
+// Define a structure to hold the diagnostics for each descriptor
+struct Diagnostics
+{
+    std::size_t size;                           // Size of memory blocks
+    LatencyHistogram allocate_latency;          // Allocate() durations
+    LatencyHistogram free_latency;              // Free() durations
+    std::uint64_t lock_acquisitions;            // Pool lock acquisitions
+    std::uint64_t lock_contentions;             // Acquisitions that waited
+    std::uint64_t lock_wait_time;               // Nanoseconds spent waiting
+    std::uint64_t heap_allocations;             // Blocks or slabs allocated
+    std::uint64_t heap_frees;                   // Blocks or slabs freed
+};
+
+// Return the shortest duration in nanoseconds counted by a histogram bucket
+std::uint64_t LatencyBucketFloor(std::size_t bucket);
+
 // Define the MemoryProfile type
 using MemoryProfile = std::vector<MemoryDescriptor>;
 
+// Define how thoroughly blocks are checked for corruption when freed
+enum class ValidationPolicy
+{
+    Full,                                       // Check every block
+    Release,                                    // Check nothing
+    Sampling,                                   // Check some blocks
+    Debug                                       // Guard pages and poisoning
+};
+
+// Define when the blocks pre-allocated for each descriptor are created
+enum class PreallocationPolicy
+{
+    Eager,                                      // Create in the constructor
+    Lazy,                                       // Create when first needed
+    Background                                  // Create in the background
+};
+
+// Define a structure to hold options that control MemoryManager behavior
+struct ManagerOptions
+{
+    bool lock_free = false;                     // Use the lock-free engine
+    bool thread_cache = false;                  // Use per-thread block caches
+    std::size_t cache_high_watermark = 64;      // Cached blocks before flush
+    std::size_t cache_low_watermark = 32;       // Blocks retained or fetched
+    bool remote_free = false;                   // Return blocks to allocator
+    bool compact_headers = false;               // Use compact block headers
+    bool validate_blocks = true;                // Verify blocks when freed
+    ValidationPolicy validation = ValidationPolicy::Full; // Checks on free
+    std::size_t validation_interval = 64;       // Frees per sampled check
+    bool adaptive = false;                      // Adapt profile to usage
+    bool numa = false;                          // Use a pool per NUMA node
+    bool replenish = false;                     // Refill pools in background
+    std::size_t replenish_watermark = 16;       // Free blocks before refill
+    std::chrono::milliseconds decay_time{};     // Idle time before release
+    PreallocationPolicy preallocation = PreallocationPolicy::Eager;
+    bool free_any = false;                      // Record slabs for FreeAny()
+};
+
+// Opaque structures used to implement the block layout, slabs, statistics,
+// diagnostics, pool locks and stripes, lock-free engine, thread caches,
+// remote frees, background replenishment, waiting requests, idle pool
+// release, and reserved blocks
+struct BlockLayout;
+struct FreeList;
+struct SlabRecord;
+struct PoolReserve;
+struct StatisticsCounters;
+struct DiagnosticCounters;
+struct PoolLock;
+struct PoolStripe;
+struct LockFreeBucket;
+struct ThreadCache;
+struct ThreadCacheRegistry;
+struct RemoteQueue;
+struct Replenisher;
+struct WaitQueue;
+struct PoolActivity;
+
+// State of a request waiting in AllocateWait() or AllocateAsync() for a block
+// to be freed; waiters for each descriptor are served in FIFO order
+struct AllocationWaiter
+{
+    AllocationWaiter *next;                     // Next waiter in the queue
+    std::size_t index;                          // Profile index waited upon
+    void *block;                                // Block given to the waiter
+    bool granted;                               // Waiter has been served
+    std::coroutine_handle<> handle;             // Coroutine to resume
+    std::binary_semaphore *semaphore;           // Semaphore to release
+};
+
+class AllocateAwaitable;
+
 // Define the MemoryManager object
 class MemoryManager
 {
@@ -140,6 +556,10 @@ class MemoryManager
         explicit MemoryManager(MemoryProfile profile,
                                const Logger::LoggerPointer &parent_logger = {},
                                bool log_statistics = true);
+        MemoryManager(MemoryProfile profile,
+                      const ManagerOptions &options,
+                      const Logger::LoggerPointer &parent_logger = {},
+                      bool log_statistics = true);
         MemoryManager(const MemoryManager &other) = delete;
         MemoryManager(const MemoryManager &&other) = delete;
         virtual ~MemoryManager();
@@ -148,21 +568,191 @@ class MemoryManager
         MemoryManager &operator=(const MemoryManager &&other) = delete;
 
         void *Allocate(std::size_t size);
+        void *Allocate(std::size_t size, std::size_t alignment);
         bool Free(void *p);
+        bool Free(void *p, std::size_t size);
+        void *AllocateWait(std::size_t size);
+        void *AllocateWait(std::size_t size, std::chrono::nanoseconds timeout);
+        AllocateAwaitable AllocateAsync(std::size_t size);
+        void *Reallocate(void *p, std::size_t size);
+        void *Reallocate(void *p, std::size_t size, std::size_t alignment);
+        std::size_t UsableSize(void *p) const;
+        std::size_t AllocateBatch(std::size_t size,
+                                  std::size_t count,
+                                  void **out);
+        std::size_t FreeBatch(void **ptrs, std::size_t count);
         std::vector<Statistics> GetStatistics() const;
+        void GetStatistics(std::vector<Statistics> &snapshot) const;
+        std::vector<Diagnostics> GetDiagnostics() const;
+        void GetDiagnostics(std::vector<Diagnostics> &snapshot) const;
+        MemoryProfile GetRecommendedProfile() const;
+        std::size_t Trim(std::size_t target_bytes);
+        std::size_t ReleaseIdle(std::chrono::nanoseconds age);
+        void WarmUp();
 
     protected:
+        MemoryManager(MemoryProfile profile,
+                      const ManagerOptions &options,
+                      const Logger::LoggerPointer &parent_logger,
+                      bool log_statistics,
+                      std::size_t numa_node);
+
+        friend struct ThreadCacheRegistry;
+        friend class AllocateAwaitable;
+
+        static constexpr std::size_t No_Node =
+            std::numeric_limits<std::size_t>::max();
+
+        enum class BlockStatus
+        {
+            Invalid,
+            Foreign,
+            BadIndex,
+            Corrupt,
+            Valid
+        };
+
         bool PerformAllocation(std::size_t index);
+        bool PerformSlabAllocation(std::size_t index, std::size_t count);
+        std::uint8_t *CreateSlab(std::size_t index,
+                                 std::size_t count,
+                                 MemorySource source);
+        std::size_t CarveReserve(std::size_t index, std::size_t count);
+        void InitializeBlock(std::uint8_t *block,
+                             std::size_t index,
+                             std::uint8_t *slab);
+        std::uint8_t *CreateBlock(std::size_t index);
+        void DeleteBlock(std::size_t index, std::uint8_t *block);
+        bool IsSlabBlock(std::size_t index, std::uint8_t *block) const;
+        std::uint8_t *GetSlab(std::size_t index, std::uint8_t *block) const;
+        bool IsPooled(std::size_t index, std::uint8_t *block) const;
+        void SetPooled(std::size_t index, std::uint8_t *block);
+        std::uint8_t **GetNextLink(std::size_t index,
+                                   std::uint8_t *block) const;
+        void PushListBlock(FreeList &list,
+                           std::size_t index,
+                           std::uint8_t *block);
+        std::uint8_t *PopListBlock(FreeList &list, std::size_t index);
+        BlockStatus LocateBlock(void *p,
+                                std::uint8_t *&block,
+                                std::size_t &index) const;
+        bool RejectBlock(BlockStatus status);
+        void FreeBlock(std::size_t index, std::uint8_t *block, bool bad_block);
+        bool ReplenishPool(std::size_t index);
+        std::uint8_t *TakePoolBlock(std::size_t index);
+        MemoryDescriptor RecommendDescriptor(std::size_t index) const;
+        void AdaptDescriptor(std::size_t index);
+        void ReturnBlock(std::size_t index, std::uint8_t *block);
+        void WakeReplenisher();
+        void RunReplenisher();
+        void MaintainPool(std::size_t index);
+        std::size_t ExcessBytes(std::size_t index) const;
+        std::size_t ReleasePool(std::size_t index, std::size_t bytes);
+        void ReleaseSlabs(std::size_t index,
+                          const std::vector<SlabRecord> &released);
+        void *LockFreeAllocate(std::size_t size, std::size_t alignment);
+        bool LockFreeFree(std::uint8_t *block,
+                          std::size_t index,
+                          bool bad_block);
+        std::uint8_t *LockFreeCreateBlock(std::size_t index);
+        void PushFreeBlock(std::size_t index, std::uint8_t *block);
+        std::uint8_t *PopFreeBlock(std::size_t index);
+        void *CacheAllocate(std::size_t size, std::size_t alignment);
+        bool CacheFree(std::uint8_t *block, std::size_t index, bool bad_block);
+        ThreadCache *GetThreadCache();
+        bool RefillThreadCache(ThreadCache &cache,
+                               std::size_t index,
+                               bool allocate);
+        void FlushThreadCache(ThreadCache &cache,
+                              std::size_t index,
+                              std::size_t retain);
+        std::uint8_t *TakeCachedBlock(ThreadCache &cache, std::size_t index);
+        void ReturnCachedBlock(ThreadCache &cache,
+                               std::uint8_t *block,
+                               std::size_t index,
+                               bool bad_block);
+        void FoldThreadCounters(ThreadCache &cache, std::size_t index);
+        void ReleaseThreadCache(ThreadCache *cache);
+        void PushRemoteBlock(std::size_t queue,
+                             std::size_t index,
+                             std::uint8_t *block);
+        bool RemoteQueueOrphaned(std::size_t queue) const;
+        bool CollectRemoteBlocks(ThreadCache &cache,
+                                 std::size_t queue,
+                                 std::size_t index);
+        std::uint8_t *StripeAllocate(std::size_t index);
+        bool StripeFree(std::uint8_t *block, std::size_t index, bool bad_block);
+        bool StealBlocks(std::size_t index, std::size_t selected);
+        std::size_t FindDescriptor(std::size_t size) const;
+        bool EnqueueWaiter(AllocationWaiter &waiter, std::size_t size);
+        bool WithdrawWaiter(AllocationWaiter &waiter);
+        std::uint8_t *TakeWaiterBlock(std::size_t index);
+        void ServeWaiters(std::size_t index);
+        std::size_t SpillAllowance(std::size_t first,
+                                   std::size_t spills) const;
+        void RecordSpill(std::size_t first,
+                         std::size_t index,
+                         std::uint8_t *block);
+        void ReleaseSpill(std::size_t index, std::uint8_t *block);
+        void PoisonBlock(std::size_t index, std::uint8_t *block);
+        MemoryManager *LocateOwner(void *p) const;
 
         MemoryProfile profile;
+        ManagerOptions options;
         Logger::LoggerPointer logger;
         bool log_statistics;
-        std::vector<std::vector<uint8_t *>> allocations;
-        std::vector<Statistics> statistics;
+        std::size_t numa_node;
+        std::vector<std::unique_ptr<MemoryManager>> nodes;
+        std::vector<std::size_t> size_classes;
+        std::vector<BlockLayout> layouts;
+        std::vector<FreeList> allocations;
+        std::vector<std::vector<SlabRecord>> slabs;
+        std::vector<PoolReserve> reserves;
+        std::vector<StatisticsCounters> statistics;
+        std::vector<DiagnosticCounters> diagnostics;
+        std::vector<std::atomic<std::size_t>> spill_outstanding;
+        mutable std::vector<PoolLock> pool_locks;
+        std::vector<std::vector<PoolStripe>> stripes;
+        std::vector<LockFreeBucket> lock_free_buckets;
+        std::vector<std::pair<std::size_t, std::uint8_t *>> quarantine;
+        std::vector<std::size_t> held;
+        std::vector<std::size_t> held_peak;
+        std::vector<ThreadCache *> thread_caches;
+        std::shared_ptr<ThreadCacheRegistry> cache_registry;
+        std::vector<RemoteQueue> remote_queues;
+        std::vector<WaitQueue> wait_queues;
+        std::vector<PoolActivity> activity;
+        std::size_t next_remote_queue;
+        std::unique_ptr<Replenisher> replenisher;
         mutable std::mutex mutex;
 };
 
+// Awaitable object returned by MemoryManager::AllocateAsync()
+class AllocateAwaitable
+{
+    public:
+        AllocateAwaitable(MemoryManager &memory_manager, std::size_t size);
+        AllocateAwaitable(const AllocateAwaitable &other) = delete;
+        AllocateAwaitable(const AllocateAwaitable &&other) = delete;
+        ~AllocateAwaitable() = default;
+
+        AllocateAwaitable &operator=(const AllocateAwaitable &other) = delete;
+        AllocateAwaitable &operator=(const AllocateAwaitable &&other) = delete;
+
+        bool await_ready();
+        bool await_suspend(std::coroutine_handle<> handle);
+        void *await_resume() const noexcept { return waiter.block; }
+
+    protected:
+        MemoryManager &memory_manager;
+        std::size_t size;
+        AllocationWaiter waiter;
+};
+
 // Define a shared pointer type
 using MemoryManagerPointer = std::shared_ptr<MemoryManager>;
 
+// Free memory allocated by any Memory Manager
+bool FreeAny(void *p);
+
 } // namespace Terra::MemoryManager
@@ -0,0 +1,66 @@
+/*
+ *  memory_resource.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This file defines the MemoryResource object, which is a
+ *      std::pmr::memory_resource that allocates memory using a MemoryManager.
+ *      This allows containers using std::pmr::polymorphic_allocator to use
+ *      the MemoryManager.  For example, the following defines a map that
+ *      uses the MemoryManager.
+ *
+ *          MemoryResource memory_resource(memory_manager);
+ *          std::pmr::map<int, int> my_map(&memory_resource);
+ *
+ *      Unlike the MemoryAllocator, the type of a container using the
+ *      MemoryResource does not depend on the allocator, and copying a
+ *      std::pmr::polymorphic_allocator only copies a pointer to the
+ *      MemoryResource.  The MemoryResource must therefore outlive any
+ *      containers using it.
+ *
+ *      The size and alignment given to allocate() are used to select a
+ *      descriptor in the MemoryManager's profile.  If the request cannot be
+ *      satisfied, std::bad_alloc is thrown.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include "memory_manager.h"
+
+namespace Terra::MemoryManager
+{
+
+// Define the MemoryResource object
+class MemoryResource : public std::pmr::memory_resource
+{
+    public:
+        explicit MemoryResource(const MemoryManagerPointer &memory_manager);
+        MemoryResource(const MemoryResource &other) = delete;
+        MemoryResource(const MemoryResource &&other) = delete;
+        ~MemoryResource() override = default;
+
+        MemoryResource &operator=(const MemoryResource &other) = delete;
+        MemoryResource &operator=(const MemoryResource &&other) = delete;
+
+        MemoryManager &GetMemoryManager() const { return *memory_manager; }
+
+    protected:
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void *p,
+                           std::size_t bytes,
+                           std::size_t alignment) override;
+        bool do_is_equal(
+            const std::pmr::memory_resource &other) const noexcept override;
+
+        MemoryManagerPointer memory_manager;
+};
+
+} // namespace Terra::MemoryManager
@@ -0,0 +1,131 @@
+/*
+ *  shared_memory_manager.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This file defines the SharedMemoryManager object, which is a Memory
+ *      Manager whose blocks, free lists, and statistics reside within a
+ *      named shared memory region so that several processes may allocate and
+ *      free the same blocks.  This allows a producer process to allocate a
+ *      buffer, fill it, and pass it to a consumer process that reads and then
+ *      frees it without copying the contents.
+ *
+ *      One process creates the region by giving a name and a profile:
+ *
+ *          SharedMemoryManager producer("/packets", profile);
+ *
+ *      Other processes attach to the region using only its name:
+ *
+ *          SharedMemoryManager consumer("/packets");
+ *
+ *      The region is mapped at a different address in each process, so
+ *      nothing in the region refers to memory by address.  Block headers and
+ *      free lists use offsets from the start of the region instead, and a
+ *      block is passed between processes by sending the offset returned by
+ *      GetOffset(), which the receiving process converts back into a pointer
+ *      using GetPointer().  Any attached process may free any block, but
+ *      only by using a pointer obtained through its own SharedMemoryManager.
+ *
+ *      Since a shared region cannot grow, every block is created when the
+ *      region is created.  Each descriptor holds the greater of its minimum
+ *      and maximum blocks, and requests that cannot be satisfied from the
+ *      region fail rather than falling back to the heap.  The excess_allowed,
+ *      slab_blocks, source, prefault, lock_pages, stripes, and spill_limit
+ *      values are ignored.  A request that does not fit the first descriptor
+ *      large enough is satisfied from a larger descriptor unless that
+ *      descriptor's spill policy is SpillPolicy::Never.  Descriptor
+ *      alignment may be no stricter than the page size.
+ *
+ *      The free list of each descriptor is a lock-free stack, so processes
+ *      never hold a lock while sharing the region and a process that ends
+ *      unexpectedly cannot leave the region locked.  However, blocks held by
+ *      such a process are not recovered.
+ *
+ *      The process that created the region removes its name when the
+ *      SharedMemoryManager is destroyed; processes already attached may
+ *      continue to use the region until they detach.  Creating a region
+ *      fails if the name is already in use.
+ *
+ *      The SharedMemoryManager provides the same Allocate(), Free(), and
+ *      GetStatistics() functions as the MemoryManager, so it may be used
+ *      with the MemoryAllocator and NonOwningMemoryAllocator by giving its
+ *      type as the allocator's second template argument.
+ *
+ *  Portability Issues:
+ *      Shared memory regions are only supported on Linux; elsewhere, the
+ *      SharedMemoryManager is never attached and all requests fail.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <terra/logger/logger.h>
+#include "memory_manager.h"
+
+namespace Terra::MemoryManager
+{
+
+// Opaque structures describing the layout of the shared region
+struct SharedRegionHeader;
+struct SharedDescriptor;
+
+// Define the SharedMemoryManager object
+class SharedMemoryManager
+{
+    public:
+        SharedMemoryManager(const std::string &name,
+                            MemoryProfile profile,
+                            const Logger::LoggerPointer &parent_logger = {});
+        explicit SharedMemoryManager(
+            const std::string &name,
+            const Logger::LoggerPointer &parent_logger = {});
+        SharedMemoryManager(const SharedMemoryManager &other) = delete;
+        SharedMemoryManager(const SharedMemoryManager &&other) = delete;
+        ~SharedMemoryManager();
+
+        SharedMemoryManager &operator=(const SharedMemoryManager &other) =
+            delete;
+        SharedMemoryManager &operator=(const SharedMemoryManager &&other) =
+            delete;
+
+        bool IsAttached() const { return region != nullptr; }
+        bool IsCreator() const { return creator; }
+
+        void *Allocate(std::size_t size);
+        void *Allocate(std::size_t size, std::size_t alignment);
+        bool Free(void *p);
+        bool Free(void *p, std::size_t size);
+
+        std::uint64_t GetOffset(const void *p) const;
+        void *GetPointer(std::uint64_t offset) const;
+
+        std::vector<Statistics> GetStatistics() const;
+        void GetStatistics(std::vector<Statistics> &snapshot) const;
+
+    protected:
+        bool CreateRegion(const MemoryProfile &profile);
+        bool AttachRegion();
+        void DetachRegion();
+        std::uint8_t *PopBlock(std::size_t index);
+        void PushBlock(std::size_t index, std::uint8_t *block);
+
+        std::string name;
+        Logger::LoggerPointer logger;
+        bool creator;
+        std::uint8_t *region;
+        std::size_t length;
+        SharedRegionHeader *header;
+        SharedDescriptor *descriptors;
+};
+
+// Define a shared pointer type
+using SharedMemoryManagerPointer = std::shared_ptr<SharedMemoryManager>;
+
+} // namespace Terra::MemoryManager
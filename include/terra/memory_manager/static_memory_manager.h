@@ -0,0 +1,609 @@
+/*
+ *  static_memory_manager.h
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This file defines the StaticMemoryManager object, which is a
+ *      header-only Memory Manager whose profile is given at compile time as
+ *      a list of MemoryDescriptor template arguments.  For example:
+ *
+ *          using PacketMemoryManager =
+ *              Terra::MemoryManager::StaticMemoryManager<
+ *                  // Size, Minimum, Maximum, Excess Allowed
+ *                  MemoryDescriptor{    64,      16,      64, true  },
+ *                  MemoryDescriptor{  1500,      64,     256, true  },
+ *                  MemoryDescriptor{ 65535,       0,       8, false }>;
+ *
+ *      Since the profile is known to the compiler, the descriptor used for
+ *      a request of constant size is selected at compile time, the free
+ *      blocks for all descriptors are held in a single fixed-size array, and
+ *      the Allocate() and Free() functions may be inlined into the caller.
+ *
+ *      The descriptors must be given in order of increasing size, and each
+ *      must have a non-zero maximum, which is the number of free blocks that
+ *      will be retained for that descriptor.  As with the MemoryManager,
+ *      minimum blocks are allocated at construction, a request is satisfied
+ *      by the first descriptor large enough (and sufficiently aligned) that
+ *      has a block available, subject to the spill policy of the first
+ *      descriptor large enough, and blocks freed beyond the maximum are
+ *      returned to the heap.  The slab_blocks and source values are ignored;
+ *      each block is allocated from the heap individually.
+ *
+ *      The StaticMemoryManager provides the same Allocate(), Free(), and
+ *      GetStatistics() functions as the MemoryManager, so it may be used
+ *      with the MemoryAllocator and NonOwningMemoryAllocator by giving its
+ *      type as the allocator's second template argument:
+ *
+ *          std::vector<int, MemoryAllocator<int, PacketMemoryManager>>
+ *              my_vector(memory_manager);
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#pragma once
+
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <iterator>
+#include <mutex>
+#include <new>
+#include <vector>
+#include "memory_manager.h"
+
+namespace Terra::MemoryManager
+{
+
+// Define the StaticMemoryManager object
+template<MemoryDescriptor... Descriptors>
+class StaticMemoryManager
+{
+    public:
+        // Number of descriptors in the profile
+        static constexpr std::size_t Descriptor_Count = sizeof...(Descriptors);
+
+        // The profile given as template arguments
+        static constexpr std::array<MemoryDescriptor, Descriptor_Count>
+            Profile{Descriptors...};
+
+        static_assert(Descriptor_Count > 0,
+                      "The profile must contain at least one descriptor");
+        static_assert(std::ranges::is_sorted(Profile,
+                                             {},
+                                             &MemoryDescriptor::size),
+                      "Descriptors must be in order of increasing size");
+        static_assert(std::ranges::all_of(Profile,
+                                          [](const MemoryDescriptor &d)
+                                          {
+                                              return (d.maximum > 0) &&
+                                                     (d.minimum <= d.maximum);
+                                          }),
+                      "Each maximum must be non-zero and at least the minimum");
+        static_assert(std::ranges::all_of(Profile,
+                                          [](const MemoryDescriptor &d)
+                                          {
+                                              return (d.alignment == 0) ||
+                                                     std::has_single_bit(
+                                                         d.alignment);
+                                          }),
+                      "Descriptor alignment values must be a power of two");
+
+        /*
+         *  StaticMemoryManager::StaticMemoryManager()
+         *
+         *  Description:
+         *      Constructor for the StaticMemoryManager object, which
+         *      pre-allocates the minimum number of blocks for each
+         *      descriptor.
+         *
+         *  Parameters:
+         *      None.
+         *
+         *  Returns:
+         *      Nothing.
+         *
+         *  Comments:
+         *      If pre-allocation fails, fewer blocks are pre-allocated.
+         */
+        StaticMemoryManager() :
+            available{},
+            created{},
+            spill_outstanding{},
+            statistics{}
+        {
+            for (std::size_t index = 0; index < Descriptor_Count; index++)
+            {
+                statistics[index].size = Profile[index].size;
+
+                while (created[index] < Profile[index].minimum)
+                {
+                    std::uint8_t *block = CreateBlock(index);
+                    if (block == nullptr) break;
+                    free_blocks[Offsets[index] + available[index]++] = block;
+                }
+            }
+        }
+
+        StaticMemoryManager(const StaticMemoryManager &other) = delete;
+        StaticMemoryManager(const StaticMemoryManager &&other) = delete;
+
+        /*
+         *  StaticMemoryManager::~StaticMemoryManager()
+         *
+         *  Description:
+         *      Destructor for the StaticMemoryManager object, which returns
+         *      all free blocks to the heap.
+         *
+         *  Parameters:
+         *      None.
+         *
+         *  Returns:
+         *      Nothing.
+         *
+         *  Comments:
+         *      Blocks still outstanding are not freed.
+         */
+        ~StaticMemoryManager()
+        {
+            for (std::size_t index = 0; index < Descriptor_Count; index++)
+            {
+                while (available[index] > 0)
+                {
+                    DeleteBlock(index,
+                                free_blocks[Offsets[index] +
+                                            --available[index]]);
+                }
+            }
+        }
+
+        StaticMemoryManager &operator=(const StaticMemoryManager &other) =
+            delete;
+        StaticMemoryManager &operator=(const StaticMemoryManager &&other) =
+            delete;
+
+        /*
+         *  StaticMemoryManager::SelectDescriptor()
+         *
+         *  Description:
+         *      Determine the first descriptor large enough to satisfy a
+         *      request of the given size.
+         *
+         *  Parameters:
+         *      size [in]
+         *          The size of the memory requested.
+         *
+         *  Returns:
+         *      The index of the descriptor or Descriptor_Count if no
+         *      descriptor is large enough.
+         *
+         *  Comments:
+         *      This is evaluated at compile time for constant sizes.
+         */
+        static constexpr std::size_t SelectDescriptor(std::size_t size)
+        {
+            for (std::size_t index = 0; index < Descriptor_Count; index++)
+            {
+                if (Profile[index].size >= size) return index;
+            }
+
+            return Descriptor_Count;
+        }
+
+        /*
+         *  StaticMemoryManager::Allocate()
+         *
+         *  Description:
+         *      Allocate memory of the requested size.
+         *
+         *  Parameters:
+         *      size [in]
+         *          The size of the memory requested.
+         *
+         *      alignment [in]
+         *          The required alignment of the memory (or 0 if none),
+         *          which must be a power of two.
+         *
+         *  Returns:
+         *      A pointer to a block of memory the user may use or nullptr if
+         *      the request could not be satisfied.
+         *
+         *  Comments:
+         *      None.
+         */
+        void *Allocate(std::size_t size, std::size_t alignment = 0)
+        {
+            // The alignment must be a power of two
+            if ((alignment != 0) && !std::has_single_bit(alignment))
+            {
+                return nullptr;
+            }
+
+            // Lock the mutex
+            const std::lock_guard<std::mutex> lock(mutex);
+
+            // Iterate over each descriptor large enough for the request
+            std::size_t first = Descriptor_Count;
+            std::size_t spills = 0;
+            for (std::size_t index = SelectDescriptor(size);
+                 index < Descriptor_Count;
+                 index++)
+            {
+                // If the blocks are insufficiently aligned, keep looking
+                if (Layouts[index].alignment < alignment) continue;
+
+                // Use a larger descriptor only as the first descriptor's
+                // policy allows
+                if (first == Descriptor_Count)
+                {
+                    first = index;
+                }
+                else if (!MaySpill(first, ++spills))
+                {
+                    break;
+                }
+
+                // Take a free block or create one if allowed
+                std::uint8_t *block = nullptr;
+                if (available[index] > 0)
+                {
+                    block = free_blocks[Offsets[index] + --available[index]];
+                }
+                else if ((created[index] < Profile[index].maximum) ||
+                         Profile[index].excess_allowed)
+                {
+                    block = CreateBlock(index);
+                }
+
+                // Note a fulfillment attempt failed and keep looking
+                if (block == nullptr)
+                {
+                    statistics[index].unfulfilled++;
+                    continue;
+                }
+
+                // Update the statistics
+                auto &counters = statistics[index];
+                counters.allocations++;
+                counters.outstanding++;
+                counters.max_outstanding =
+                    std::max(counters.max_outstanding, counters.outstanding);
+
+                // Note a request satisfied by a larger descriptor, marking
+                // the block if it uses the first descriptor's spill budget
+                if (index != first)
+                {
+                    statistics[first].spilled++;
+                    if (Profile[first].spill == SpillPolicy::Budget)
+                    {
+                        spill_outstanding[first]++;
+                        GetBlockHeader(index, block)->spill = first + 1;
+                    }
+                }
+
+                return std::next(block,
+                                 static_cast<std::ptrdiff_t>(
+                                     Layouts[index].header_space));
+            }
+
+            return nullptr;
+        }
+
+        /*
+         *  StaticMemoryManager::Free()
+         *
+         *  Description:
+         *      Free memory previously allocated by Allocate().
+         *
+         *  Parameters:
+         *      p [in]
+         *          A pointer to the memory to be freed.
+         *
+         *  Returns:
+         *      True if the memory was freed, false if the block does not
+         *      belong to this StaticMemoryManager.
+         *
+         *  Comments:
+         *      None.
+         */
+        bool Free(void *p) { return Free(p, 0); }
+
+        /*
+         *  StaticMemoryManager::Free()
+         *
+         *  Description:
+         *      Free memory previously allocated by Allocate(), given the size
+         *      that was requested.
+         *
+         *  Parameters:
+         *      p [in]
+         *          A pointer to the memory to be freed.
+         *
+         *      size [in]
+         *          The size of the memory that was requested.
+         *
+         *  Returns:
+         *      True if the memory was freed, false if the block does not
+         *      belong to this StaticMemoryManager.
+         *
+         *  Comments:
+         *      A size larger than the block indicates the caller may have
+         *      written beyond the end of the block, so the block is treated
+         *      as corrupt and returned to the heap.
+         */
+        bool Free(void *p, std::size_t size)
+        {
+            if (p == nullptr) return false;
+
+            // Ensure the block belongs to this object
+            BlockHeader *header = std::prev(static_cast<BlockHeader *>(p));
+            if ((header->owner != this) ||
+                (header->index >= Descriptor_Count))
+            {
+                return false;
+            }
+
+            const std::size_t index = header->index;
+            std::uint8_t *block =
+                std::prev(static_cast<std::uint8_t *>(p),
+                          static_cast<std::ptrdiff_t>(
+                              Layouts[index].header_space));
+
+            // Lock the mutex
+            const std::lock_guard<std::mutex> lock(mutex);
+
+            // Update the statistics
+            auto &counters = statistics[index];
+            counters.deallocations++;
+            counters.outstanding--;
+
+            // Return any spill budget used by the block
+            if ((header->spill != 0) && (header->spill <= Descriptor_Count))
+            {
+                spill_outstanding[header->spill - 1]--;
+            }
+            header->spill = 0;
+
+            // If the block is bad or the pool is full, return it to the heap
+            if (size > Profile[index].size)
+            {
+                counters.corruption_count++;
+                DeleteBlock(index, block);
+            }
+            else if (available[index] >= Profile[index].maximum)
+            {
+                DeleteBlock(index, block);
+            }
+            else
+            {
+                free_blocks[Offsets[index] + available[index]++] = block;
+            }
+
+            return true;
+        }
+
+        /*
+         *  StaticMemoryManager::GetStatistics()
+         *
+         *  Description:
+         *      Return the statistics for each descriptor.
+         *
+         *  Parameters:
+         *      None.
+         *
+         *  Returns:
+         *      A vector of Statistics structures, in profile order.
+         *
+         *  Comments:
+         *      None.
+         */
+        std::vector<Statistics> GetStatistics() const
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+
+            return std::vector<Statistics>(statistics.begin(),
+                                           statistics.end());
+        }
+
+    protected:
+        // Header placed just before the user data
+        struct BlockHeader
+        {
+            const StaticMemoryManager *owner;   // Pointer to owning object
+            std::size_t index;                  // Profile index
+            std::size_t spill;                  // Spilled from index + 1
+        };
+
+        // Placement of the header and user data within a block
+        struct BlockLayout
+        {
+            std::size_t alignment;              // Alignment of user data
+            std::size_t header_space;           // Space before user data
+            std::size_t block_size;             // Total block size
+        };
+
+        // Compute the layout of blocks for each descriptor
+        static constexpr std::array<BlockLayout, Descriptor_Count> Layouts =
+            []()
+            {
+                std::array<BlockLayout, Descriptor_Count> layouts{};
+                for (std::size_t index = 0; index < Descriptor_Count; index++)
+                {
+                    BlockLayout &layout = layouts[index];
+                    layout.alignment = std::max({Profile[index].alignment,
+                                                 alignof(std::max_align_t),
+                                                 alignof(BlockHeader)});
+                    layout.header_space =
+                        (sizeof(BlockHeader) + layout.alignment - 1) /
+                        layout.alignment * layout.alignment;
+                    layout.block_size =
+                        layout.header_space + Profile[index].size;
+                }
+                return layouts;
+            }();
+
+        // Compute the location of each descriptor's free blocks
+        static constexpr std::array<std::size_t, Descriptor_Count> Offsets =
+            []()
+            {
+                std::array<std::size_t, Descriptor_Count> offsets{};
+                std::size_t offset = 0;
+                for (std::size_t index = 0; index < Descriptor_Count; index++)
+                {
+                    offsets[index] = offset;
+                    offset += Profile[index].maximum;
+                }
+                return offsets;
+            }();
+
+        // Total number of free blocks that may be retained
+        static constexpr std::size_t Capacity =
+            Offsets.back() + Profile.back().maximum;
+
+        /*
+         *  StaticMemoryManager::CreateBlock()
+         *
+         *  Description:
+         *      Allocate a single memory block from the heap for the given
+         *      profile index and populate its header.
+         *
+         *  Parameters:
+         *      index [in]
+         *          The profile index for which a block is needed.
+         *
+         *  Returns:
+         *      A pointer to the block or nullptr if allocation failed.
+         *
+         *  Comments:
+         *      None.
+         */
+        std::uint8_t *CreateBlock(std::size_t index)
+        {
+            const BlockLayout &layout = Layouts[index];
+
+            void *memory =
+                ::operator new[](layout.block_size,
+                                 std::align_val_t{layout.alignment},
+                                 std::nothrow);
+            if (memory == nullptr) return nullptr;
+
+            auto *block = static_cast<std::uint8_t *>(memory);
+            new (GetBlockHeader(index, block)) BlockHeader{this, index, 0};
+            created[index]++;
+
+            return block;
+        }
+
+        /*
+         *  StaticMemoryManager::GetBlockHeader()
+         *
+         *  Description:
+         *      Return a pointer to the header within a memory block.
+         *
+         *  Parameters:
+         *      index [in]
+         *          The profile index to which the block belongs.
+         *
+         *      block [in]
+         *          The memory block in question.
+         *
+         *  Returns:
+         *      A pointer to the block's header.
+         *
+         *  Comments:
+         *      None.
+         */
+        static BlockHeader *GetBlockHeader(std::size_t index,
+                                           std::uint8_t *block)
+        {
+            return reinterpret_cast<BlockHeader *>(
+                std::next(block,
+                          static_cast<std::ptrdiff_t>(
+                              Layouts[index].header_space -
+                              sizeof(BlockHeader))));
+        }
+
+        /*
+         *  StaticMemoryManager::MaySpill()
+         *
+         *  Description:
+         *      Determine whether a request may be satisfied by a larger
+         *      descriptor than the first descriptor large enough, according
+         *      to the spill policy of the first descriptor.
+         *
+         *  Parameters:
+         *      first [in]
+         *          The profile index of the first descriptor large enough to
+         *          satisfy the request.
+         *
+         *      spills [in]
+         *          The number of larger descriptors tried so far, including
+         *          the one about to be tried.
+         *
+         *  Returns:
+         *      True if the request may spill to the descriptor about to be
+         *      tried, false if not.
+         *
+         *  Comments:
+         *      The mutex MUST be held by the calling function.
+         */
+        bool MaySpill(std::size_t first, std::size_t spills) const
+        {
+            switch (Profile[first].spill)
+            {
+                case SpillPolicy::Never:
+                    return false;
+
+                case SpillPolicy::Limited:
+                    return spills <= Profile[first].spill_limit;
+
+                case SpillPolicy::Budget:
+                    return spill_outstanding[first] <
+                           Profile[first].spill_limit;
+
+                default:
+                    return true;
+            }
+        }
+
+        /*
+         *  StaticMemoryManager::DeleteBlock()
+         *
+         *  Description:
+         *      Return a memory block for the given profile index to the heap.
+         *
+         *  Parameters:
+         *      index [in]
+         *          The profile index to which the block belongs.
+         *
+         *      block [in]
+         *          The memory block to delete.
+         *
+         *  Returns:
+         *      Nothing.
+         *
+         *  Comments:
+         *      None.
+         */
+        void DeleteBlock(std::size_t index, std::uint8_t *block)
+        {
+            ::operator delete[](block,
+                                std::align_val_t{Layouts[index].alignment});
+            created[index]--;
+        }
+
+        std::array<std::uint8_t *, Capacity> free_blocks;
+        std::array<std::size_t, Descriptor_Count> available;
+        std::array<std::size_t, Descriptor_Count> created;
+        std::array<std::size_t, Descriptor_Count> spill_outstanding;
+        std::array<Statistics, Descriptor_Count> statistics;
+        mutable std::mutex mutex;
+};
+
+} // namespace Terra::MemoryManager
@@ -0,0 +1,223 @@
+/*
+ *  memory_arena.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This file implements the MemoryArena object.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <terra/memory_manager/memory_arena.h>
+
+namespace Terra::MemoryManager
+{
+
+namespace
+{
+
+// Helper function to do type casting
+constexpr auto PointerDiff(std::size_t distance)
+{
+    using DiffType = std::iterator_traits<std::uint8_t *>::difference_type;
+    return static_cast<DiffType>(distance);
+}
+
+// Determine the number of octets needed to align the given pointer
+inline std::size_t AlignmentPadding(const std::uint8_t *pointer,
+                                    std::size_t alignment)
+{
+    const auto address = reinterpret_cast<std::uintptr_t>(pointer);
+
+    return (alignment - (address % alignment)) % alignment;
+}
+
+} // namespace
+
+/*
+ *  MemoryArena::MemoryArena()
+ *
+ *  Description:
+ *      Constructor for the MemoryArena object.
+ *
+ *  Parameters:
+ *      memory_manager [in]
+ *          The Memory Manager from which chunks of memory are allocated.
+ *
+ *      chunk_size [in]
+ *          The size of each chunk of memory requested from the Memory
+ *          Manager.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      No memory is allocated until the first call to Allocate().
+ */
+MemoryArena::MemoryArena(const MemoryManagerPointer &memory_manager,
+                         std::size_t chunk_size) :
+    memory_manager{memory_manager},
+    chunk_size{chunk_size},
+    position{nullptr},
+    limit{nullptr}
+{
+}
+
+/*
+ *  MemoryArena::~MemoryArena()
+ *
+ *  Description:
+ *      Destructor for the MemoryArena object, which returns all chunks to
+ *      the Memory Manager.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+MemoryArena::~MemoryArena()
+{
+    Reset();
+}
+
+/*
+ *  MemoryArena::Allocate()
+ *
+ *  Description:
+ *      Allocate memory of the requested size from the arena.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The size of the memory requested.
+ *
+ *      alignment [in]
+ *          The required alignment of the memory, which must be a power of
+ *          two (or 0 if no particular alignment is required).
+ *
+ *  Returns:
+ *      A pointer to the allocated memory or nullptr if the request could not
+ *      be satisfied or the alignment is not a power of two.
+ *
+ *  Comments:
+ *      Memory allocated from the arena is released only by Reset().
+ */
+void *MemoryArena::Allocate(std::size_t size, std::size_t alignment)
+{
+    // Use the default alignment if none is specified
+    if (alignment == 0) alignment = alignof(std::max_align_t);
+
+    // Alignment values must be a power of two
+    if (!std::has_single_bit(alignment)) return nullptr;
+
+    // Satisfy the request from the current chunk, if possible
+    if (position != nullptr)
+    {
+        const std::size_t padding = AlignmentPadding(position, alignment);
+        const auto remaining =
+            static_cast<std::size_t>(std::distance(position, limit));
+        if ((padding <= remaining) && (size <= remaining - padding))
+        {
+            std::uint8_t *memory = std::next(position, PointerDiff(padding));
+            position = std::next(memory, PointerDiff(size));
+            return memory;
+        }
+    }
+
+    // Ensure the request size plus any alignment padding is representable
+    if (size > std::numeric_limits<std::size_t>::max() - alignment)
+    {
+        return nullptr;
+    }
+
+    // Satisfy a request larger than a chunk using a dedicated allocation,
+    // leaving the current chunk in place for subsequent requests
+    if (size + alignment > chunk_size)
+    {
+        std::uint8_t *memory = AllocateChunk(size + alignment);
+        if (memory == nullptr) return nullptr;
+
+        return std::next(memory,
+                         PointerDiff(AlignmentPadding(memory, alignment)));
+    }
+
+    // Start a new chunk and allocate from the start of it
+    std::uint8_t *chunk = AllocateChunk(chunk_size);
+    if (chunk == nullptr) return nullptr;
+
+    std::uint8_t *memory =
+        std::next(chunk, PointerDiff(AlignmentPadding(chunk, alignment)));
+    position = std::next(memory, PointerDiff(size));
+    limit = std::next(chunk, PointerDiff(chunk_size));
+
+    return memory;
+}
+
+/*
+ *  MemoryArena::Reset()
+ *
+ *  Description:
+ *      Return all chunks of memory to the Memory Manager, releasing all
+ *      memory allocated from the arena.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      No memory previously allocated from the arena may be used after
+ *      calling this function.
+ */
+void MemoryArena::Reset()
+{
+    if (!chunks.empty())
+    {
+        memory_manager->FreeBatch(chunks.data(), chunks.size());
+    }
+
+    chunks.clear();
+    position = nullptr;
+    limit = nullptr;
+}
+
+/*
+ *  MemoryArena::AllocateChunk()
+ *
+ *  Description:
+ *      Allocate a chunk of memory from the Memory Manager, recording it so
+ *      that it may be released by Reset().
+ *
+ *  Parameters:
+ *      size [in]
+ *          The size of the chunk of memory requested.
+ *
+ *  Returns:
+ *      A pointer to the chunk of memory or nullptr if the request could not
+ *      be satisfied.
+ *
+ *  Comments:
+ *      None.
+ */
+std::uint8_t *MemoryArena::AllocateChunk(std::size_t size)
+{
+    void *chunk = memory_manager->Allocate(size);
+    if (chunk != nullptr) chunks.push_back(chunk);
+
+    return static_cast<std::uint8_t *>(chunk);
+}
+
+} // namespace Terra::MemoryManager
@@ -13,20 +13,42 @@
  *          [MemoryTrailer] - For corruption detection
  *
  *  Portability Issues:
- *      None.
+ *      NUMA node detection and memory placement are only implemented for
+ *      Linux.
  */
 
 #include <version>
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <new>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
+#include <chrono>
+#include <limits>
 #include <utility>
 #include <memory>
 #include <iostream>
 #include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
 #include <vector>
+#include <deque>
+#include <unordered_map>
+#include <map>
+#include <string>
+#include <fstream>
+#include <charconv>
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#endif
 #include <terra/memory_manager/memory_manager.h>
 #include <terra/logger/logger.h>
 
@@ -44,18 +66,37 @@ namespace
     constexpr std::size_t Allocation_Alignment = alignof(std::max_align_t);
 #endif
 
+// Statistics may be removed entirely at build time
+#ifdef TERRA_MEMORY_MANAGER_NO_STATISTICS
+    constexpr bool Statistics_Enabled = false;
+#else
+    constexpr bool Statistics_Enabled = true;
+#endif
+
+// Diagnostics are collected only if requested at build time
+#ifdef TERRA_MEMORY_MANAGER_DIAGNOSTICS
+    constexpr bool Diagnostics_Enabled = true;
+#else
+    constexpr bool Diagnostics_Enabled = false;
+#endif
+
 // Disable MSVC warning "Structure was padded due to alignment specifier"
 #ifdef _MSC_VER
     #pragma warning(push)
     #pragma warning(disable : 4324)
 #endif
 
-// Header placed at the start of allocated memory
+// Header placed just before the user data
 // NOLINTNEXTLINE(altera-struct-pack-align)
 struct alignas(Allocation_Alignment) MemoryHeader
 {
     MemoryManager *memory_manager;              // Pointer to owning object
     std::size_t index;                          // Profile index
+    std::uint8_t *slab;                         // Owning slab or nullptr
+    std::uint8_t *next;                         // Next free block (lock-free)
+    bool pooled;                                // Retained by lock-free pool
+    std::size_t owner;                          // Remote queue of allocator
+    std::size_t spill;                          // Spilled from index + 1
     std::uint64_t marker;                       // Head identifier
 };
 
@@ -63,6 +104,25 @@ struct alignas(Allocation_Alignment) MemoryHeader
     #pragma warning(pop)
 #endif
 
+// Header placed just before the user data when using compact headers; the
+// owning Memory Manager is located via the SlabHeader
+struct CompactHeader
+{
+    std::uint32_t offset;                       // Distance from SlabHeader
+    std::uint16_t index;                        // Profile index
+    std::uint16_t marker;                       // Head identifier
+};
+
+// Header placed at the start of each slab when using compact headers
+struct SlabHeader
+{
+    MemoryManager *memory_manager;              // Pointer to owning object
+    std::size_t index;                          // Profile index
+    bool individual;                            // Holds one separate block
+    bool pooled;                                // Retained by lock-free pool
+    std::uint64_t marker;                       // Slab identifier
+};
+
 // Trailer placed at the end of allocated memory
 struct MemoryTrailer
 {
@@ -71,31 +131,56 @@ struct MemoryTrailer
 
 // Define the header and tailer marker values
 constexpr std::uint64_t Header_Marker_Value = 0xC1F03D8B4A725378;
+constexpr std::uint16_t Compact_Marker_Value = 0x5378;
+constexpr std::uint64_t Slab_Marker_Value = 0x7B3D1E5A96C2F048;
 constexpr std::uint64_t Trailer_Marker_Value = 0x215F8A1A6853658B;
 
-// Allocate memory block
-inline std::uint8_t *AllocateBlock(std::size_t block_size)
+// Values written over user data when using ValidationPolicy::Debug
+constexpr std::uint8_t Allocated_Poison = 0xCD;
+constexpr std::uint8_t Freed_Poison = 0xDD;
+
+// Default alignment of user data when using compact headers
+constexpr std::size_t Compact_Alignment = alignof(std::max_align_t);
+
+// Target slab size when slabs are required and slab_blocks is not given
+constexpr std::size_t Default_Slab_Size = 65536;
+
+// Number of reserved blocks carved into a pool at a time
+constexpr std::size_t Reserve_Carve_Blocks = 64;
+
+// Huge page size assumed if the system does not report one
+constexpr std::size_t Default_Huge_Page_Size = 2 * 1024 * 1024;
+
+// Number of remote free queues shared among threads using remote frees
+constexpr std::size_t Remote_Queue_Count = 64;
+
+// Remote queue recorded for blocks not allocated through a thread cache
+constexpr std::size_t No_Remote_Queue =
+    std::numeric_limits<std::size_t>::max();
+
+// Round the value up to a multiple of the given alignment
+constexpr std::size_t RoundUp(std::size_t value, std::size_t alignment)
 {
-    auto total_size = sizeof(MemoryHeader) + block_size;
-    auto remainder = total_size % Allocation_Alignment;
-    if (remainder != 0) total_size += (Allocation_Alignment - remainder);
+    auto remainder = value % alignment;
+    if (remainder != 0) value += (alignment - remainder);
 
-    // The trailer is aligned to the Allocation_Alignment boundary since
-    // MemoryHeader is aligned and the allocation size is inflated, if
-    // necessary, to include padding to facilitate alignment
-    total_size += sizeof(MemoryTrailer);
+    return value;
+}
 
-    void *block = ::operator new[](total_size,
-                                   std::align_val_t{Allocation_Alignment},
-                                   std::nothrow);
+// Allocate memory having the given alignment
+inline std::uint8_t *AllocateMemory(std::size_t size, std::size_t alignment)
+{
+    void *memory = ::operator new[](size,
+                                    std::align_val_t{alignment},
+                                    std::nothrow);
 
-    return reinterpret_cast<std::uint8_t *>(block);
+    return reinterpret_cast<std::uint8_t *>(memory);
 }
 
-// Function to delete memory block
-inline void DeleteBlock(std::uint8_t *block)
+// Function to delete memory allocated with AllocateMemory()
+inline void DeleteMemory(std::uint8_t *memory, std::size_t alignment)
 {
-    ::operator delete[](block, std::align_val_t{Allocation_Alignment});
+    ::operator delete[](memory, std::align_val_t{alignment});
 }
 
 // Helper function to do type casting
@@ -105,389 +190,6256 @@ constexpr auto PointerDiff(std::size_t distance)
     return static_cast<DiffType>(distance);
 }
 
-// Helper to return a pointer to the MemoryHeader structure for this data
-constexpr std::uint8_t *GetHeaderPointer(std::uint8_t *data)
-{
-    return std::prev(data, PointerDiff(sizeof(MemoryHeader)));
-}
+// Number of bits below the leading bit used to subdivide size classes
+constexpr unsigned Size_Class_Bits = 3;
+
+// Number of size classes needed to cover all possible request sizes
+constexpr std::size_t Size_Class_Count =
+    (std::numeric_limits<std::size_t>::digits - Size_Class_Bits + 1)
+    << Size_Class_Bits;
 
-// Helper to return a pointer to the user "data" block after the header
-constexpr std::uint8_t *GetDataPointer(std::uint8_t *block)
+// Map a request size to a size class; each power of two range of sizes is
+// divided into 2^Size_Class_Bits classes, so classes are at most 12.5% wide
+constexpr std::size_t SizeClass(std::size_t size)
 {
-    return std::next(block, PointerDiff(sizeof(MemoryHeader)));
+    const std::size_t value = (size > 0) ? size - 1 : 0;
+
+    // Small sizes map directly to a class
+    if (value < (std::size_t{1} << Size_Class_Bits)) return value;
+
+    // Use the position of the leading bit and the bits that follow it
+    const auto exponent = static_cast<unsigned>(std::bit_width(value)) - 1;
+    const std::size_t mantissa = (value >> (exponent - Size_Class_Bits)) &
+                                 ((std::size_t{1} << Size_Class_Bits) - 1);
+
+    return ((exponent - Size_Class_Bits + 1) << Size_Class_Bits) | mantissa;
 }
 
-// Helper to return a pointer to the memory block trailer
-constexpr std::uint8_t *GetTrailerPointer(std::uint8_t *block,
-                                          std::size_t block_size)
+// Map a duration in nanoseconds to a latency histogram bucket; each power of
+// two range of durations is divided into four buckets
+constexpr std::size_t LatencyBucket(std::uint64_t nanoseconds)
 {
-    auto total_size =
-        sizeof(MemoryHeader) + block_size;
-    auto remainder = total_size % Allocation_Alignment;
-    if (remainder != 0) total_size += (Allocation_Alignment - remainder);
+    // Short durations map directly to a bucket
+    if (nanoseconds < 4) return static_cast<std::size_t>(nanoseconds);
 
-    return std::next(block, PointerDiff(total_size));
+    // Use the position of the leading bit and the two bits that follow it
+    const auto exponent =
+        static_cast<unsigned>(std::bit_width(nanoseconds)) - 1;
+    const auto bucket = static_cast<std::size_t>(
+        (std::uint64_t{exponent - 1} << 2) |
+        ((nanoseconds >> (exponent - 2)) & 3));
+
+    return std::min(bucket, Latency_Buckets - 1);
 }
 
-} // namespace
+// Define a histogram of durations that may be updated by several threads
+using LatencyCounters = std::array<std::atomic<std::uint64_t>, Latency_Buckets>;
 
-/*
- *  MemoryManager::MemoryManager()
- *
- *  Description:
- *      Constructor for the MemoryManager object.
- *
- *  Parameters:
- *      profile [in]
- *          The MemoryProfile to use with this MemoryManager.
- *
- *  Returns:
- *      profile [in]
- *          The memory profile that contains a vector of MemoryDescriptor
- *          structures that will be used by the Memory Manager.
- *
- *      parent_logger [in]
- *          An optional Logger object to which logging output will be directed.
- *
- *      log_statistics [in]
- *          Log usage statistics on destruction.
- *
- *  Comments:
- *      None.
- */
-MemoryManager::MemoryManager(MemoryProfile profile,
-                             const Logger::LoggerPointer &parent_logger,
-                             bool log_statistics) :
-    profile{std::move(profile)},
-    logger{std::make_shared<Logger::Logger>(parent_logger, "MMGR")},
-    log_statistics{log_statistics}
+// Measures the duration of an operation and, when diagnostics are enabled,
+// records it in the attached histogram when recorded or destroyed
+class LatencyTimer
 {
-    logger->info << "Initializing memory profiles" << std::flush;
-
-    // Sort the profile deque according to size
-    std::ranges::sort(
-        this->profile,
-        [](const MemoryDescriptor &a, const MemoryDescriptor &b) -> bool
-        { return a.size < b.size; });
-
-    // Allocate memory
-    for (std::size_t index = 0; index < this->profile.size(); index++)
-    {
-        // If maximum is less than minumum, make them equal
-        if ((this->profile[index].maximum != 0) &&
-            (this->profile[index].maximum < this->profile[index].minimum))
+    public:
+        LatencyTimer()
         {
-            logger->warning << "Descriptor size " << this->profile[index].size
-                            << " has an invalid maximum value" << std::flush;
-            this->profile[index].maximum = this->profile[index].minimum;
+            if constexpr (Diagnostics_Enabled)
+            {
+                start = std::chrono::steady_clock::now();
+            }
         }
+        LatencyTimer(const LatencyTimer &other) = delete;
+        LatencyTimer(const LatencyTimer &&other) = delete;
+        ~LatencyTimer() { Record(); }
 
-        // Create a zero-initialized Statistics structure for this profile entry
-        statistics.emplace_back(Statistics{});
-        statistics.back().size = this->profile[index].size;
-
-        // Create an empty allocations element
-        allocations.emplace_back();
+        LatencyTimer &operator=(const LatencyTimer &other) = delete;
+        LatencyTimer &operator=(const LatencyTimer &&other) = delete;
 
-        logger->info << "Descriptor size " << this->profile[index].size
-                     << ", count " << this->profile[index].minimum
-                     << std::flush;
+        void Attach(LatencyCounters &counters) { histogram = &counters; }
 
-        // Allocate the requested number of blocks
-        for (std::size_t i = 0; i < this->profile[index].minimum; i++)
+        void Record()
         {
-            PerformAllocation(index);
+            if constexpr (Diagnostics_Enabled)
+            {
+                if (histogram == nullptr) return;
+                const auto elapsed =
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start);
+                (*histogram)[LatencyBucket(
+                                 static_cast<std::uint64_t>(elapsed.count()))]
+                    .fetch_add(1, std::memory_order_relaxed);
+                histogram = nullptr;
+            }
         }
+
+    protected:
+        std::chrono::steady_clock::time_point start;
+        LatencyCounters *histogram = nullptr;
+};
+
+// Head of a lock-free stack with a tag that changes on each update to
+// prevent the ABA problem
+struct alignas(2 * sizeof(std::uintptr_t)) TaggedPointer
+{
+    std::uint8_t *block;                        // Block at the top of stack
+    std::uintptr_t tag;                         // Modification counter
+};
+
+// Add to a counter that has only one writer at a time (e.g., while holding
+// the mutex or when owned by a single thread)
+inline void Count(std::atomic<std::uint64_t> &counter, std::uint64_t value = 1)
+{
+    if constexpr (Statistics_Enabled)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value,
+                      std::memory_order_relaxed);
     }
 }
 
-/*
- *  MemoryManager::~MemoryManager()
- *
- *  Description:
- *      Allocate a block of memory for the given profile index.
- *
- *  Parameters:
- *      Nome.
- *
- *  Returns:
- *      Nothing.
- *
- *  Comments:
- *      The mutex MUST be locked by the calling function.
- */
-MemoryManager::~MemoryManager()
+// Decrement a counter that has only one writer at a time
+inline void Uncount(std::atomic<std::uint64_t> &counter)
 {
-    logger->info << "Memory Manager Usage Statistics" << std::flush;
-
-    // Iterate over each descriptor in the profile
-    for (std::size_t index = 0; index < profile.size(); index++)
+    if constexpr (Statistics_Enabled)
     {
-        if (log_statistics)
-        {
-            logger->info << "  Block size: " << profile[index].size
-                         << std::flush;
-            logger->info << "    Allocations: " << statistics[index].allocations
-                         << std::flush;
-            logger->info << "    Deallocations: "
-                         << statistics[index].deallocations << std::flush;
-            logger->info << "    Corrupted: "
-                         << statistics[index].corruption_count << std::flush;
-            logger->info << "    Max Outstanding: "
-                         << statistics[index].max_outstanding << std::flush;
-            logger->info << "    Outstanding: " << statistics[index].outstanding
-                         << std::flush;
-            logger->info << "    Unfulfilled: " << statistics[index].unfulfilled
-                         << std::flush;
-        }
+        const std::uint64_t value = counter.load(std::memory_order_relaxed);
+        if (value > 0) counter.store(value - 1, std::memory_order_relaxed);
+    }
+}
 
-        // Free all allocated memory in the deque
-        while (!allocations[index].empty())
+// Raise a maximum value that has only one writer at a time
+inline void CountMaximum(std::atomic<std::uint64_t> &maximum,
+                         std::uint64_t value)
+{
+    if constexpr (Statistics_Enabled)
+    {
+        if (value > maximum.load(std::memory_order_relaxed))
         {
-            std::uint8_t *block = allocations[index].back();
-            allocations[index].pop_back();
-            DeleteBlock(block);
+            maximum.store(value, std::memory_order_relaxed);
         }
     }
 }
 
-/*
- *  MemoryManager::Allocate()
- *
- *  Description:
- *      This function will allocate memory of the requested size.  It does this
- *      by searching through the MemoryProfile looking for a descriptor that
- *      is for memory blocks large enough to satisfy the request.  It will then
- *      return a block from that part of the profile, if the request can be
- *      satisfied.  If it cannot, it will move to the next (larger) descriptor
- *      and attempt the request again.
- *
- *  Parameters:
- *      size [in]
- *          The size of the memory requested.
- *
- *  Returns:
- *      A pointer to a block of memory the user may use or nullptr if the
- *      request could not be satisfied.
- *
- *  Comments:
- *      None.
- */
-void *MemoryManager::Allocate(std::size_t size)
+// Add to a counter that may be written by several threads at once
+inline void AtomicCount(std::atomic<std::uint64_t> &counter,
+                        std::uint64_t value = 1)
 {
-    // Lock the mutex
-    const std::lock_guard<std::mutex> lock(mutex);
-
-    // Iterate over each descriptor in the profile for available memory
-    for (std::size_t index = 0; index < profile.size(); index++)
+    if constexpr (Statistics_Enabled)
     {
-        // If the descriptor indicates memory is too small, keep looking
-        if (profile[index].size < size) continue;
-
-        // If no memory blocks are available and allocation fails, keep looking
-        if (allocations[index].empty() && !PerformAllocation(index))
-        {
-            // Note a fulfillment attempt failed
-            statistics[index].unfulfilled++;
-            continue;
-        }
+        counter.fetch_add(value, std::memory_order_relaxed);
+    }
+}
 
-        // There should be a memory block, but double-check out of paranoia
-        if (!allocations[index].empty())
-        {
-            // Update various statistics
-            statistics[index].allocations++;
-            statistics[index].outstanding++;
-            statistics[index].max_outstanding =
-                std::max(statistics[index].outstanding,
-                         statistics[index].max_outstanding);
+// Atomically raise a maximum value to the given value
+inline void AtomicMaximum(std::atomic<std::uint64_t> &maximum,
+                          std::uint64_t value)
+{
+    if constexpr (!Statistics_Enabled) return;
 
-            // Grab a memory block off the back
-            uint8_t *block = allocations[index].back();
-            allocations[index].pop_back();
+    std::uint64_t current = maximum.load(std::memory_order_relaxed);
+    while ((value > current) &&
+           !maximum.compare_exchange_weak(current,
+                                          value,
+                                          std::memory_order_relaxed))
+    {
+    }
+}
 
-            // Return a pointer to the data just after the MemoryHeader
-            return GetDataPointer(block);
-        }
+// Determine the number of NUMA nodes in the system
+inline std::size_t NumaNodeCount()
+{
+#ifdef __linux__
+    // The file lists ranges of online nodes (e.g., "0-3" or "0,2")
+    std::ifstream online("/sys/devices/system/node/online");
+    std::string nodes;
+    if (std::getline(online, nodes) && !nodes.empty())
+    {
+        // The highest node number follows the last separator
+        const auto separator = nodes.find_last_of("-,");
+        const char *first =
+            nodes.data() + ((separator == std::string::npos) ? 0 :
+                                                               separator + 1);
+        std::size_t highest = 0;
+        const auto [last, error] =
+            std::from_chars(first, nodes.data() + nodes.size(), highest);
+        if (error == std::errc()) return highest + 1;
     }
+#endif
 
-    return nullptr;
+    return 1;
 }
 
-/*
- *  MemoryManager::Free()
- *
- *  Description:
- *      This function will free a block of memory.  Internally, the pointer
- *      will just be returned to the vector of allocated memory blocks.
- *      If, however, the vector of pointers exceed the maximum number then
- *      the block will be freed to the heap.
- *
- *  Parameters:
- *      p [in]
- *          Pointer to a block of memory provided by Allocate().
- *
- *  Returns:
- *      True if memory is freed, false if not.  The only reason false will
- *      be returned is if the pointer given does not belong to this Memory
- *      Manager.  This could happen if memory is corrupted.
- *
- *  Comments:
- *      It is important that the pointer provided actually be allocated by
- *      the Memory Manager, else this function might cause an access violation
- *      or memory leak.
- */
-bool MemoryManager::Free(void *p)
+// Determine the NUMA node on which the calling thread is running
+inline std::size_t CurrentNumaNode()
 {
-    // Does the memory block appear bad?
-    bool bad_block = false;
+#ifdef __linux__
+    unsigned cpu = 0;
+    unsigned node = 0;
+#if defined(__GLIBC__) && defined(__GLIBC_PREREQ)
+#if __GLIBC_PREREQ(2, 29)
+    // The library function avoids a system call where possible
+    if (getcpu(&cpu, &node) == 0) return node;
+#else
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) return node;
+#endif
+#else
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) return node;
+#endif
+#endif
 
-    // Lock the mutex
-    const std::lock_guard<std::mutex> lock(mutex);
+    return 0;
+}
 
-    // Get access to the MemoryHeader location (same as block location)
-    std::uint8_t *block = GetHeaderPointer(reinterpret_cast<std::uint8_t *>(p));
-    const MemoryHeader *header = reinterpret_cast<MemoryHeader *>(block);
+// Determine the size of a page of memory
+inline std::size_t PageSize()
+{
+#ifdef __linux__
+    const long page_size = sysconf(_SC_PAGESIZE);
+    if (page_size > 0) return static_cast<std::size_t>(page_size);
+#endif
 
-    // Ensure that memory block is valid
-    if (block == nullptr)
-    {
-        logger->error << "The pointer given does not appear to be valid"
-                      << std::flush;
-        return false;
-    }
+    return 4096;
+}
 
-    // Verify that memory appears to belong to this Memory Manager
-    if (header->memory_manager != this)
+// Determine the size of a huge page of memory
+inline std::size_t HugePageSize()
+{
+    static const std::size_t huge_page_size = []() -> std::size_t
     {
-        logger->error << "Attempt to free memory not allocated with this "
-                         "Memory Manager object"
-                      << std::flush;
-        return false;
-    }
+#ifdef __linux__
+        // The size is reported in KiB (e.g., "Hugepagesize:    2048 kB")
+        std::ifstream meminfo("/proc/meminfo");
+        std::string name;
+        while (meminfo >> name)
+        {
+            std::size_t size = 0;
+            if ((name == "Hugepagesize:") && (meminfo >> size) && (size > 0))
+            {
+                return size * 1024;
+            }
+            meminfo.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+#endif
 
-    // Verify header marker
-    if (header->marker != Header_Marker_Value) bad_block = true;
+        return Default_Huge_Page_Size;
+    }();
 
-    // Check that the block index is within a valid range
-    if (!profile.empty() && (header->index > profile.size() - 1))
-    {
-        logger->error << "Free request made, but the descriptor data is bad; "
-                         "memory will be freed to the heap" << std::flush;
-        DeleteBlock(block);
-        return true;
-    }
+    return huge_page_size;
+}
 
-    // Get the pointer to the memory block trailer
-    const MemoryTrailer *trailer = reinterpret_cast<MemoryTrailer *>(
-        GetTrailerPointer(block, profile[header->index].size));
+// Map memory having the given alignment directly from the operating system,
+// providing the length of the mapping; returns nullptr on failure
+inline std::uint8_t *MapMemory([[maybe_unused]] std::size_t size,
+                               [[maybe_unused]] std::size_t alignment,
+                               [[maybe_unused]] MemorySource source,
+                               [[maybe_unused]] bool prefault,
+                               std::size_t &length)
+{
+    length = 0;
 
-    // Check trailer marker to ensure memory is not corrupt
-    if (trailer->marker != Trailer_Marker_Value) bad_block = true;
+#ifdef __linux__
+    constexpr int Protection = PROT_READ | PROT_WRITE;
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    const std::size_t page_size = PageSize();
+    const bool huge = (source == MemorySource::HugePages);
 
-    // Update statistics
-    statistics[header->index].deallocations++;
-    if (statistics[header->index].outstanding > 0)
+    // Use huge pages reserved by the system, if available
+    if (huge && (alignment <= HugePageSize()))
     {
-        statistics[header->index].outstanding--;
+        const std::size_t huge_length = RoundUp(size, HugePageSize());
+        void *memory = mmap(nullptr,
+                            huge_length,
+                            Protection,
+                            flags | MAP_HUGETLB | (prefault ? MAP_POPULATE : 0),
+                            -1,
+                            0);
+        if (memory != MAP_FAILED)
+        {
+            length = huge_length;
+            return static_cast<std::uint8_t *>(memory);
+        }
     }
 
-    // If the block is bad, update statistics, delete, and return to heap
-    if (bad_block)
+    // Otherwise, map regular pages; for transparent huge pages, the mapping
+    // is aligned to a huge page boundary
+    const std::size_t boundary =
+        std::max({alignment, page_size, huge ? HugePageSize() : 0});
+    const std::size_t mapped_length = RoundUp(size, boundary);
+    const std::size_t padding = (boundary > page_size) ? boundary : 0;
+    void *memory =
+        mmap(nullptr,
+             mapped_length + padding,
+             Protection,
+             flags | ((prefault && !huge && (padding == 0)) ? MAP_POPULATE : 0),
+             -1,
+             0);
+    if (memory == MAP_FAILED) return nullptr;
+
+    // Release any portion of the mapping outside of the aligned region
+    auto *start = static_cast<std::uint8_t *>(memory);
+    const std::size_t head =
+        RoundUp(reinterpret_cast<std::uintptr_t>(start), boundary) -
+        reinterpret_cast<std::uintptr_t>(start);
+    if (head > 0) munmap(start, head);
+    if (padding > head)
     {
-        statistics[header->index].corruption_count++;
-        DeleteBlock(block);
-        return true;
+        munmap(std::next(start, PointerDiff(head + mapped_length)),
+               padding - head);
     }
+    std::uint8_t *aligned = std::next(start, PointerDiff(head));
 
-    // Put the block back on the vector, if possible else free to the heap
-    if ((profile[header->index].maximum == 0) ||
-        (allocations[header->index].size() < profile[header->index].maximum))
+    // Request transparent huge pages, then fault in pages as requested
+    if (huge) madvise(aligned, mapped_length, MADV_HUGEPAGE);
+    if (prefault && (huge || (padding > 0)))
     {
-        allocations[header->index].push_back(block);
+        for (std::size_t offset = 0; offset < mapped_length;
+             offset += page_size)
+        {
+            aligned[offset] = 0;
+        }
     }
-    else
+
+    length = mapped_length;
+    return aligned;
+#else
+    return nullptr;
+#endif
+}
+
+// Function to release memory mapped with MapMemory()
+inline void UnmapMemory([[maybe_unused]] std::uint8_t *memory,
+                        [[maybe_unused]] std::size_t length)
+{
+#ifdef __linux__
+    munmap(memory, length);
+#endif
+}
+
+// Map a block of the given size and alignment so that it ends as near as
+// alignment permits to an inaccessible guard page; returns nullptr on failure
+inline std::uint8_t *MapGuardedBlock([[maybe_unused]] std::size_t size,
+                                     [[maybe_unused]] std::size_t alignment)
+{
+#ifdef __linux__
+    const std::size_t page_size = PageSize();
+    const std::size_t span = RoundUp(size, page_size);
+    void *memory = mmap(nullptr,
+                        span + page_size,
+                        PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS,
+                        -1,
+                        0);
+    if (memory == MAP_FAILED) return nullptr;
+
+    auto *start = static_cast<std::uint8_t *>(memory);
+    if (mprotect(std::next(start, PointerDiff(span)), page_size, PROT_NONE) !=
+        0)
     {
-        DeleteBlock(block);
+        munmap(memory, span + page_size);
+        return nullptr;
     }
 
-    return true;
+    // The mapping is page-aligned, so an offset that is a multiple of the
+    // alignment (which is no greater than the page size) aligns the block
+    return std::next(start, PointerDiff((span - size) & ~(alignment - 1)));
+#else
+    return nullptr;
+#endif
 }
 
-/*
+// Function to release a block mapped with MapGuardedBlock()
+inline void UnmapGuardedBlock([[maybe_unused]] std::uint8_t *block,
+                              [[maybe_unused]] std::size_t size)
+{
+#ifdef __linux__
+    const std::size_t page_size = PageSize();
+    auto *start = reinterpret_cast<std::uint8_t *>(
+        reinterpret_cast<std::uintptr_t>(block) & ~(page_size - 1));
+    munmap(start, RoundUp(size, page_size) + page_size);
+#endif
+}
+
+// Determine whether the calling thread should fully validate the block it
+// is freeing, given the number of frees per validated free
+inline bool SampleFree(std::size_t interval)
+{
+    thread_local std::size_t frees = 0;
+
+    return (interval <= 1) || ((++frees % interval) == 0);
+}
+
+// Request that the pages of the given page-aligned memory be placed on a
+// NUMA node; this is only a preference, so failure is not an error.  Only
+// whole pages are bound, since a partial last page of heap memory may be
+// shared with unrelated data.
+inline void BindToNode([[maybe_unused]] std::uint8_t *memory,
+                       [[maybe_unused]] std::size_t size,
+                       [[maybe_unused]] std::size_t node)
+{
+#ifdef __linux__
+    constexpr int Preferred_Policy = 1;         // MPOL_PREFERRED
+    constexpr unsigned Move_Flag = 2;           // MPOL_MF_MOVE
+    constexpr std::size_t Mask_Bits =
+        std::numeric_limits<unsigned long>::digits;
+
+    size -= size % PageSize();
+    if (size == 0) return;
+
+    std::vector<unsigned long> mask((node / Mask_Bits) + 1);
+    mask[node / Mask_Bits] = 1UL << (node % Mask_Bits);
+    syscall(SYS_mbind,
+            memory,
+            size,
+            Preferred_Policy,
+            mask.data(),
+            (mask.size() * Mask_Bits) + 1,
+            Move_Flag);
+#endif
+}
+
+// Fraction of the peak usage (as a shift) added when recommending sizes
+constexpr unsigned Adaptive_Headroom_Shift = 2;
+
+// Maximum number of blocks pre-allocated each time a descriptor is adapted
+constexpr std::size_t Adaptive_Warm_Blocks = 64;
+
+// Determine the outstanding count reached given a thread cache's peak
+constexpr std::uint64_t PeakOutstanding(std::uint64_t outstanding,
+                                        std::int64_t peak)
+{
+    // The folded count is modular and may transiently appear negative
+    const auto total = static_cast<std::int64_t>(outstanding) + peak;
+
+    return total > 0 ? static_cast<std::uint64_t>(total) : 0;
+}
+
+} // namespace
+
+// Arrangement of the memory blocks for a single descriptor; a block consists
+// of padding (if needed), a header, the user data, and a trailer
+struct BlockLayout
+{
+    std::size_t alignment;                      // Alignment of user data
+    std::size_t header_space;                   // Distance to user data
+    std::size_t trailer_offset;                 // Distance to the trailer
+    std::size_t block_size;                     // Total size of a block
+    std::size_t stride;                         // Distance between blocks
+    std::size_t slab_offset;                    // Distance to the first block
+    std::size_t slab_alignment;                 // Alignment of slabs
+    bool guarded;                               // Mapped before a guard page
+};
+
+namespace
+{
+
+// Determine the arrangement of memory blocks for the given descriptor
+constexpr BlockLayout MakeLayout(const MemoryDescriptor &descriptor,
+                                 bool compact,
+                                 bool trailer)
+{
+    BlockLayout layout{};
+
+    if (compact)
+    {
+        // User data must be suitably aligned to hold a free list pointer
+        layout.alignment = std::max({descriptor.alignment,
+                                     Compact_Alignment,
+                                     alignof(std::uint8_t *)});
+        layout.header_space = RoundUp(sizeof(CompactHeader), layout.alignment);
+        layout.slab_offset = RoundUp(sizeof(SlabHeader), layout.alignment);
+    }
+    else
+    {
+        // The MemoryHeader requires Allocation_Alignment
+        layout.alignment =
+            std::max(descriptor.alignment, Allocation_Alignment);
+        layout.header_space = RoundUp(sizeof(MemoryHeader), layout.alignment);
+        layout.slab_offset = 0;
+    }
+
+    // The trailer (if any) immediately follows the (suitably aligned) user
+    // data
+    layout.trailer_offset =
+        layout.header_space +
+        RoundUp(std::max(descriptor.size, std::size_t{1}),
+                alignof(MemoryTrailer));
+    layout.block_size =
+        layout.trailer_offset + (trailer ? sizeof(MemoryTrailer) : 0);
+    layout.stride = RoundUp(layout.block_size, layout.alignment);
+    layout.slab_alignment = layout.alignment;
+
+    return layout;
+}
+
+// Helper to return a pointer to the user data within a block
+inline std::uint8_t *GetDataPointer(const BlockLayout &layout,
+                                    std::uint8_t *block)
+{
+    return std::next(block, PointerDiff(layout.header_space));
+}
+
+// Helper to return a pointer to the MemoryHeader structure within a block
+inline MemoryHeader *GetMemoryHeader(const BlockLayout &layout,
+                                     std::uint8_t *block)
+{
+    return reinterpret_cast<MemoryHeader *>(
+        std::prev(GetDataPointer(layout, block),
+                  PointerDiff(sizeof(MemoryHeader))));
+}
+
+// Helper to read the owning Memory Manager from the MemoryHeader before the
+// given user data; the data may not have come from a Memory Manager, so the
+// value is copied out rather than read through a possibly misaligned header
+inline MemoryManager *ReadHeaderOwner(const std::uint8_t *data)
+{
+    MemoryManager *memory_manager = nullptr;
+    std::memcpy(&memory_manager,
+                std::prev(data,
+                          PointerDiff(sizeof(MemoryHeader) -
+                                      offsetof(MemoryHeader, memory_manager))),
+                sizeof(memory_manager));
+
+    return memory_manager;
+}
+
+// Helper to return a pointer to the CompactHeader structure within a block
+inline CompactHeader *GetCompactHeader(const BlockLayout &layout,
+                                       std::uint8_t *block)
+{
+    return reinterpret_cast<CompactHeader *>(
+        std::prev(GetDataPointer(layout, block),
+                  PointerDiff(sizeof(CompactHeader))));
+}
+
+// Helper to return a pointer to the SlabHeader for a block with a
+// CompactHeader
+inline SlabHeader *GetSlabHeader(const BlockLayout &layout, std::uint8_t *block)
+{
+    CompactHeader *header = GetCompactHeader(layout, block);
+
+    return reinterpret_cast<SlabHeader *>(
+        std::prev(reinterpret_cast<std::uint8_t *>(header),
+                  PointerDiff(header->offset)));
+}
+
+// Helper to return a pointer to the memory block trailer
+inline MemoryTrailer *GetTrailer(const BlockLayout &layout,
+                                 std::uint8_t *block)
+{
+    return reinterpret_cast<MemoryTrailer *>(
+        std::next(block, PointerDiff(layout.trailer_offset)));
+}
+
+// Populate the SlabHeader at the start of a slab
+inline void InitializeSlab(std::uint8_t *slab,
+                           MemoryManager *memory_manager,
+                           std::size_t index,
+                           bool individual)
+{
+    SlabHeader *header = new (slab) SlabHeader{};
+    header->memory_manager = memory_manager;
+    header->index = index;
+    header->individual = individual;
+    header->pooled = false;
+    header->marker = Slab_Marker_Value;
+}
+
+// State of a single Memory Manager known to the registry; entries are
+// recycled rather than freed, since FreeAny() may still read an entry just
+// after the Memory Manager has stopped waiting on it
+struct RegistryEntry
+{
+    std::atomic<std::size_t> pins;              // FreeAny() calls in progress
+    std::atomic<bool> retiring;                 // Object is being destroyed
+};
+
+// Extent and owner of a slab holding blocks having compact headers
+struct SlabExtent
+{
+    std::uintptr_t end;                         // Address past end of slab
+    MemoryManager *memory_manager;              // Owning object
+};
+
+// Registry of every Memory Manager in existence, which FreeAny() uses to
+// locate the owner of a block; an owner is pinned while FreeAny() returns a
+// block to it so that it is not destroyed in the meantime.  The slabs of
+// Memory Managers given the free_any option are indexed by address under a
+// separate lock, since blocks having compact headers carry no owner.
+struct ManagerRegistry
+{
+    std::shared_mutex mutex;
+    std::unordered_map<MemoryManager *, RegistryEntry *> managers;
+    std::deque<RegistryEntry> entries;
+    std::vector<RegistryEntry *> spare_entries;
+    std::mutex release_mutex;
+    std::condition_variable released;
+    std::shared_mutex slab_mutex;
+    std::map<std::uintptr_t, SlabExtent> slabs; // Keyed by slab start
+    std::atomic<std::size_t> slab_count;
+};
+
+// Return the registry shared by all Memory Managers; since it is created by
+// the first Memory Manager constructed, it outlives every Memory Manager
+inline ManagerRegistry &GetManagerRegistry()
+{
+    static ManagerRegistry registry;
+
+    return registry;
+}
+
+// Record the existence of a Memory Manager
+inline void RegisterManager(MemoryManager *memory_manager)
+{
+    ManagerRegistry &registry = GetManagerRegistry();
+    const std::lock_guard<std::shared_mutex> lock(registry.mutex);
+
+    RegistryEntry *entry = nullptr;
+    if (registry.spare_entries.empty())
+    {
+        entry = &registry.entries.emplace_back();
+    }
+    else
+    {
+        entry = registry.spare_entries.back();
+        registry.spare_entries.pop_back();
+    }
+    entry->pins.store(0, std::memory_order_relaxed);
+    entry->retiring.store(false, std::memory_order_relaxed);
+
+    registry.managers.insert_or_assign(memory_manager, entry);
+}
+
+// Remove a Memory Manager and any slabs it recorded from the registry,
+// waiting for any calls to FreeAny() returning blocks to it to complete
+inline void UnregisterManager(MemoryManager *memory_manager)
+{
+    ManagerRegistry &registry = GetManagerRegistry();
+    RegistryEntry *entry = nullptr;
+
+    // Once removed, FreeAny() can no longer pin the object; the flag pairs
+    // with the check made in FreeAny() when releasing its pin
+    {
+        const std::lock_guard<std::shared_mutex> lock(registry.mutex);
+
+        auto found = registry.managers.find(memory_manager);
+        if (found == registry.managers.end()) return;
+        entry = found->second;
+        registry.managers.erase(found);
+        entry->retiring.store(true, std::memory_order_seq_cst);
+    }
+
+    // Wait for calls to FreeAny() that pinned the object
+    {
+        std::unique_lock<std::mutex> lock(registry.release_mutex);
+        registry.released.wait(
+            lock,
+            [&]() {
+                return entry->pins.load(std::memory_order_seq_cst) == 0;
+            });
+    }
+
+    // The entry may now be used for another Memory Manager
+    {
+        const std::lock_guard<std::shared_mutex> lock(registry.mutex);
+        registry.spare_entries.push_back(entry);
+    }
+
+    // Forget any slabs still recorded, such as those holding blocks that
+    // were never freed
+    if (registry.slab_count.load(std::memory_order_relaxed) > 0)
+    {
+        const std::lock_guard<std::shared_mutex> lock(registry.slab_mutex);
+        const std::size_t erased = std::erase_if(
+            registry.slabs,
+            [&](const auto &slab)
+            { return slab.second.memory_manager == memory_manager; });
+        registry.slab_count.fetch_sub(erased, std::memory_order_relaxed);
+    }
+}
+
+// Record the extent of a slab holding blocks having compact headers
+inline void RegisterSlab(MemoryManager *memory_manager,
+                         const std::uint8_t *slab,
+                         std::size_t length)
+{
+    ManagerRegistry &registry = GetManagerRegistry();
+    const std::lock_guard<std::shared_mutex> lock(registry.slab_mutex);
+
+    const auto address = reinterpret_cast<std::uintptr_t>(slab);
+    if (registry.slabs
+            .insert_or_assign(address,
+                              SlabExtent{address + length, memory_manager})
+            .second)
+    {
+        registry.slab_count.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// Remove a slab from those recorded before it is freed
+inline void UnregisterSlab(const std::uint8_t *slab)
+{
+    ManagerRegistry &registry = GetManagerRegistry();
+    const std::lock_guard<std::shared_mutex> lock(registry.slab_mutex);
+
+    if (registry.slabs.erase(reinterpret_cast<std::uintptr_t>(slab)) > 0)
+    {
+        registry.slab_count.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace
+
+// Statistics for a single descriptor; these are atomic and reside on their
+// own cache line so they can be read without locking the mutex
+// NOLINTNEXTLINE(altera-struct-pack-align)
+struct alignas(Allocation_Alignment) StatisticsCounters
+{
+    std::atomic<std::uint64_t> allocations;     // User allocations
+    std::atomic<std::uint64_t> deallocations;   // User deallocations
+    std::atomic<std::uint64_t> corruption_count;// Corrupt block count
+    std::atomic<std::uint64_t> max_outstanding; // Maximum blocks outstanding
+    std::atomic<std::uint64_t> outstanding;     // Blocks outstanding
+    std::atomic<std::uint64_t> unfulfilled;     // Allocations unfulfilled
+    std::atomic<std::uint64_t> spilled;         // Allocations spilled
+};
+
+// Diagnostic counters for each descriptor, collected only when diagnostics
+// are enabled
+struct alignas(Allocation_Alignment) DiagnosticCounters
+{
+    LatencyCounters allocate_latency;           // Allocate() durations
+    LatencyCounters free_latency;               // Free() durations
+    std::atomic<std::uint64_t> heap_allocations;// Blocks or slabs allocated
+    std::atomic<std::uint64_t> heap_frees;      // Blocks or slabs freed
+};
+
+// Free blocks in the pool for a single descriptor, held on a stack linked
+// through the blocks themselves so that the pool never allocates memory
+struct FreeList
+{
+    std::uint8_t *head;                         // Most recently freed block
+    std::size_t count;                          // Blocks in the list
+};
+
+// A slab allocated for a single descriptor; a slab having a non-zero length
+// was mapped from the operating system
+struct SlabRecord
+{
+    std::uint8_t *slab;                         // Start of the slab
+    std::size_t length;                         // Length of the mapping
+    std::size_t count;                          // Blocks in the slab
+};
+
+// A slab reserved for a descriptor's pre-allocated blocks, from which blocks
+// are carved when needed
+struct PoolReserve
+{
+    std::uint8_t *slab;                         // Start of the slab
+    std::size_t carved;                         // Blocks carved so far
+    std::size_t count;                          // Blocks in the slab
+};
+
+// State of a single descriptor when using the lock-free engine
+// NOLINTNEXTLINE(altera-struct-pack-align)
+struct alignas(Allocation_Alignment) LockFreeBucket
+{
+    std::atomic<TaggedPointer> head;            // Stack of free blocks
+    std::atomic<std::size_t> total;             // Blocks that exist
+    std::atomic<std::size_t> pooled;            // Blocks retained by the pool
+};
+
+// Per-thread counters for a single descriptor (only the owning thread writes)
+struct ThreadCacheCounters
+{
+    std::atomic<std::uint64_t> allocations;     // User allocations
+    std::atomic<std::uint64_t> deallocations;   // User deallocations
+    std::atomic<std::int64_t> peak;             // Peak net allocations
+};
+
+// Free blocks and statistics held by one thread for one Memory Manager
+struct ThreadCache
+{
+    std::vector<std::vector<std::uint8_t *>> blocks;
+    std::vector<ThreadCacheCounters> counters;
+    std::size_t queue;                          // Remote queue for this thread
+};
+
+// Disable MSVC warning "Structure was padded due to alignment specifier"
+#ifdef _MSC_VER
+    #pragma warning(push)
+    #pragma warning(disable : 4324)
+#endif
+
+// Mutex protecting a pool that, when diagnostics are enabled, counts its
+// acquisitions and the time spent waiting for it; counters are updated only
+// while the mutex is held
+class PoolMutex
+{
+    public:
+        void lock()
+        {
+            if constexpr (Diagnostics_Enabled)
+            {
+                if (!mutex.try_lock())
+                {
+                    const auto start = std::chrono::steady_clock::now();
+                    mutex.lock();
+                    const auto elapsed =
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - start);
+                    Increase(contentions, 1);
+                    Increase(wait_time,
+                             static_cast<std::uint64_t>(elapsed.count()));
+                }
+                Increase(acquisitions, 1);
+            }
+            else
+            {
+                mutex.lock();
+            }
+        }
+
+        bool try_lock()
+        {
+            if (!mutex.try_lock()) return false;
+            if constexpr (Diagnostics_Enabled) Increase(acquisitions, 1);
+            return true;
+        }
+
+        void unlock() { mutex.unlock(); }
+
+        std::atomic<std::uint64_t> acquisitions;
+        std::atomic<std::uint64_t> contentions;
+        std::atomic<std::uint64_t> wait_time;
+
+    protected:
+        static void Increase(std::atomic<std::uint64_t> &counter,
+                             std::uint64_t value)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value,
+                          std::memory_order_relaxed);
+        }
+
+        std::mutex mutex;
+};
+
+// Lock protecting the pool for a single descriptor, placed on its own cache
+// line so that threads using different descriptors do not contend
+struct alignas(Allocation_Alignment) PoolLock
+{
+    PoolMutex mutex;
+};
+
+// One of several free lists for a striped descriptor, each with its own
+// lock; like a thread cache, its blocks are held apart from the shared pool
+struct alignas(Allocation_Alignment) PoolStripe
+{
+    PoolMutex mutex;
+    ThreadCache cache;
+};
+
+// Requests waiting for a block of a single descriptor, held in FIFO order and
+// protected by the descriptor's pool lock; the count is read on every Free()
+// and so is placed on its own cache line
+struct alignas(Allocation_Alignment) WaitQueue
+{
+    std::atomic<std::size_t> waiting;           // Requests waiting
+    AllocationWaiter *head;                     // Longest waiting request
+    AllocationWaiter *tail;                     // Most recent request
+};
+
+#ifdef _MSC_VER
+    #pragma warning(pop)
+#endif
+
+// Blocks freed by threads other than the thread that allocated them, held
+// on a lock-free stack per descriptor until the allocating thread collects
+// them; the stacks are linked through the block headers.  The queue is
+// orphaned once every thread using it has exited.
+struct RemoteQueue
+{
+    std::vector<std::atomic<std::uint8_t *>> heads;
+    std::atomic<std::size_t> users;
+};
+
+// Object shared by a Memory Manager and the threads caching its blocks
+struct ThreadCacheRegistry
+{
+    void Release(ThreadCache *cache);
+
+    std::mutex mutex;
+    MemoryManager *owner;
+};
+
+// State of the thread that replenishes and trims pools in the background
+struct Replenisher
+{
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::atomic<bool> pending;                  // Pools require maintenance
+    bool stop;                                  // Thread should exit
+};
+
+// Most recently observed state of a single descriptor's pool, used to
+// determine how long the pool has been idle; the number of times blocks are
+// taken from the pool is counted even when statistics are not collected, so
+// a pool in steady use is never mistaken for an idle one.  Protected by the
+// descriptor's pool lock.
+struct PoolActivity
+{
+    std::uint64_t takes;                        // Times blocks were taken
+    std::uint64_t observed_takes;               // Takes when last observed
+    std::size_t count;                          // Free blocks in the pool
+    std::size_t held;                           // Blocks held outside
+    std::chrono::steady_clock::time_point since;// When the state was seen
+};
+
+namespace
+{
+
+// Associates a thread's cache with the owning Memory Manager's registry
+struct ThreadCacheEntry
+{
+    std::shared_ptr<ThreadCacheRegistry> registry;
+    std::unique_ptr<ThreadCache> cache;
+};
+
+// The set of caches held by a thread, released when the thread exits
+struct ThreadCacheSet
+{
+    ThreadCacheSet() = default;
+    ThreadCacheSet(const ThreadCacheSet &other) = delete;
+    ThreadCacheSet(const ThreadCacheSet &&other) = delete;
+    ~ThreadCacheSet()
+    {
+        for (auto &entry : entries) entry.registry->Release(entry.cache.get());
+    }
+
+    ThreadCacheSet &operator=(const ThreadCacheSet &other) = delete;
+    ThreadCacheSet &operator=(const ThreadCacheSet &&other) = delete;
+
+    std::vector<ThreadCacheEntry> entries;
+};
+
+thread_local ThreadCacheSet Thread_Caches;
+
+// Number of threads that have used a striped descriptor
+std::atomic<std::size_t> Stripe_Threads = 0;
+
+// Number assigned to the calling thread so that threads use stripes in turn
+thread_local const std::size_t Stripe_Thread =
+    Stripe_Threads.fetch_add(1, std::memory_order_relaxed);
+
+} // namespace
+
+/*
+ *  ThreadCacheRegistry::Release()
+ *
+ *  Description:
+ *      Return the blocks held by a thread's cache to the owning Memory
+ *      Manager, if that Memory Manager still exists.
+ *
+ *  Parameters:
+ *      cache [in]
+ *          The thread cache being released.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This is called when a thread exits.
+ */
+void ThreadCacheRegistry::Release(ThreadCache *cache)
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+
+    if (owner != nullptr) owner->ReleaseThreadCache(cache);
+}
+
+/*
+ *  MemoryManager::MemoryManager()
+ *
+ *  Description:
+ *      Constructor for the MemoryManager object.
+ *
+ *  Parameters:
+ *      profile [in]
+ *          The memory profile that contains a vector of MemoryDescriptor
+ *          structures that will be used by the Memory Manager.
+ *
+ *      parent_logger [in]
+ *          An optional Logger object to which logging output will be directed.
+ *
+ *      log_statistics [in]
+ *          Log usage statistics on destruction.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+MemoryManager::MemoryManager(MemoryProfile profile,
+                             const Logger::LoggerPointer &parent_logger,
+                             bool log_statistics) :
+    MemoryManager(std::move(profile), {}, parent_logger, log_statistics)
+{
+}
+
+/*
+ *  MemoryManager::MemoryManager()
+ *
+ *  Description:
+ *      Constructor for the MemoryManager object.
+ *
+ *  Parameters:
+ *      profile [in]
+ *          The memory profile that contains a vector of MemoryDescriptor
+ *          structures that will be used by the Memory Manager.
+ *
+ *      options [in]
+ *          Options that control the behavior of the Memory Manager.
+ *
+ *      parent_logger [in]
+ *          An optional Logger object to which logging output will be directed.
+ *
+ *      log_statistics [in]
+ *          Log usage statistics on destruction.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+MemoryManager::MemoryManager(MemoryProfile profile,
+                             const ManagerOptions &options,
+                             const Logger::LoggerPointer &parent_logger,
+                             bool log_statistics) :
+    MemoryManager(std::move(profile),
+                  options,
+                  parent_logger,
+                  log_statistics,
+                  No_Node)
+{
+}
+
+/*
+ *  MemoryManager::MemoryManager()
+ *
+ *  Description:
+ *      Constructor for the MemoryManager object.
+ *
+ *  Parameters:
+ *      profile [in]
+ *          The memory profile that contains a vector of MemoryDescriptor
+ *          structures that will be used by the Memory Manager.
+ *
+ *      options [in]
+ *          Options that control the behavior of the Memory Manager.
+ *
+ *      parent_logger [in]
+ *          An optional Logger object to which logging output will be directed.
+ *
+ *      log_statistics [in]
+ *          Log usage statistics on destruction.
+ *
+ *      numa_node [in]
+ *          The NUMA node whose memory this object manages or No_Node if
+ *          this object is not bound to a particular node.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      When the numa option is given, this object creates a Memory Manager
+ *      for each NUMA node and directs requests to them.
+ */
+MemoryManager::MemoryManager(MemoryProfile profile,
+                             const ManagerOptions &options,
+                             const Logger::LoggerPointer &parent_logger,
+                             bool log_statistics,
+                             std::size_t numa_node) :
+    profile{std::move(profile)},
+    options{options},
+    logger{std::make_shared<Logger::Logger>(parent_logger, "MMGR")},
+    log_statistics{log_statistics},
+    numa_node{numa_node},
+    next_remote_queue{0}
+{
+    // Create a Memory Manager for each NUMA node, if requested
+    if (this->options.numa)
+    {
+        const std::size_t node_count = NumaNodeCount();
+
+        logger->info << "Creating memory pools for " << node_count
+                     << " NUMA node(s)" << std::flush;
+
+        ManagerOptions node_options = this->options;
+        node_options.numa = false;
+        nodes.reserve(node_count);
+        for (std::size_t node = 0; node < node_count; node++)
+        {
+            // The constructor is protected, so std::make_unique cannot be
+            // used; the reserve above ensures emplace_back() will not throw
+            // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+            nodes.emplace_back(new MemoryManager(this->profile,
+                                                 node_options,
+                                                 logger,
+                                                 log_statistics,
+                                                 node));
+        }
+
+        // Record this object's existence so that FreeAny() may locate it
+        RegisterManager(this);
+
+        return;
+    }
+
+    logger->info << "Initializing memory profiles" << std::flush;
+
+    // The lock-free engine does not use thread caches
+    if (this->options.lock_free && this->options.thread_cache)
+    {
+        logger->warning << "Thread caches are not used with the lock-free "
+                           "engine" << std::flush;
+        this->options.thread_cache = false;
+    }
+
+    // The lock-free engine does not use background replenishment
+    if (this->options.lock_free && this->options.replenish)
+    {
+        logger->warning << "Background replenishment is not used with the "
+                           "lock-free engine" << std::flush;
+        this->options.replenish = false;
+    }
+
+    // The lock-free engine retains its blocks, so none are released when idle
+    if (this->options.lock_free && (this->options.decay_time.count() > 0))
+    {
+        logger->warning << "Idle pools are not released with the lock-free "
+                           "engine" << std::flush;
+        this->options.decay_time = {};
+    }
+
+    // The lock-free engine takes its blocks from the pools once, when
+    // constructed
+    if (this->options.lock_free &&
+        (this->options.preallocation != PreallocationPolicy::Eager))
+    {
+        logger->warning << "Deferred pre-allocation is not used with the "
+                           "lock-free engine" << std::flush;
+        this->options.preallocation = PreallocationPolicy::Eager;
+    }
+
+    // The lock-free engine reads descriptor limits without locking
+    if (this->options.lock_free && this->options.adaptive)
+    {
+        logger->warning << "Adaptive tuning is not used with the lock-free "
+                           "engine" << std::flush;
+        this->options.adaptive = false;
+    }
+
+    // The index within a compact header is limited to 16 bits
+    if (this->options.compact_headers &&
+        (this->profile.size() > std::numeric_limits<std::uint16_t>::max()))
+    {
+        logger->warning << "Too many descriptors to use compact headers"
+                        << std::flush;
+        this->options.compact_headers = false;
+    }
+
+    // Not validating blocks is the same as the release validation policy
+    if (!this->options.validate_blocks)
+    {
+        this->options.validation = ValidationPolicy::Release;
+    }
+
+    // Guarded blocks cannot reside in slabs, which compact headers require
+    if ((this->options.validation == ValidationPolicy::Debug) &&
+        this->options.compact_headers)
+    {
+        logger->warning << "Debug validation is not used with compact "
+                           "headers" << std::flush;
+        this->options.validation = ValidationPolicy::Full;
+    }
+
+    // Ensure the watermarks used by thread caches and stripes are sensible
+    if (this->options.cache_low_watermark == 0)
+    {
+        this->options.cache_low_watermark = 1;
+    }
+    if (this->options.cache_high_watermark < this->options.cache_low_watermark)
+    {
+        logger->warning << "Thread cache high watermark is less than the "
+                           "low watermark" << std::flush;
+        this->options.cache_high_watermark = this->options.cache_low_watermark;
+    }
+
+    // Create the registry through which thread caches are reclaimed
+    if (this->options.thread_cache)
+    {
+        cache_registry = std::make_shared<ThreadCacheRegistry>();
+        cache_registry->owner = this;
+    }
+
+    // Remote frees require thread caches and the owner in the block header
+    if (this->options.remote_free &&
+        (!this->options.thread_cache || this->options.compact_headers))
+    {
+        logger->warning << "Remote frees require thread caches and standard "
+                           "headers" << std::flush;
+        this->options.remote_free = false;
+    }
+
+    // Create the queues onto which other threads place freed blocks
+    if (this->options.remote_free)
+    {
+        remote_queues = std::vector<RemoteQueue>(Remote_Queue_Count);
+        for (auto &queue : remote_queues)
+        {
+            queue.heads = std::vector<std::atomic<std::uint8_t *>>(
+                this->profile.size());
+        }
+    }
+
+    // Sort the profile deque according to size
+    std::ranges::sort(
+        this->profile,
+        [](const MemoryDescriptor &a, const MemoryDescriptor &b) -> bool
+        { return a.size < b.size; });
+
+    // Create zero-initialized statistics counters for each profile entry
+    statistics = std::vector<StatisticsCounters>(this->profile.size());
+
+    // Create zero-initialized diagnostic counters, if collected
+    if constexpr (Diagnostics_Enabled)
+    {
+        diagnostics = std::vector<DiagnosticCounters>(this->profile.size());
+    }
+
+    // Create the lock for each descriptor's pool
+    pool_locks = std::vector<PoolLock>(this->profile.size());
+
+    // Create the queue of waiting requests for each descriptor
+    wait_queues = std::vector<WaitQueue>(this->profile.size());
+
+    // Create the count of outstanding spilled blocks for each descriptor
+    spill_outstanding =
+        std::vector<std::atomic<std::size_t>>(this->profile.size());
+
+    // Allocate memory
+    for (std::size_t index = 0; index < this->profile.size(); index++)
+    {
+        // If maximum is less than minumum, make them equal
+        if ((this->profile[index].maximum != 0) &&
+            (this->profile[index].maximum < this->profile[index].minimum))
+        {
+            logger->warning << "Descriptor size " << this->profile[index].size
+                            << " has an invalid maximum value" << std::flush;
+            this->profile[index].maximum = this->profile[index].minimum;
+        }
+
+        // Alignment values must be a power of two
+        if ((this->profile[index].alignment != 0) &&
+            !std::has_single_bit(this->profile[index].alignment))
+        {
+            logger->warning << "Descriptor size " << this->profile[index].size
+                            << " has an invalid alignment value" << std::flush;
+            this->profile[index].alignment = 0;
+        }
+
+        // Spilled blocks are marked in the header to enforce a spill budget,
+        // which compact headers have no room to hold
+        if ((this->profile[index].spill == SpillPolicy::Budget) &&
+            this->options.compact_headers)
+        {
+            logger->warning << "Descriptor size " << this->profile[index].size
+                            << " cannot use a spill budget with compact "
+                               "headers"
+                            << std::flush;
+            this->profile[index].spill = SpillPolicy::Never;
+        }
+
+        // Determine how blocks for this descriptor are arranged in memory
+        layouts.emplace_back(MakeLayout(
+            this->profile[index],
+            this->options.compact_headers,
+            this->options.validation != ValidationPolicy::Release));
+
+        // Slabs for a NUMA node are page-aligned so they may be placed in
+        // memory local to the node
+        if (numa_node != No_Node)
+        {
+            layouts.back().slab_alignment =
+                std::max(layouts.back().alignment, PageSize());
+        }
+
+#ifndef __linux__
+        // Mapped memory is only supported on Linux
+        if (this->profile[index].source != MemorySource::Heap)
+        {
+            logger->warning << "Descriptor size " << this->profile[index].size
+                            << " will use heap memory for slabs"
+                            << std::flush;
+            this->profile[index].source = MemorySource::Heap;
+        }
+#endif
+
+        // With compact headers, blocks reside in slabs, as do pre-allocated
+        // blocks for a NUMA node and blocks using mapped memory; use a
+        // default size if the number of blocks per slab is not specified
+        if ((this->options.compact_headers || (numa_node != No_Node) ||
+             (this->profile[index].source != MemorySource::Heap)) &&
+            (this->profile[index].slab_blocks == 0))
+        {
+            const BlockLayout &layout = layouts.back();
+            const std::size_t slab_size =
+                (this->profile[index].source == MemorySource::HugePages) ?
+                    HugePageSize() :
+                    Default_Slab_Size;
+            this->profile[index].slab_blocks =
+                std::max(std::size_t{1},
+                         (layout.slab_offset < slab_size) ?
+                             ((slab_size - layout.slab_offset) /
+                              layout.stride) :
+                             0);
+        }
+
+        // When debugging, each block is placed before its own guard page
+        // (on Linux, and if the alignment permits) and so not within a slab
+        if ((this->options.validation == ValidationPolicy::Debug) &&
+            (layouts.back().alignment <= PageSize()))
+        {
+#ifdef __linux__
+            layouts.back().guarded = true;
+            this->profile[index].slab_blocks = 0;
+#endif
+        }
+
+        // Limit slabs so the offset to each compact header is representable
+        if (this->options.compact_headers)
+        {
+            const BlockLayout &layout = layouts.back();
+            const std::size_t offset_limit =
+                std::numeric_limits<std::uint32_t>::max() - layout.slab_offset -
+                layout.header_space;
+            this->profile[index].slab_blocks =
+                std::clamp(this->profile[index].slab_blocks,
+                           std::size_t{1},
+                           (offset_limit / layout.stride) + 1);
+        }
+
+        // Create an empty free list
+        allocations.emplace_back();
+
+        // No blocks are initially held outside of the pool
+        held.emplace_back(0);
+        held_peak.emplace_back(0);
+
+        // Stripes hold blocks in the same way as thread caches, so they are
+        // not used with thread caches or the lock-free engine
+        stripes.emplace_back();
+        if ((this->profile[index].stripes > 1) &&
+            (this->options.thread_cache || this->options.lock_free))
+        {
+            logger->warning << "Descriptor size " << this->profile[index].size
+                            << " will not be striped" << std::flush;
+            this->profile[index].stripes = 0;
+        }
+        if (this->profile[index].stripes > 1)
+        {
+            stripes[index] =
+                std::vector<PoolStripe>(this->profile[index].stripes);
+            for (PoolStripe &stripe : stripes[index])
+            {
+                stripe.cache.blocks.resize(this->profile.size());
+                stripe.cache.blocks[index].reserve(
+                    this->options.cache_high_watermark + 1);
+                stripe.cache.counters =
+                    std::vector<ThreadCacheCounters>(this->profile.size());
+            }
+        }
+
+        logger->info << "Descriptor size " << this->profile[index].size
+                     << ", count " << this->profile[index].minimum
+                     << std::flush;
+
+        // Create an empty list of slabs
+        slabs.emplace_back();
+
+        // If deferring pre-allocation, reserve a slab for the minimum number
+        // of blocks (mapped so that its pages are not touched) from which
+        // blocks are carved later
+        reserves.emplace_back();
+        if ((this->options.preallocation != PreallocationPolicy::Eager) &&
+            (this->profile[index].minimum > 0) && !layouts.back().guarded)
+        {
+            const BlockLayout &layout = layouts.back();
+            std::size_t count = this->profile[index].minimum;
+            MemorySource source = this->profile[index].source;
+#ifdef __linux__
+            if (source == MemorySource::Heap) source = MemorySource::Pages;
+#endif
+            if (this->options.compact_headers)
+            {
+                const std::size_t offset_limit =
+                    std::numeric_limits<std::uint32_t>::max() -
+                    layout.slab_offset - layout.header_space;
+                count = std::min(count, (offset_limit / layout.stride) + 1);
+            }
+            std::uint8_t *slab = CreateSlab(index, count, source);
+            if (slab != nullptr)
+            {
+                reserves[index] = {slab, 0, count};
+                continue;
+            }
+        }
+
+        // Allocate the requested number of blocks, using slabs if requested
+        if (this->profile[index].slab_blocks > 0)
+        {
+            while (allocations[index].count < this->profile[index].minimum)
+            {
+                const std::size_t count =
+                    std::min(this->profile[index].slab_blocks,
+                             this->profile[index].minimum -
+                                 allocations[index].count);
+                if (!PerformSlabAllocation(index, count)) break;
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < this->profile[index].minimum; i++)
+            {
+                PerformAllocation(index);
+            }
+        }
+    }
+
+    // Move pre-allocated blocks onto the lock-free stacks, if used
+    if (this->options.lock_free)
+    {
+        lock_free_buckets = std::vector<LockFreeBucket>(this->profile.size());
+        for (std::size_t index = 0; index < this->profile.size(); index++)
+        {
+            lock_free_buckets[index].total = allocations[index].count;
+            lock_free_buckets[index].pooled = allocations[index].count;
+            while (std::uint8_t *block =
+                       PopListBlock(allocations[index], index))
+            {
+                SetPooled(index, block);
+                PushFreeBlock(index, block);
+            }
+        }
+    }
+
+    // Map each size class to the first descriptor that might satisfy it
+    size_classes.resize(Size_Class_Count);
+    std::size_t index = 0;
+    for (std::size_t size_class = 0; size_class < Size_Class_Count;
+         size_class++)
+    {
+        while ((index < this->profile.size()) &&
+               (SizeClass(this->profile[index].size) < size_class))
+        {
+            index++;
+        }
+        size_classes[size_class] = index;
+    }
+
+    // Note the initial state of each pool, from which idle time is measured
+    activity = std::vector<PoolActivity>(this->profile.size());
+    for (std::size_t index = 0; index < this->profile.size(); index++)
+    {
+        activity[index].count = allocations[index].count;
+        activity[index].since = std::chrono::steady_clock::now();
+    }
+
+    // Record this object's existence so that FreeAny() may locate it; this
+    // is done once nothing but starting the thread below remains that might
+    // fail, so that a failed construction leaves no trace in the registry
+    RegisterManager(this);
+
+    // Start the thread that maintains the pools, if requested
+    if (this->options.replenish || (this->options.decay_time.count() > 0) ||
+        (this->options.preallocation == PreallocationPolicy::Background))
+    {
+        try
+        {
+            replenisher = std::make_unique<Replenisher>();
+            replenisher->pending = this->options.replenish;
+            replenisher->stop = false;
+            replenisher->thread =
+                std::thread(&MemoryManager::RunReplenisher, this);
+        }
+        catch (...)
+        {
+            UnregisterManager(this);
+            throw;
+        }
+    }
+}
+
+/*
+ *  MemoryManager::~MemoryManager()
+ *
+ *  Description:
+ *      Allocate a block of memory for the given profile index.
+ *
+ *  Parameters:
+ *      Nome.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The mutex MUST be locked by the calling function.
+ */
+MemoryManager::~MemoryManager()
+{
+    // Blocks freed using FreeAny() must no longer be directed to this object;
+    // this waits for any such blocks being freed now
+    UnregisterManager(this);
+
+    // Stop the thread that maintains the pools
+    if (replenisher)
+    {
+        {
+            const std::lock_guard<std::mutex> lock(replenisher->mutex);
+            replenisher->stop = true;
+        }
+        replenisher->condition.notify_one();
+        replenisher->thread.join();
+    }
+
+    // Each NUMA node's Memory Manager releases its own memory
+    if (!nodes.empty()) return;
+
+    // Requests must not be waiting while the Memory Manager is destroyed
+    for (const WaitQueue &queue : wait_queues)
+    {
+        if (queue.head != nullptr)
+        {
+            logger->error << "Memory Manager destroyed while requests are "
+                             "waiting for memory"
+                          << std::flush;
+            break;
+        }
+    }
+
+    // Reclaim any blocks held in stripes
+    for (std::size_t index = 0; index < profile.size(); index++)
+    {
+        for (PoolStripe &stripe : stripes[index])
+        {
+            FoldThreadCounters(stripe.cache, index);
+            for (std::uint8_t *block : stripe.cache.blocks[index])
+            {
+                DeleteBlock(index, block);
+            }
+            stripe.cache.blocks[index].clear();
+        }
+    }
+
+    // Reclaim any blocks held in thread caches and detach from those threads
+    if (cache_registry)
+    {
+        const std::lock_guard<std::mutex> registry_lock(cache_registry->mutex);
+
+        for (ThreadCache *cache : thread_caches)
+        {
+            for (std::size_t index = 0; index < profile.size(); index++)
+            {
+                FoldThreadCounters(*cache, index);
+                for (std::uint8_t *block : cache->blocks[index])
+                {
+                    DeleteBlock(index, block);
+                }
+                cache->blocks[index].clear();
+            }
+        }
+        thread_caches.clear();
+        cache_registry->owner = nullptr;
+    }
+
+    // Reclaim any blocks freed remotely but not yet collected
+    for (auto &queue : remote_queues)
+    {
+        for (std::size_t index = 0; index < profile.size(); index++)
+        {
+            std::uint8_t *block = queue.heads[index].exchange(nullptr);
+            while (block != nullptr)
+            {
+                std::uint8_t *next = *GetNextLink(index, block);
+                DeleteBlock(index, block);
+                block = next;
+            }
+        }
+    }
+
+    // Return blocks held by the lock-free engine to the pool for deletion
+    if (options.lock_free)
+    {
+        for (std::size_t index = 0; index < profile.size(); index++)
+        {
+            while (std::uint8_t *block = PopFreeBlock(index))
+            {
+                PushListBlock(allocations[index], index, block);
+            }
+        }
+        for (auto [index, block] : quarantine) DeleteBlock(index, block);
+        quarantine.clear();
+    }
+
+    // Get the final statistics
+    const std::vector<Statistics> final_statistics = GetStatistics();
+
+    logger->info << "Memory Manager Usage Statistics" << std::flush;
+
+    // Iterate over each descriptor in the profile
+    for (std::size_t index = 0; index < profile.size(); index++)
+    {
+        if (log_statistics)
+        {
+            logger->info << "  Block size: " << profile[index].size
+                         << std::flush;
+            logger->info << "    Allocations: "
+                         << final_statistics[index].allocations << std::flush;
+            logger->info << "    Deallocations: "
+                         << final_statistics[index].deallocations
+                         << std::flush;
+            logger->info << "    Corrupted: "
+                         << final_statistics[index].corruption_count
+                         << std::flush;
+            logger->info << "    Max Outstanding: "
+                         << final_statistics[index].max_outstanding
+                         << std::flush;
+            logger->info << "    Outstanding: "
+                         << final_statistics[index].outstanding << std::flush;
+            logger->info << "    Unfulfilled: "
+                         << final_statistics[index].unfulfilled << std::flush;
+            logger->info << "    Spilled: "
+                         << final_statistics[index].spilled << std::flush;
+        }
+
+        // Free all allocated memory in the pool
+        while (std::uint8_t *block = PopListBlock(allocations[index], index))
+        {
+            DeleteBlock(index, block);
+        }
+
+        // Free all slabs, which releases the blocks they contain
+        ReleaseSlabs(index, slabs[index]);
+        slabs[index].clear();
+    }
+}
+
+/*
+ *  MemoryManager::Allocate()
+ *
+ *  Description:
+ *      This function will allocate memory of the requested size.  It does this
+ *      by searching through the MemoryProfile looking for a descriptor that
+ *      is for memory blocks large enough to satisfy the request.  It will then
+ *      return a block from that part of the profile, if the request can be
+ *      satisfied.  If it cannot, it will move to the next (larger) descriptor
+ *      and attempt the request again.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The size of the memory requested.
+ *
+ *  Returns:
+ *      A pointer to a block of memory the user may use or nullptr if the
+ *      request could not be satisfied.
+ *
+ *  Comments:
+ *      None.
+ */
+void *MemoryManager::Allocate(std::size_t size)
+{
+    return Allocate(size, 0);
+}
+
+/*
+ *  MemoryManager::Allocate()
+ *
+ *  Description:
+ *      This function will allocate memory of the requested size and
+ *      alignment, just as Allocate() above, using only descriptors whose
+ *      blocks are aligned at least as strictly as requested.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The size of the memory requested.
+ *
+ *      alignment [in]
+ *          The required alignment of the memory, which must be a power of
+ *          two (or 0 if no particular alignment is required).
+ *
+ *  Returns:
+ *      A pointer to a block of memory the user may use or nullptr if the
+ *      request could not be satisfied.
+ *
+ *  Comments:
+ *      None.
+ */
+void *MemoryManager::Allocate(std::size_t size, std::size_t alignment)
+{
+    // Alignment values must be a power of two
+    if ((alignment != 0) && !std::has_single_bit(alignment)) return nullptr;
+
+    // Satisfy the request from the pools for the current NUMA node, if used
+    if (!nodes.empty())
+    {
+        return nodes[std::min(CurrentNumaNode(), nodes.size() - 1)]->Allocate(
+            size,
+            alignment);
+    }
+
+    // Time the request when collecting diagnostics
+    LatencyTimer timer;
+    if constexpr (Diagnostics_Enabled)
+    {
+        const std::size_t requested = FindDescriptor(size);
+        if (requested < profile.size())
+        {
+            timer.Attach(diagnostics[requested].allocate_latency);
+        }
+    }
+
+    // Satisfy the request from the thread cache, if enabled
+    if (options.thread_cache) return CacheAllocate(size, alignment);
+
+    // Satisfy the request using the lock-free engine, if enabled
+    if (options.lock_free) return LockFreeAllocate(size, alignment);
+
+    // Iterate over each descriptor in the profile for available memory,
+    // starting with the first that might be large enough
+    std::size_t first = profile.size();
+    std::size_t spills = 0;
+    for (std::size_t index = size_classes[SizeClass(size)];
+         index < profile.size();
+         index++)
+    {
+        // If the descriptor indicates memory is too small or insufficiently
+        // aligned, keep looking
+        if ((profile[index].size < size) ||
+            (layouts[index].alignment < alignment))
+        {
+            continue;
+        }
+
+        // Use a larger descriptor only as the first descriptor's policy allows
+        if (first == profile.size())
+        {
+            first = index;
+        }
+        else if (SpillAllowance(first, ++spills) == 0)
+        {
+            break;
+        }
+
+        // Satisfy the request from the calling thread's stripe, if striped
+        if (!stripes[index].empty())
+        {
+            std::uint8_t *block = StripeAllocate(index);
+            if (block == nullptr) continue;
+            if (index != first) RecordSpill(first, index, block);
+
+            return GetDataPointer(layouts[index], block);
+        }
+
+        // Lock the descriptor's pool
+        const std::lock_guard<PoolMutex> lock(pool_locks[index].mutex);
+
+        // If no memory block can be taken from the pool, keep looking
+        std::uint8_t *block = TakePoolBlock(index);
+        if (block == nullptr) continue;
+        if (index != first) RecordSpill(first, index, block);
+
+        // Return a pointer to the data just after the MemoryHeader
+        return GetDataPointer(layouts[index], block);
+    }
+
+    return nullptr;
+}
+
+/*
+ *  MemoryManager::Free()
+ *
+ *  Description:
+ *      This function will free a block of memory.  Internally, the pointer
+ *      will just be returned to the vector of allocated memory blocks.
+ *      If, however, the vector of pointers exceed the maximum number then
+ *      the block will be freed to the heap.
+ *
+ *  Parameters:
+ *      p [in]
+ *          Pointer to a block of memory provided by Allocate().
+ *
+ *  Returns:
+ *      True if memory is freed, false if not.  The only reason false will
+ *      be returned is if the pointer given does not belong to this Memory
+ *      Manager.  This could happen if memory is corrupted.
+ *
+ *  Comments:
+ *      It is important that the pointer provided actually be allocated by
+ *      the Memory Manager, else this function might cause an access violation
+ *      or memory leak.
+ */
+bool MemoryManager::Free(void *p)
+{
+    return Free(p, 0);
+}
+
+/*
+ *  MemoryManager::Free()
+ *
+ *  Description:
+ *      This function will free a block of memory, just as Free() above, when
+ *      the size of the memory requested from Allocate() is known.
+ *
+ *  Parameters:
+ *      p [in]
+ *          Pointer to a block of memory provided by Allocate().
+ *
+ *      size [in]
+ *          The size of the memory requested when calling Allocate().
+ *
+ *  Returns:
+ *      True if memory is freed, false if not.  The only reason false will
+ *      be returned is if the pointer given does not belong to this Memory
+ *      Manager.  This could happen if memory is corrupted.
+ *
+ *  Comments:
+ *      When blocks are validated, a size larger than the block indicates the
+ *      caller may have written beyond the end of the block, so the block is
+ *      treated as corrupt.  With ValidationPolicy::Release, the size is not
+ *      checked.
+ */
+bool MemoryManager::Free(void *p, std::size_t size)
+{
+    std::uint8_t *block = nullptr;
+    std::size_t index = 0;
+
+    // Return the block to the pools for the NUMA node that allocated it
+    if (!nodes.empty())
+    {
+        if (p == nullptr) return RejectBlock(BlockStatus::Invalid);
+
+        MemoryManager *owner = LocateOwner(p);
+        for (const auto &node : nodes)
+        {
+            if (node.get() == owner) return node->Free(p, size);
+        }
+
+        return RejectBlock(BlockStatus::Foreign);
+    }
+
+    // Time the request when collecting diagnostics
+    LatencyTimer timer;
+
+    // Ensure that the memory block is valid and belongs to this object
+    BlockStatus status = LocateBlock(p, block, index);
+    if ((status != BlockStatus::Valid) && (status != BlockStatus::Corrupt))
+    {
+        return RejectBlock(status);
+    }
+    if constexpr (Diagnostics_Enabled)
+    {
+        timer.Attach(diagnostics[index].free_latency);
+    }
+
+    // Ensure the block is large enough for the given size
+    if ((status == BlockStatus::Valid) &&
+        (options.validation != ValidationPolicy::Release) &&
+        (size > profile[index].size))
+    {
+        logger->error << "Free request made with a size larger than the "
+                         "memory block"
+                      << std::flush;
+        status = BlockStatus::Corrupt;
+    }
+
+    // Take note of the block condition
+    const bool bad_block = (status == BlockStatus::Corrupt);
+
+    // Return any spill budget used by the block
+    ReleaseSpill(index, block);
+
+    // Mark the freed user data when debugging
+    PoisonBlock(index, block);
+
+    if (options.thread_cache)
+    {
+        // Return the block to the thread cache
+        CacheFree(block, index, bad_block);
+    }
+    else if (options.lock_free)
+    {
+        // Return the block using the lock-free engine
+        LockFreeFree(block, index, bad_block);
+    }
+    else if (!stripes[index].empty())
+    {
+        // Return the block to the calling thread's stripe
+        StripeFree(block, index, bad_block);
+    }
+    else
+    {
+        // Lock the descriptor's pool
+        const std::lock_guard<PoolMutex> lock(pool_locks[index].mutex);
+
+        // Return the block to the pool or the heap
+        FreeBlock(index, block, bad_block);
+    }
+    timer.Record();
+
+    // Hand the block to a request waiting for it, if any
+    ServeWaiters(index);
+
+    return true;
+}
+
+/*
+ *  MemoryManager::AllocateWait()
+ *
+ *  Description:
+ *      This function will allocate memory of the requested size, just as
+ *      Allocate(), except that if the request cannot be satisfied the calling
+ *      thread will wait until a block is freed.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The size of the memory requested.
+ *
+ *  Returns:
+ *      A pointer to a block of memory the user may use or nullptr if no
+ *      descriptor in the profile is large enough for the request.
+ *
+ *  Comments:
+ *      None.
+ */
+void *MemoryManager::AllocateWait(std::size_t size)
+{
+    return AllocateWait(size, std::chrono::nanoseconds::max());
+}
+
+/*
+ *  MemoryManager::AllocateWait()
+ *
+ *  Description:
+ *      This function will allocate memory of the requested size, just as
+ *      Allocate(), except that if the request cannot be satisfied the calling
+ *      thread will wait up to the given timeout for a block to be freed.
+ *      Waiting requests are served in the order in which they began waiting.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The size of the memory requested.
+ *
+ *      timeout [in]
+ *          The maximum time to wait for a block to be freed.
+ *
+ *  Returns:
+ *      A pointer to a block of memory the user may use or nullptr if the
+ *      request could not be satisfied within the timeout.
+ *
+ *  Comments:
+ *      The request waits for a block of the first descriptor large enough
+ *      to satisfy it.
+ */
+void *MemoryManager::AllocateWait(std::size_t size,
+                                  std::chrono::nanoseconds timeout)
+{
+    // Satisfy the request from the pools for the current NUMA node, if used
+    if (!nodes.empty())
+    {
+        return nodes[std::min(CurrentNumaNode(), nodes.size() - 1)]
+            ->AllocateWait(size, timeout);
+    }
+
+    // Return immediately if the request can be satisfied
+    void *p = Allocate(size);
+    if ((p != nullptr) || (timeout <= std::chrono::nanoseconds::zero()))
+    {
+        return p;
+    }
+
+    // Place the request in the queue, unless a block is now available
+    std::binary_semaphore semaphore(0);
+    AllocationWaiter waiter{};
+    waiter.semaphore = &semaphore;
+    if (!EnqueueWaiter(waiter, size)) return waiter.block;
+
+    // Wait for the request to be served
+    if (timeout == std::chrono::nanoseconds::max())
+    {
+        semaphore.acquire();
+        return waiter.block;
+    }
+    if (semaphore.try_acquire_for(timeout)) return waiter.block;
+
+    // If the request was served as the wait ended, await the notification
+    if (!WithdrawWaiter(waiter)) semaphore.acquire();
+
+    return waiter.block;
+}
+
+/*
+ *  MemoryManager::AllocateAsync()
+ *
+ *  Description:
+ *      This function returns an object that a coroutine may co_await to
+ *      allocate memory of the requested size.  If the request cannot be
+ *      satisfied, the coroutine is suspended until a block is freed.
+ *      Waiting requests are served in the order in which they began waiting.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The size of the memory requested.
+ *
+ *  Returns:
+ *      An awaitable object whose result is a pointer to a block of memory the
+ *      user may use or nullptr if no descriptor in the profile is large
+ *      enough for the request.
+ *
+ *  Comments:
+ *      A suspended coroutine is resumed by the thread calling Free().  The
+ *      request waits for a block of the first descriptor large enough to
+ *      satisfy it.
+ */
+AllocateAwaitable MemoryManager::AllocateAsync(std::size_t size)
+{
+    // Satisfy the request from the pools for the current NUMA node, if used
+    if (!nodes.empty())
+    {
+        return nodes[std::min(CurrentNumaNode(), nodes.size() - 1)]
+            ->AllocateAsync(size);
+    }
+
+    return AllocateAwaitable(*this, size);
+}
+
+/*
+ *  MemoryManager::Reallocate()
+ *
+ *  Description:
+ *      This function will change the size of a block of memory provided by
+ *      Allocate().  If the block is large enough to hold the new size, it is
+ *      returned unchanged.  Otherwise, a block is allocated in the same
+ *      manner as Allocate(), the contents of the original block are copied
+ *      into it, and the original block is freed.
+ *
+ *  Parameters:
+ *      p [in]
+ *          Pointer to a block of memory provided by Allocate(), or nullptr
+ *          to allocate a new block.
+ *
+ *      size [in]
+ *          The size of the memory now required.
+ *
+ *  Returns:
+ *      A pointer to a block of memory holding the original contents or
+ *      nullptr if the request could not be satisfied, in which case the
+ *      original block remains valid.
+ *
+ *  Comments:
+ *      Reducing the size never moves the block.
+ */
+void *MemoryManager::Reallocate(void *p, std::size_t size)
+{
+    return Reallocate(p, size, 0);
+}
+
+/*
+ *  MemoryManager::Reallocate()
+ *
+ *  Description:
+ *      This function will change the size of a block of memory, just as
+ *      Reallocate() above, ensuring the block is aligned at least as strictly
+ *      as requested.
+ *
+ *  Parameters:
+ *      p [in]
+ *          Pointer to a block of memory provided by Allocate(), or nullptr
+ *          to allocate a new block.
+ *
+ *      size [in]
+ *          The size of the memory now required.
+ *
+ *      alignment [in]
+ *          The required alignment of the memory (or 0 if none), which must be
+ *          a power of two.
+ *
+ *  Returns:
+ *      A pointer to a block of memory holding the original contents or
+ *      nullptr if the request could not be satisfied, in which case the
+ *      original block remains valid.
+ *
+ *  Comments:
+ *      When the block must move, the new block is taken and the original
+ *      block returned while holding the locks of both pools, so the move
+ *      requires only one lock acquisition.  Thread caches, the lock-free
+ *      engine, and striped descriptors instead allocate and free the blocks
+ *      as Allocate() and Free() do.
+ */
+void *MemoryManager::Reallocate(void *p,
+                                std::size_t size,
+                                std::size_t alignment)
+{
+    // As with realloc(), a null pointer requests a new block
+    if (p == nullptr) return Allocate(size, alignment);
+
+    // Alignment values must be a power of two
+    if ((alignment != 0) && !std::has_single_bit(alignment)) return nullptr;
+
+    // Reallocate using the pools for the NUMA node that allocated the block
+    if (!nodes.empty())
+    {
+        MemoryManager *owner = LocateOwner(p);
+        for (const auto &node : nodes)
+        {
+            if (node.get() == owner)
+            {
+                return node->Reallocate(p, size, alignment);
+            }
+        }
+
+        logger->error << "Reallocate request made with a block not belonging "
+                         "to this Memory Manager"
+                      << std::flush;
+        return nullptr;
+    }
+
+    std::uint8_t *block = nullptr;
+    std::size_t index = 0;
+
+    // Ensure that the memory block is valid and belongs to this object
+    if (LocateBlock(p, block, index) != BlockStatus::Valid)
+    {
+        logger->error << "Reallocate request made with an invalid memory block"
+                      << std::flush;
+        return nullptr;
+    }
+
+    // Use the block in place if it is large enough and suitably aligned
+    if ((size <= profile[index].size) &&
+        (layouts[index].alignment >= alignment))
+    {
+        return p;
+    }
+
+    // The contents that must be preserved in the new block
+    const std::size_t length = std::min(size, profile[index].size);
+
+    // Without a pool lock for each request, allocate, copy, and free
+    if (options.thread_cache || options.lock_free || !stripes[index].empty())
+    {
+        void *q = Allocate(size, alignment);
+        if (q == nullptr) return nullptr;
+        std::memcpy(q, p, length);
+        Free(p);
+
+        return q;
+    }
+
+    // Iterate over each descriptor in the profile for available memory, just
+    // as Allocate() does; since the original block is too small or
+    // insufficiently aligned, its own descriptor is never selected
+    std::size_t first = profile.size();
+    std::size_t spills = 0;
+    for (std::size_t target = size_classes[SizeClass(size)];
+         target < profile.size();
+         target++)
+    {
+        // If the descriptor indicates memory is too small or insufficiently
+        // aligned, keep looking
+        if ((profile[target].size < size) ||
+            (layouts[target].alignment < alignment))
+        {
+            continue;
+        }
+
+        // Use a larger descriptor only as the first descriptor's policy allows
+        if (first == profile.size())
+        {
+            first = target;
+        }
+        else if (SpillAllowance(first, ++spills) == 0)
+        {
+            break;
+        }
+
+        // Take the new block from the calling thread's stripe, if striped
+        if (!stripes[target].empty())
+        {
+            std::uint8_t *moved = StripeAllocate(target);
+            if (moved == nullptr) continue;
+            if (target != first) RecordSpill(first, target, moved);
+
+            void *q = GetDataPointer(layouts[target], moved);
+            std::memcpy(q, p, length);
+            ReleaseSpill(index, block);
+            PoisonBlock(index, block);
+            {
+                const std::lock_guard<PoolMutex> lock(
+                    pool_locks[index].mutex);
+                FreeBlock(index, block, false);
+            }
+            ServeWaiters(index);
+
+            return q;
+        }
+
+        void *q = nullptr;
+        {
+            // Lock both descriptors' pools
+            const std::scoped_lock lock(pool_locks[index].mutex,
+                                        pool_locks[target].mutex);
+
+            // If no memory block can be taken from the pool, keep looking
+            std::uint8_t *moved = TakePoolBlock(target);
+            if (moved == nullptr) continue;
+            if (target != first) RecordSpill(first, target, moved);
+
+            // Move the contents and return the original block
+            q = GetDataPointer(layouts[target], moved);
+            std::memcpy(q, p, length);
+            ReleaseSpill(index, block);
+            PoisonBlock(index, block);
+            FreeBlock(index, block, false);
+        }
+        ServeWaiters(index);
+
+        return q;
+    }
+
+    return nullptr;
+}
+
+/*
+ *  MemoryManager::UsableSize()
+ *
+ *  Description:
+ *      This function will return the number of octets that may be used in a
+ *      block of memory provided by Allocate(), which is the size of the
+ *      descriptor that provided it and may exceed the size requested.
+ *
+ *  Parameters:
+ *      p [in]
+ *          Pointer to a block of memory provided by Allocate().
+ *
+ *  Returns:
+ *      The usable size of the block or 0 if the pointer given does not
+ *      refer to a valid block belonging to this Memory Manager.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t MemoryManager::UsableSize(void *p) const
+{
+    // Query the pools for the NUMA node that allocated the block
+    if (!nodes.empty())
+    {
+        if (p == nullptr) return 0;
+
+        MemoryManager *owner = LocateOwner(p);
+        for (const auto &node : nodes)
+        {
+            if (node.get() == owner) return node->UsableSize(p);
+        }
+
+        return 0;
+    }
+
+    std::uint8_t *block = nullptr;
+    std::size_t index = 0;
+
+    if (LocateBlock(p, block, index) != BlockStatus::Valid) return 0;
+
+    return profile[index].size;
+}
+
+/*
+ *  MemoryManager::AllocateBatch()
+ *
+ *  Description:
+ *      This function will allocate a number of memory blocks of the requested
+ *      size, locking each descriptor's pool only once.  Blocks are selected
+ *      in the same
+ *      manner as Allocate(), so if one descriptor cannot satisfy the entire
+ *      request, the remaining blocks are taken from the next (larger)
+ *      descriptor.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The size of each memory block requested.
+ *
+ *      count [in]
+ *          The number of memory blocks requested.
+ *
+ *      out [out]
+ *          An array of at least count elements that will receive pointers to
+ *          the allocated memory blocks.
+ *
+ *  Returns:
+ *      The number of memory blocks allocated, which will be less than count
+ *      if the request could not be fully satisfied.  The first elements of
+ *      the out array hold the allocated memory blocks.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t MemoryManager::AllocateBatch(std::size_t size,
+                                         std::size_t count,
+                                         void **out)
+{
+    std::size_t allocated = 0;
+
+    // Satisfy the request from the pools for the current NUMA node, if used
+    if (!nodes.empty())
+    {
+        return nodes[std::min(CurrentNumaNode(), nodes.size() - 1)]
+            ->AllocateBatch(size, count, out);
+    }
+
+    // Thread caches and the lock-free engine do not lock on each request
+    if (options.thread_cache || options.lock_free)
+    {
+        while (allocated < count)
+        {
+            void *p = Allocate(size);
+            if (p == nullptr) break;
+            out[allocated++] = p;
+        }
+        return allocated;
+    }
+
+    // Iterate over each descriptor in the profile for available memory,
+    // starting with the first that might be large enough
+    std::size_t first = profile.size();
+    std::size_t spills = 0;
+    for (std::size_t index = size_classes[SizeClass(size)];
+         (index < profile.size()) && (allocated < count);
+         index++)
+    {
+        // If the descriptor indicates memory is too small, keep looking
+        if (profile[index].size < size) continue;
+
+        // Use a larger descriptor only as the first descriptor's policy
+        // allows, limiting the number of blocks taken from it
+        std::size_t limit = count;
+        if (first == profile.size())
+        {
+            first = index;
+        }
+        else
+        {
+            const std::size_t allowance = SpillAllowance(first, ++spills);
+            if (allowance == 0) break;
+            limit = allocated + std::min(count - allocated, allowance);
+        }
+
+        // Take blocks from the calling thread's stripe, if striped
+        if (!stripes[index].empty())
+        {
+            while (allocated < limit)
+            {
+                std::uint8_t *block = StripeAllocate(index);
+                if (block == nullptr) break;
+                if (index != first) RecordSpill(first, index, block);
+                out[allocated++] = GetDataPointer(layouts[index], block);
+            }
+            continue;
+        }
+
+        // Lock the descriptor's pool
+        const std::lock_guard<PoolMutex> lock(pool_locks[index].mutex);
+
+        FreeList &blocks = allocations[index];
+
+        while (allocated < limit)
+        {
+            // If no memory blocks are available and allocation fails, move to
+            // the next descriptor
+            if ((blocks.count == 0) && !ReplenishPool(index))
+            {
+                // Note a fulfillment attempt failed
+                Count(statistics[index].unfulfilled);
+                break;
+            }
+
+            // Grab as many memory blocks off the free list as are needed
+            const std::size_t taken = std::min(limit - allocated, blocks.count);
+            for (std::size_t i = 0; i < taken; i++)
+            {
+                std::uint8_t *block = PopListBlock(blocks, index);
+                if (index != first) RecordSpill(first, index, block);
+                out[allocated++] = GetDataPointer(layouts[index], block);
+            }
+
+            // Have the pool refilled in the background when running low
+            if (options.replenish &&
+                (blocks.count < options.replenish_watermark))
+            {
+                WakeReplenisher();
+            }
+
+            // Update various statistics
+            held[index] += taken;
+            held_peak[index] = std::max(held[index], held_peak[index]);
+            activity[index].takes++;
+            Count(statistics[index].allocations, taken);
+            Count(statistics[index].outstanding, taken);
+            CountMaximum(statistics[index].max_outstanding,
+                         statistics[index].outstanding.load(
+                             std::memory_order_relaxed));
+        }
+    }
+
+    return allocated;
+}
+
+/*
+ *  MemoryManager::FreeBatch()
+ *
+ *  Description:
+ *      This function will free a number of memory blocks, locking each
+ *      descriptor's pool only once for each run of blocks belonging to the
+ *      same descriptor.
+ *
+ *  Parameters:
+ *      ptrs [in]
+ *          An array of pointers to memory blocks provided by Allocate() or
+ *          AllocateBatch().
+ *
+ *      count [in]
+ *          The number of elements in the ptrs array.
+ *
+ *  Returns:
+ *      The number of memory blocks freed.  This will be less than count only
+ *      if some pointers given do not belong to this Memory Manager.
+ *
+ *  Comments:
+ *      As with Free(), it is important that the pointers provided actually be
+ *      allocated by the Memory Manager.
+ */
+std::size_t MemoryManager::FreeBatch(void **ptrs, std::size_t count)
+{
+    std::size_t freed = 0;
+
+    // Thread caches, the lock-free engine, and NUMA pools do not lock on
+    // each request
+    if (options.thread_cache || options.lock_free || !nodes.empty())
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            if (Free(ptrs[i])) freed++;
+        }
+        return freed;
+    }
+
+    std::unique_lock<PoolMutex> lock;
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        std::uint8_t *block = nullptr;
+        std::size_t index = 0;
+
+        // Ensure that the memory block is valid and belongs to this object
+        const BlockStatus status = LocateBlock(ptrs[i], block, index);
+        if ((status != BlockStatus::Valid) && (status != BlockStatus::Corrupt))
+        {
+            if (RejectBlock(status)) freed++;
+            continue;
+        }
+
+        // Return any spill budget used by the block
+        ReleaseSpill(index, block);
+        PoisonBlock(index, block);
+
+        // Return the block to the calling thread's stripe, if striped
+        if (!stripes[index].empty())
+        {
+            if (lock.owns_lock()) lock.unlock();
+            StripeFree(block, index, status == BlockStatus::Corrupt);
+            ServeWaiters(index);
+            freed++;
+            continue;
+        }
+
+        // Lock the descriptor's pool, releasing any other pool first
+        if (!lock.owns_lock() || (lock.mutex() != &pool_locks[index].mutex))
+        {
+            if (lock.owns_lock()) lock.unlock();
+            lock = std::unique_lock<PoolMutex>(pool_locks[index].mutex);
+        }
+
+        // Return the block to the pool or the heap
+        FreeBlock(index, block, status == BlockStatus::Corrupt);
+        freed++;
+
+        // Hand the block to a request waiting for it, if any
+        if (wait_queues[index].waiting.load(std::memory_order_relaxed) > 0)
+        {
+            lock.unlock();
+            ServeWaiters(index);
+        }
+    }
+
+    return freed;
+}
+
+/*
+ *  MemoryManager::RejectBlock()
+ *
+ *  Description:
+ *      Report a block given to Free() that cannot be returned to the pool.
+ *
+ *  Parameters:
+ *      status [in]
+ *          The status of the block as determined by LocateBlock().
+ *
+ *  Returns:
+ *      The value to be returned by Free().
+ *
+ *  Comments:
+ *      A block with a bad descriptor index is never freed to the heap, since
+ *      the size and alignment with which it was allocated cannot be known
+ *      (and it may not have come from the heap at all).  The block is
+ *      leaked instead.
+ */
+bool MemoryManager::RejectBlock(BlockStatus status)
+{
+    switch (status)
+    {
+        case BlockStatus::Invalid:
+            logger->error << "The pointer given does not appear to be valid"
+                          << std::flush;
+            return false;
+
+        case BlockStatus::Foreign:
+            logger->error << "Attempt to free memory not allocated with this "
+                             "Memory Manager object"
+                          << std::flush;
+            return false;
+
+        case BlockStatus::BadIndex:
+            logger->error << "Free request made, but the descriptor data is "
+                             "bad; memory will not be freed"
+                          << std::flush;
+            return true;
+
+        default:
+            break;
+    }
+
+    return false;
+}
+
+/*
+ *  MemoryManager::FreeBlock()
+ *
+ *  Description:
+ *      Return a block given to Free() to the pool, or free it to the heap if
+ *      it is corrupt or the pool already holds the maximum number of blocks.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index to which the block belongs.
+ *
+ *      block [in]
+ *          The memory block being freed.
+ *
+ *      bad_block [in]
+ *          True if the block was found to be corrupt.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The pool lock for the profile index MUST be held by the calling
+ *      function.
+ */
+void MemoryManager::FreeBlock(std::size_t index,
+                              std::uint8_t *block,
+                              bool bad_block)
+{
+    // Update statistics
+    if (held[index] > 0) held[index]--;
+    Count(statistics[index].deallocations);
+    Uncount(statistics[index].outstanding);
+
+    // If the block is bad, update statistics, delete, and return to heap
+    if (bad_block)
+    {
+        Count(statistics[index].corruption_count);
+        DeleteBlock(index, block);
+        return;
+    }
+
+    // Put the block back on the vector, if possible else free to the heap
+    ReturnBlock(index, block);
+}
+
+/*
+ *  MemoryManager::GetStatistics()
+ *
+ *  Description:
+ *      Get the current Memory Manager statistics.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The Memory Manager Statistics structure containing the current
+ *      statistics information.
+ *
+ *  Comments:
+ *      None.
+ */
+std::vector<Statistics> MemoryManager::GetStatistics() const
+{
+    std::vector<Statistics> snapshot;
+
+    GetStatistics(snapshot);
+
+    return snapshot;
+}
+
+/*
  *  MemoryManager::GetStatistics()
  *
  *  Description:
- *      Get the current Memory Manager statistics.
+ *      Get a snapshot of the current Memory Manager statistics, reusing the
+ *      storage of the given vector.
+ *
+ *  Parameters:
+ *      snapshot [out]
+ *          The vector to receive the statistics for each descriptor.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Statistics counters are read without locking the pools, so this does
+ *      not block calls to Allocate() or Free().  Since counters are updated
+ *      independently, a snapshot taken while the Memory Manager is in use
+ *      may be momentarily inconsistent (e.g., by one allocation).
+ */
+void MemoryManager::GetStatistics(std::vector<Statistics> &snapshot) const
+{
+    // Sum the statistics for each NUMA node, if used
+    if (!nodes.empty())
+    {
+        std::vector<Statistics> node_snapshot;
+        nodes.front()->GetStatistics(snapshot);
+        for (std::size_t node = 1; node < nodes.size(); node++)
+        {
+            nodes[node]->GetStatistics(node_snapshot);
+            for (std::size_t index = 0; index < snapshot.size(); index++)
+            {
+                snapshot[index].allocations += node_snapshot[index].allocations;
+                snapshot[index].deallocations +=
+                    node_snapshot[index].deallocations;
+                snapshot[index].corruption_count +=
+                    node_snapshot[index].corruption_count;
+                snapshot[index].max_outstanding +=
+                    node_snapshot[index].max_outstanding;
+                snapshot[index].outstanding += node_snapshot[index].outstanding;
+                snapshot[index].unfulfilled += node_snapshot[index].unfulfilled;
+                snapshot[index].spilled += node_snapshot[index].spilled;
+            }
+        }
+        return;
+    }
+
+    snapshot.resize(profile.size());
+
+    for (std::size_t index = 0; index < profile.size(); index++)
+    {
+        const StatisticsCounters &counters = statistics[index];
+        snapshot[index].size = profile[index].size;
+        snapshot[index].allocations =
+            counters.allocations.load(std::memory_order_relaxed);
+        snapshot[index].deallocations =
+            counters.deallocations.load(std::memory_order_relaxed);
+        snapshot[index].corruption_count =
+            counters.corruption_count.load(std::memory_order_relaxed);
+        snapshot[index].max_outstanding =
+            counters.max_outstanding.load(std::memory_order_relaxed);
+        snapshot[index].outstanding =
+            counters.outstanding.load(std::memory_order_relaxed);
+        snapshot[index].unfulfilled =
+            counters.unfulfilled.load(std::memory_order_relaxed);
+        snapshot[index].spilled =
+            counters.spilled.load(std::memory_order_relaxed);
+    }
+
+    // If there are no thread caches or stripes, the snapshot is complete
+    if (!cache_registry &&
+        std::ranges::all_of(stripes,
+                            [](const std::vector<PoolStripe> &stripe_set)
+                            { return stripe_set.empty(); }))
+    {
+        return;
+    }
+
+    // Gather the caches whose counts have not yet been folded, noting that
+    // the set of thread caches is protected by the registry mutex
+    std::unique_lock<std::mutex> lock;
+    if (cache_registry)
+    {
+        lock = std::unique_lock<std::mutex>(cache_registry->mutex);
+    }
+
+    // Add in counts that have not yet been folded from the caches
+    for (std::size_t index = 0; index < snapshot.size(); index++)
+    {
+        const std::uint64_t folded = snapshot[index].outstanding;
+
+        const auto add_counters = [&](const ThreadCache &cache)
+        {
+            const std::uint64_t allocated =
+                cache.counters[index].allocations.load(
+                    std::memory_order_relaxed);
+            const std::uint64_t deallocated =
+                cache.counters[index].deallocations.load(
+                    std::memory_order_relaxed);
+            const std::int64_t peak =
+                cache.counters[index].peak.load(std::memory_order_relaxed);
+            snapshot[index].max_outstanding =
+                std::max(PeakOutstanding(folded, peak),
+                         snapshot[index].max_outstanding);
+            snapshot[index].allocations += allocated;
+            snapshot[index].deallocations += deallocated;
+            snapshot[index].outstanding += allocated - deallocated;
+        };
+
+        for (const ThreadCache *cache : thread_caches) add_counters(*cache);
+        for (const PoolStripe &stripe : stripes[index])
+        {
+            add_counters(stripe.cache);
+        }
+
+        // Blocks freed by a thread other than the allocating thread may
+        // transiently make the modular outstanding count appear negative
+        if (static_cast<std::int64_t>(snapshot[index].outstanding) < 0)
+        {
+            snapshot[index].outstanding = 0;
+        }
+        snapshot[index].max_outstanding =
+            std::max(snapshot[index].outstanding,
+                     snapshot[index].max_outstanding);
+    }
+}
+
+/*
+ *  MemoryManager::GetDiagnostics()
+ *
+ *  Description:
+ *      Get the current Memory Manager diagnostics.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The diagnostics for each descriptor in the profile.
+ *
+ *  Comments:
+ *      None.
+ */
+std::vector<Diagnostics> MemoryManager::GetDiagnostics() const
+{
+    std::vector<Diagnostics> snapshot;
+
+    GetDiagnostics(snapshot);
+
+    return snapshot;
+}
+
+/*
+ *  MemoryManager::GetDiagnostics()
+ *
+ *  Description:
+ *      Get a snapshot of the current Memory Manager diagnostics, reusing the
+ *      storage of the given vector.
+ *
+ *  Parameters:
+ *      snapshot [out]
+ *          The vector to receive the diagnostics for each descriptor.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      As with statistics, counters are read without locking the pools.  If
+ *      the library was built without diagnostics, all values other than the
+ *      block size are zero.  Lock counts include those of any stripes.
+ */
+void MemoryManager::GetDiagnostics(std::vector<Diagnostics> &snapshot) const
+{
+    // Sum the diagnostics for each NUMA node, if used
+    if (!nodes.empty())
+    {
+        std::vector<Diagnostics> node_snapshot;
+        nodes.front()->GetDiagnostics(snapshot);
+        for (std::size_t node = 1; node < nodes.size(); node++)
+        {
+            nodes[node]->GetDiagnostics(node_snapshot);
+            for (std::size_t index = 0; index < snapshot.size(); index++)
+            {
+                Diagnostics &total = snapshot[index];
+                const Diagnostics &other = node_snapshot[index];
+                for (std::size_t i = 0; i < Latency_Buckets; i++)
+                {
+                    total.allocate_latency[i] += other.allocate_latency[i];
+                    total.free_latency[i] += other.free_latency[i];
+                }
+                total.lock_acquisitions += other.lock_acquisitions;
+                total.lock_contentions += other.lock_contentions;
+                total.lock_wait_time += other.lock_wait_time;
+                total.heap_allocations += other.heap_allocations;
+                total.heap_frees += other.heap_frees;
+            }
+        }
+        return;
+    }
+
+    snapshot.assign(profile.size(), Diagnostics{});
+
+    for (std::size_t index = 0; index < profile.size(); index++)
+    {
+        snapshot[index].size = profile[index].size;
+
+        if constexpr (!Diagnostics_Enabled) continue;
+
+        const DiagnosticCounters &counters = diagnostics[index];
+        for (std::size_t i = 0; i < Latency_Buckets; i++)
+        {
+            snapshot[index].allocate_latency[i] =
+                counters.allocate_latency[i].load(std::memory_order_relaxed);
+            snapshot[index].free_latency[i] =
+                counters.free_latency[i].load(std::memory_order_relaxed);
+        }
+        snapshot[index].heap_allocations =
+            counters.heap_allocations.load(std::memory_order_relaxed);
+        snapshot[index].heap_frees =
+            counters.heap_frees.load(std::memory_order_relaxed);
+
+        // Sum the counts for the pool lock and those of any stripes
+        auto add_lock = [&](const PoolMutex &mutex)
+        {
+            snapshot[index].lock_acquisitions +=
+                mutex.acquisitions.load(std::memory_order_relaxed);
+            snapshot[index].lock_contentions +=
+                mutex.contentions.load(std::memory_order_relaxed);
+            snapshot[index].lock_wait_time +=
+                mutex.wait_time.load(std::memory_order_relaxed);
+        };
+        add_lock(pool_locks[index].mutex);
+        for (const PoolStripe &stripe : stripes[index]) add_lock(stripe.mutex);
+    }
+}
+
+/*
+ *  MemoryManager::PerformAllocation()
+ *
+ *  Description:
+ *      Allocate a block of memory for the given profile index.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The index into the profile vector for which a memory allocation
+ *          is to be made.
+ *
+ *  Returns:
+ *      True if successful, false if not.
+ *
+ *  Comments:
+ *      The pool lock for the profile index MUST be held by the calling
+ *      function.
+ */
+bool MemoryManager::PerformAllocation(std::size_t index)
+{
+    // Carve blocks reserved for pre-allocation first
+    if (CarveReserve(index, Reserve_Carve_Blocks) > 0) return true;
+
+    // Blocks given to users are held in thread caches when caching is used
+    const std::size_t existing = allocations[index].count + held[index];
+
+    // Perform no allocation if beyond constraints
+    if ((profile[index].maximum != 0) && (!profile[index].excess_allowed) &&
+        (existing >= profile[index].maximum))
+    {
+        return false;
+    }
+
+    // Allocate a new slab if using slabs, unless doing so would exceed the
+    // maximum (excess blocks are allocated individually so they may be
+    // returned to the heap when freed)
+    if (profile[index].slab_blocks > 0)
+    {
+        std::size_t count = profile[index].slab_blocks;
+        if (profile[index].maximum != 0)
+        {
+            count = (existing < profile[index].maximum) ?
+                        std::min(count, profile[index].maximum - existing) :
+                        0;
+        }
+        if (count > 0) return PerformSlabAllocation(index, count);
+    }
+
+    // Allocate the requested memory block
+    std::uint8_t *block = CreateBlock(index);
+    if (block == nullptr)
+    {
+        logger->error << "Failed to allocate heap memory" << std::flush;
+        return false;
+    }
+
+    // Place the allocated memory into the pool
+    PushListBlock(allocations[index], index, block);
+
+    return true;
+}
+
+/*
+ *  MemoryManager::PerformSlabAllocation()
+ *
+ *  Description:
+ *      Allocate a single contiguous slab of memory holding the given number
+ *      of blocks for the given profile index.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The index into the profile vector for which a memory allocation
+ *          is to be made.
+ *
+ *      count [in]
+ *          The number of blocks the slab should hold.
+ *
+ *  Returns:
+ *      True if successful, false if not.
+ *
+ *  Comments:
+ *      The pool lock for the profile index MUST be held by the calling
+ *      function.  Blocks within a slab are never returned to the heap
+ *      individually; the slab is freed when the Memory Manager is destroyed
+ *      or when the pool is trimmed.
+ */
+bool MemoryManager::PerformSlabAllocation(std::size_t index,
+                                          std::size_t count)
+{
+    const BlockLayout &layout = layouts[index];
+
+    std::uint8_t *slab = CreateSlab(index, count, profile[index].source);
+    if (slab == nullptr) return false;
+
+    // Carve the slab into blocks, placing each into the pool
+    for (std::size_t i = 0; i < count; i++)
+    {
+        std::uint8_t *block = std::next(
+            slab, PointerDiff(layout.slab_offset + (layout.stride * i)));
+        InitializeBlock(block, index, slab);
+        PushListBlock(allocations[index], index, block);
+    }
+
+    return true;
+}
+
+/*
+ *  MemoryManager::CreateSlab()
+ *
+ *  Description:
+ *      Allocate a single contiguous slab of memory able to hold the given
+ *      number of blocks for the given profile index, without creating the
+ *      blocks it holds.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The index into the profile vector for which the slab is made.
+ *
+ *      count [in]
+ *          The number of blocks the slab should hold.
+ *
+ *      source [in]
+ *          The source of the slab's memory.
+ *
+ *  Returns:
+ *      A pointer to the slab or nullptr if allocation failed.
+ *
+ *  Comments:
+ *      The slab is recorded so that it is freed when the Memory Manager is
+ *      destroyed.  If the slab cannot be mapped from the operating system as
+ *      requested, it is allocated from the heap.
+ */
+std::uint8_t *MemoryManager::CreateSlab(std::size_t index,
+                                        std::size_t count,
+                                        MemorySource source)
+{
+    const BlockLayout &layout = layouts[index];
+
+    const MemoryDescriptor &descriptor = profile[index];
+    const std::size_t slab_size = layout.slab_offset + (layout.stride * count);
+    std::uint8_t *slab = nullptr;
+    std::size_t length = 0;
+
+    // Map the slab from the operating system, if requested
+    if (source != MemorySource::Heap)
+    {
+        slab = MapMemory(slab_size,
+                         layout.slab_alignment,
+                         source,
+                         descriptor.prefault,
+                         length);
+        if (slab == nullptr)
+        {
+            logger->warning << "Failed to map memory for descriptor size "
+                            << descriptor.size << "; using heap memory"
+                            << std::flush;
+        }
+#ifdef __linux__
+        else if (descriptor.lock_pages && (mlock(slab, length) != 0))
+        {
+            logger->warning << "Failed to lock memory for descriptor size "
+                            << descriptor.size << std::flush;
+        }
+#endif
+    }
+
+    // Otherwise, allocate the slab from the heap
+    if (slab == nullptr)
+    {
+        slab = AllocateMemory(slab_size, layout.slab_alignment);
+        if (slab == nullptr)
+        {
+            logger->error << "Failed to allocate heap memory" << std::flush;
+            return nullptr;
+        }
+    }
+    slabs[index].push_back({slab, length, count});
+    if constexpr (Diagnostics_Enabled)
+    {
+        diagnostics[index].heap_allocations.fetch_add(
+            1,
+            std::memory_order_relaxed);
+    }
+
+    // Place the slab in memory local to this object's NUMA node
+    if (numa_node != No_Node)
+    {
+        BindToNode(slab, (length > 0) ? length : slab_size, numa_node);
+    }
+
+    // With compact headers, the slab header identifies the owner and the
+    // slab is recorded, if requested, so that FreeAny() may locate the owner
+    if (options.compact_headers)
+    {
+        InitializeSlab(slab, this, index, false);
+        if (options.free_any) RegisterSlab(this, slab, slab_size);
+    }
+
+    return slab;
+}
+
+/*
+ *  MemoryManager::CarveReserve()
+ *
+ *  Description:
+ *      Create blocks for the given profile index from its reserved slab,
+ *      placing them into the pool.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index for which blocks are created.
+ *
+ *      count [in]
+ *          The greatest number of blocks to create.
+ *
+ *  Returns:
+ *      The number of blocks created, which is 0 once every reserved block
+ *      has been created.
+ *
+ *  Comments:
+ *      The pool lock for the profile index MUST be held by the calling
+ *      function.
+ */
+std::size_t MemoryManager::CarveReserve(std::size_t index, std::size_t count)
+{
+    PoolReserve &reserve = reserves[index];
+    const BlockLayout &layout = layouts[index];
+
+    count = std::min(count, reserve.count - reserve.carved);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        std::uint8_t *block = std::next(
+            reserve.slab,
+            PointerDiff(layout.slab_offset +
+                        (layout.stride * reserve.carved++)));
+        InitializeBlock(block, index, reserve.slab);
+        PushListBlock(allocations[index], index, block);
+    }
+
+    return count;
+}
+
+/*
+ *  MemoryManager::InitializeBlock()
+ *
+ *  Description:
+ *      Populate the header and trailer of a newly allocated memory block.
+ *
+ *  Parameters:
+ *      block [in]
+ *          The memory block to initialize.
+ *
+ *      index [in]
+ *          The profile index to which the block belongs.
+ *
+ *      slab [in]
+ *          The slab containing the block or nullptr if allocated separately.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void MemoryManager::InitializeBlock(std::uint8_t *block,
+                                    std::size_t index,
+                                    std::uint8_t *slab)
+{
+    const BlockLayout &layout = layouts[index];
+
+    // Populate the header
+    if (options.compact_headers)
+    {
+        CompactHeader *header =
+            new (GetCompactHeader(layout, block)) CompactHeader{};
+        header->offset = static_cast<std::uint32_t>(
+            std::distance(slab, reinterpret_cast<std::uint8_t *>(header)));
+        header->index = static_cast<std::uint16_t>(index);
+        header->marker = Compact_Marker_Value;
+    }
+    else
+    {
+        MemoryHeader *header =
+            new (GetMemoryHeader(layout, block)) MemoryHeader{};
+        header->memory_manager = this;
+        header->index = index;
+        header->slab = slab;
+        header->owner = No_Remote_Queue;
+        header->marker = Header_Marker_Value;
+    }
+
+    // Populate the trailer, if blocks have one
+    if (options.validation != ValidationPolicy::Release)
+    {
+        GetTrailer(layout, block)->marker = Trailer_Marker_Value;
+    }
+
+    // Fill new user data so that use of uninitialized memory is apparent
+    if (options.validation == ValidationPolicy::Debug)
+    {
+        std::memset(GetDataPointer(layout, block),
+                    Allocated_Poison,
+                    profile[index].size);
+    }
+}
+
+/*
+ *  MemoryManager::CreateBlock()
+ *
+ *  Description:
+ *      Allocate a single memory block from the heap for the given profile
+ *      index and populate its header and trailer.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index to which the block will belong.
+ *
+ *  Returns:
+ *      A pointer to the new block or nullptr if allocation failed.
+ *
+ *  Comments:
+ *      When using compact headers, the block is placed within its own slab
+ *      so that the slab header can identify the owner.
+ */
+std::uint8_t *MemoryManager::CreateBlock(std::size_t index)
+{
+    const BlockLayout &layout = layouts[index];
+
+    // Allocate an individual block or, when using compact headers, a slab
+    // holding just this one block
+    std::uint8_t *memory = nullptr;
+    if (!options.compact_headers)
+    {
+        memory = layout.guarded ?
+                     MapGuardedBlock(layout.block_size, layout.alignment) :
+                     AllocateMemory(layout.block_size, layout.alignment);
+    }
+    else
+    {
+        memory = AllocateMemory(layout.slab_offset + layout.block_size,
+                                layout.alignment);
+    }
+    if (memory == nullptr) return nullptr;
+
+    // Count each allocation from the heap when collecting diagnostics
+    if constexpr (Diagnostics_Enabled)
+    {
+        diagnostics[index].heap_allocations.fetch_add(
+            1,
+            std::memory_order_relaxed);
+    }
+
+    // Without compact headers, the memory is the block itself
+    if (!options.compact_headers)
+    {
+        InitializeBlock(memory, index, nullptr);
+        return memory;
+    }
+
+    InitializeSlab(memory, this, index, true);
+    if (options.free_any)
+    {
+        RegisterSlab(this, memory, layout.slab_offset + layout.block_size);
+    }
+
+    std::uint8_t *block = std::next(memory, PointerDiff(layout.slab_offset));
+    InitializeBlock(block, index, memory);
+
+    return block;
+}
+
+/*
+ *  MemoryManager::DeleteBlock()
+ *
+ *  Description:
+ *      Free a memory block to the heap.  Blocks within a slab are not freed,
+ *      since the memory is released when the slab is freed.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index to which the block belongs.
+ *
+ *      block [in]
+ *          The memory block to free.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void MemoryManager::DeleteBlock(std::size_t index, std::uint8_t *block)
+{
+    const BlockLayout &layout = layouts[index];
+
+    if (options.compact_headers)
+    {
+        SlabHeader *slab = GetSlabHeader(layout, block);
+        if (!slab->individual) return;
+        auto *memory = reinterpret_cast<std::uint8_t *>(slab);
+        if (options.free_any) UnregisterSlab(memory);
+        DeleteMemory(memory, layout.alignment);
+    }
+    else
+    {
+        if (GetMemoryHeader(layout, block)->slab != nullptr) return;
+        if (layout.guarded)
+        {
+            UnmapGuardedBlock(block, layout.block_size);
+        }
+        else
+        {
+            DeleteMemory(block, layout.alignment);
+        }
+    }
+
+    // Count each block freed to the heap when collecting diagnostics
+    if constexpr (Diagnostics_Enabled)
+    {
+        diagnostics[index].heap_frees.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/*
+ *  MemoryManager::IsSlabBlock()
+ *
+ *  Description:
+ *      Determine whether the block resides within a slab of multiple blocks
+ *      and, therefore, cannot be freed to the heap individually.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index to which the block belongs.
+ *
+ *      block [in]
+ *          The memory block in question.
+ *
+ *  Returns:
+ *      True if the block resides in a slab, false if not.
+ *
+ *  Comments:
+ *      None.
+ */
+bool MemoryManager::IsSlabBlock(std::size_t index, std::uint8_t *block) const
+{
+    if (options.compact_headers)
+    {
+        return !GetSlabHeader(layouts[index], block)->individual;
+    }
+
+    return GetMemoryHeader(layouts[index], block)->slab != nullptr;
+}
+
+/*
+ *  MemoryManager::GetSlab()
+ *
+ *  Description:
+ *      Determine the slab containing the given block.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index to which the block belongs.
+ *
+ *      block [in]
+ *          The memory block in question.
+ *
+ *  Returns:
+ *      A pointer to the start of the slab or nullptr if the block was
+ *      allocated separately.
+ *
+ *  Comments:
+ *      With compact headers, a separately allocated block resides in its
+ *      own slab, which is not recorded among the descriptor's slabs.
+ */
+std::uint8_t *MemoryManager::GetSlab(std::size_t index,
+                                     std::uint8_t *block) const
+{
+    if (options.compact_headers)
+    {
+        SlabHeader *slab = GetSlabHeader(layouts[index], block);
+        if (slab->individual) return nullptr;
+        return reinterpret_cast<std::uint8_t *>(slab);
+    }
+
+    return GetMemoryHeader(layouts[index], block)->slab;
+}
+
+/*
+ *  MemoryManager::IsPooled()
+ *
+ *  Description:
+ *      Determine whether the block has been retained by the lock-free pool.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index to which the block belongs.
+ *
+ *      block [in]
+ *          The memory block in question.
+ *
+ *  Returns:
+ *      True if the block has been retained by the pool, false if not.
+ *
+ *  Comments:
+ *      Blocks residing in a slab of multiple blocks are always retained.
+ */
+bool MemoryManager::IsPooled(std::size_t index, std::uint8_t *block) const
+{
+    if (options.compact_headers)
+    {
+        const SlabHeader *slab = GetSlabHeader(layouts[index], block);
+        return !slab->individual || slab->pooled;
+    }
+
+    return GetMemoryHeader(layouts[index], block)->pooled;
+}
+
+/*
+ *  MemoryManager::SetPooled()
+ *
+ *  Description:
+ *      Mark the block as having been retained by the lock-free pool.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index to which the block belongs.
+ *
+ *      block [in]
+ *          The memory block to mark.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void MemoryManager::SetPooled(std::size_t index, std::uint8_t *block)
+{
+    if (options.compact_headers)
+    {
+        GetSlabHeader(layouts[index], block)->pooled = true;
+        return;
+    }
+
+    GetMemoryHeader(layouts[index], block)->pooled = true;
+}
+
+/*
+ *  MemoryManager::GetNextLink()
+ *
+ *  Description:
+ *      Get the location within a free block that holds a pointer to the next
+ *      block on a lock-free stack or free list.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index to which the block belongs.
+ *
+ *      block [in]
+ *          The memory block in question.
+ *
+ *  Returns:
+ *      A pointer to the link location.
+ *
+ *  Comments:
+ *      With compact headers, the link is stored in the unused data area.
+ */
+std::uint8_t **MemoryManager::GetNextLink(std::size_t index,
+                                          std::uint8_t *block) const
+{
+    if (options.compact_headers)
+    {
+        return reinterpret_cast<std::uint8_t **>(
+            GetDataPointer(layouts[index], block));
+    }
+
+    return &GetMemoryHeader(layouts[index], block)->next;
+}
+
+/*
+ *  MemoryManager::PushListBlock()
+ *
+ *  Description:
+ *      Place a free block at the head of the given free list.
+ *
+ *  Parameters:
+ *      list [in/out]
+ *          The free list onto which the block is placed.
+ *
+ *      index [in]
+ *          The profile index to which the block belongs.
+ *
+ *      block [in]
+ *          The memory block to place onto the list.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The list is linked through the same location as lock-free stacks, so
+ *      no memory is allocated.  If the list is the pool for the profile
+ *      index, the pool lock MUST be held by the calling function.
+ */
+void MemoryManager::PushListBlock(FreeList &list,
+                                  std::size_t index,
+                                  std::uint8_t *block)
+{
+    *GetNextLink(index, block) = list.head;
+    list.head = block;
+    list.count++;
+}
+
+/*
+ *  MemoryManager::PopListBlock()
+ *
+ *  Description:
+ *      Remove the free block at the head of the given free list.
+ *
+ *  Parameters:
+ *      list [in/out]
+ *          The free list from which the block is removed.
+ *
+ *      index [in]
+ *          The profile index to which the list's blocks belong.
+ *
+ *  Returns:
+ *      A pointer to the block or nullptr if the list is empty.
+ *
+ *  Comments:
+ *      If the list is the pool for the profile index, the pool lock MUST be
+ *      held by the calling function.
+ */
+std::uint8_t *MemoryManager::PopListBlock(FreeList &list, std::size_t index)
+{
+    std::uint8_t *block = list.head;
+    if (block == nullptr) return nullptr;
+
+    list.head = *GetNextLink(index, block);
+    list.count--;
+
+    return block;
+}
+
+/*
+ *  MemoryManager::LocateBlock()
+ *
+ *  Description:
+ *      Locate the memory block containing the user data given to Free() and
+ *      verify that the block is valid and belongs to this Memory Manager.
+ *
+ *  Parameters:
+ *      p [in]
+ *          Pointer to a block of memory provided by Allocate().
+ *
+ *      block [out]
+ *          The memory block containing the user data.  This is not set if
+ *          the status is Invalid, Foreign, or BadIndex.
+ *
+ *      index [out]
+ *          The profile index to which the block belongs.
+ *
+ *  Returns:
+ *      The status of the memory block.
+ *
+ *  Comments:
+ *      If blocks are not validated (or, when sampling, this block is not
+ *      among those sampled), the descriptor index is taken directly from
+ *      the block header and only its range is checked.
+ */
+MemoryManager::BlockStatus MemoryManager::LocateBlock(
+    void *p,
+    std::uint8_t *&block,
+    std::size_t &index) const
+{
+    // Does the memory block appear bad?
+    bool bad_block = false;
+
+    // Ensure that memory block is valid
+    if (p == nullptr) return BlockStatus::Invalid;
+
+    auto *data = static_cast<std::uint8_t *>(p);
+
+    // Trust the block header if not validating blocks or if this free is
+    // not among those sampled
+    if ((options.validation == ValidationPolicy::Release) ||
+        ((options.validation == ValidationPolicy::Sampling) &&
+         !SampleFree(options.validation_interval)))
+    {
+        if (options.compact_headers)
+        {
+            index = reinterpret_cast<const CompactHeader *>(
+                        std::prev(data, PointerDiff(sizeof(CompactHeader))))
+                        ->index;
+        }
+        else
+        {
+            index = reinterpret_cast<const MemoryHeader *>(
+                        std::prev(data, PointerDiff(sizeof(MemoryHeader))))
+                        ->index;
+        }
+        if (index >= profile.size()) return BlockStatus::BadIndex;
+        block = std::prev(data, PointerDiff(layouts[index].header_space));
+        return BlockStatus::Valid;
+    }
+
+    if (options.compact_headers)
+    {
+        const auto *header = reinterpret_cast<const CompactHeader *>(
+            std::prev(data, PointerDiff(sizeof(CompactHeader))));
+        const auto *slab = reinterpret_cast<const SlabHeader *>(
+            std::prev(reinterpret_cast<const std::uint8_t *>(header),
+                      PointerDiff(header->offset)));
+
+        // Verify that memory appears to belong to this Memory Manager
+        if ((slab->marker != Slab_Marker_Value) ||
+            (slab->memory_manager != this))
+        {
+            return BlockStatus::Foreign;
+        }
+
+        // Check that the block index is within a valid range
+        if (slab->index >= profile.size()) return BlockStatus::BadIndex;
+        index = slab->index;
+
+        // Verify header marker and index
+        if ((header->marker != Compact_Marker_Value) ||
+            (header->index != index))
+        {
+            bad_block = true;
+        }
+    }
+    else
+    {
+        // Verify that memory appears to belong to this Memory Manager
+        if (ReadHeaderOwner(data) != this) return BlockStatus::Foreign;
+
+        auto *header = reinterpret_cast<const MemoryHeader *>(
+            std::prev(data, PointerDiff(sizeof(MemoryHeader))));
+
+        // Verify header marker
+        if (header->marker != Header_Marker_Value) bad_block = true;
+
+        // Check that the block index is within a valid range
+        if (header->index >= profile.size()) return BlockStatus::BadIndex;
+        index = header->index;
+    }
+
+    // Locate the start of the block
+    block = std::prev(data, PointerDiff(layouts[index].header_space));
+
+    // Check trailer marker to ensure memory is not corrupt
+    if (GetTrailer(layouts[index], block)->marker != Trailer_Marker_Value)
+    {
+        bad_block = true;
+    }
+
+    return bad_block ? BlockStatus::Corrupt : BlockStatus::Valid;
+}
+
+/*
+ *  MemoryManager::LocateOwner()
+ *
+ *  Description:
+ *      Determine which Memory Manager allocated the user data given to
+ *      Free(), which is used to return a block to the pools for the NUMA
+ *      node from which it was allocated.
+ *
+ *  Parameters:
+ *      p [in]
+ *          Pointer to a block of memory provided by Allocate().
+ *
+ *  Returns:
+ *      The Memory Manager recorded in the block header or nullptr if the
+ *      block does not appear to belong to any Memory Manager.
+ *
+ *  Comments:
+ *      The pointer must not be nullptr.  The Memory Manager located is
+ *      expected to validate the block.
+ */
+MemoryManager *MemoryManager::LocateOwner(void *p) const
+{
+    auto *data = static_cast<std::uint8_t *>(p);
+
+    if (options.compact_headers)
+    {
+        const auto *header = reinterpret_cast<const CompactHeader *>(
+            std::prev(data, PointerDiff(sizeof(CompactHeader))));
+        const auto *slab = reinterpret_cast<const SlabHeader *>(
+            std::prev(reinterpret_cast<const std::uint8_t *>(header),
+                      PointerDiff(header->offset)));
+
+        return (slab->marker == Slab_Marker_Value) ? slab->memory_manager :
+                                                     nullptr;
+    }
+
+    return reinterpret_cast<const MemoryHeader *>(
+               std::prev(data, PointerDiff(sizeof(MemoryHeader))))
+        ->memory_manager;
+}
+
+/*
+ *  MemoryManager::ReplenishPool()
+ *
+ *  Description:
+ *      Place at least one free block into the pool for the given profile
+ *      index, which is called when the pool is empty.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index for which a block is needed.
+ *
+ *  Returns:
+ *      True if a block is available, false if not.
+ *
+ *  Comments:
+ *      The pool lock for the profile index MUST be held by the calling
+ *      function.
+ */
+bool MemoryManager::ReplenishPool(std::size_t index)
+{
+    // When adapting to observed usage, pre-allocate additional blocks
+    if (options.adaptive) AdaptDescriptor(index);
+
+    return (allocations[index].count > 0) || PerformAllocation(index);
+}
+
+/*
+ *  MemoryManager::TakePoolBlock()
+ *
+ *  Description:
+ *      Take a free block from the pool for the given profile index for a
+ *      user, replenishing the pool if it is empty.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index from which a block is needed.
+ *
+ *  Returns:
+ *      A pointer to the block or nullptr if the pool is empty and no block
+ *      could be allocated.
+ *
+ *  Comments:
+ *      The pool lock for the profile index MUST be held by the calling
+ *      function.  Statistics are updated to reflect the allocation or the
+ *      failed fulfillment attempt.
+ */
+std::uint8_t *MemoryManager::TakePoolBlock(std::size_t index)
+{
+    // If no memory blocks are available and allocation fails, give up
+    if ((allocations[index].count == 0) && !ReplenishPool(index))
+    {
+        // Note a fulfillment attempt failed
+        Count(statistics[index].unfulfilled);
+        return nullptr;
+    }
+
+    // Update various statistics
+    held[index]++;
+    held_peak[index] = std::max(held[index], held_peak[index]);
+    activity[index].takes++;
+    Count(statistics[index].allocations);
+    Count(statistics[index].outstanding);
+    CountMaximum(statistics[index].max_outstanding,
+                 statistics[index].outstanding.load(std::memory_order_relaxed));
+
+    // Grab the memory block at the head of the free list
+    std::uint8_t *block = PopListBlock(allocations[index], index);
+
+    // Have the pool refilled in the background when running low
+    if (options.replenish &&
+        (allocations[index].count < options.replenish_watermark))
+    {
+        WakeReplenisher();
+    }
+
+    return block;
+}
+
+/*
+ *  MemoryManager::RecommendDescriptor()
+ *
+ *  Description:
+ *      Determine a descriptor for the given profile index that would satisfy
+ *      the usage observed so far without allocating from or freeing to the
+ *      heap.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index for which a recommendation is made.
+ *
+ *  Returns:
+ *      The recommended MemoryDescriptor.
+ *
+ *  Comments:
+ *      The pool lock for the profile index MUST be held by the calling
+ *      function.  The recommended minimum is the peak number of blocks in
+ *      use plus some headroom.  If excess is allowed, the maximum is raised
+ *      to at least the minimum so that blocks are not freed to the heap.  If
+ *      excess is not allowed, the maximum is raised according to the number
+ *      of unfulfilled requests.
+ */
+MemoryDescriptor MemoryManager::RecommendDescriptor(std::size_t index) const
+{
+    MemoryDescriptor descriptor = profile[index];
+
+    const std::size_t peak = held_peak[index];
+    const std::size_t target = peak + (peak >> Adaptive_Headroom_Shift);
+
+    descriptor.minimum = std::max(descriptor.minimum, target);
+
+    if (descriptor.maximum != 0)
+    {
+        if (descriptor.excess_allowed)
+        {
+            descriptor.maximum =
+                std::max(descriptor.maximum, descriptor.minimum);
+        }
+        else
+        {
+            const std::uint64_t unfulfilled =
+                statistics[index].unfulfilled.load(std::memory_order_relaxed);
+            descriptor.maximum += static_cast<std::size_t>(
+                std::min<std::uint64_t>(unfulfilled, descriptor.maximum));
+            descriptor.minimum =
+                std::min(descriptor.minimum, descriptor.maximum);
+        }
+    }
+
+    return descriptor;
+}
+
+/*
+ *  MemoryManager::AdaptDescriptor()
+ *
+ *  Description:
+ *      Adjust the descriptor for the given profile index according to the
+ *      usage observed so far and pre-allocate blocks toward the new minimum.
+ *      With background replenishment, the background thread is asked to
+ *      pre-allocate the blocks instead.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index of the descriptor to adapt.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The pool lock for the profile index MUST be held by the calling
+ *      function.  The maximum of a descriptor that does not allow excess is
+ *      never changed, since it is a hard limit on the number of blocks.
+ */
+void MemoryManager::AdaptDescriptor(std::size_t index)
+{
+    const MemoryDescriptor recommended = RecommendDescriptor(index);
+    MemoryDescriptor &descriptor = profile[index];
+
+    if (descriptor.excess_allowed || (descriptor.maximum == 0))
+    {
+        descriptor.maximum = recommended.maximum;
+        descriptor.minimum = recommended.minimum;
+    }
+    else
+    {
+        descriptor.minimum =
+            std::min(recommended.minimum, descriptor.maximum);
+    }
+
+    // Leave pre-allocation to the background thread, if there is one
+    if (options.replenish)
+    {
+        if (allocations[index].count + held[index] < descriptor.minimum)
+        {
+            WakeReplenisher();
+        }
+        return;
+    }
+
+    // Pre-allocate a limited number of blocks toward the minimum
+    for (std::size_t i = 0; (i < Adaptive_Warm_Blocks) &&
+                            (allocations[index].count + held[index] <
+                             descriptor.minimum);
+         i++)
+    {
+        if (!PerformAllocation(index)) break;
+    }
+}
+
+/*
+ *  MemoryManager::GetRecommendedProfile()
+ *
+ *  Description:
+ *      Get a MemoryProfile that would satisfy the usage observed so far
+ *      without allocating from or freeing to the heap.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The recommended MemoryProfile.
+ *
+ *  Comments:
+ *      The recommendation is based on the peak number of blocks in use for
+ *      each descriptor, so it is most useful after the application has run
+ *      under a representative load.
+ */
+MemoryProfile MemoryManager::GetRecommendedProfile() const
+{
+    // Recommend the largest values required by any NUMA node, if used
+    if (!nodes.empty())
+    {
+        MemoryProfile recommended = nodes.front()->GetRecommendedProfile();
+        for (std::size_t node = 1; node < nodes.size(); node++)
+        {
+            const MemoryProfile node_profile =
+                nodes[node]->GetRecommendedProfile();
+            for (std::size_t index = 0; index < recommended.size(); index++)
+            {
+                recommended[index].minimum = std::max(
+                    recommended[index].minimum, node_profile[index].minimum);
+                if ((recommended[index].maximum != 0) &&
+                    (node_profile[index].maximum != 0))
+                {
+                    recommended[index].maximum =
+                        std::max(recommended[index].maximum,
+                                 node_profile[index].maximum);
+                }
+                else
+                {
+                    recommended[index].maximum = 0;
+                }
+            }
+        }
+        return recommended;
+    }
+
+    MemoryProfile recommended;
+
+    for (std::size_t index = 0; index < profile.size(); index++)
+    {
+        const std::lock_guard<PoolMutex> lock(pool_locks[index].mutex);
+        recommended.push_back(RecommendDescriptor(index));
+    }
+
+    return recommended;
+}
+
+/*
+ *  MemoryManager::Trim()
+ *
+ *  Description:
+ *      Release free blocks retained in the pools beyond each descriptor's
+ *      minimum, starting with the largest blocks, until no more than the
+ *      given number of bytes remains in such blocks.
+ *
+ *  Parameters:
+ *      target_bytes [in]
+ *          The number of bytes that may remain in free blocks beyond the
+ *          minimums.  If 0, all such blocks that can be released are.
+ *
+ *  Returns:
+ *      The approximate number of bytes released.
+ *
+ *  Comments:
+ *      Blocks within a slab are released only when the entire slab can be
+ *      released.  With NUMA pools, each node may retain an equal share of
+ *      the target.  The lock-free engine retains its blocks, so nothing is
+ *      released.
+ */
+std::size_t MemoryManager::Trim(std::size_t target_bytes)
+{
+    std::size_t released = 0;
+
+    // Trim the pools of each NUMA node, if used
+    if (!nodes.empty())
+    {
+        for (const auto &node : nodes)
+        {
+            released += node->Trim(target_bytes / nodes.size());
+        }
+        return released;
+    }
+
+    if (options.lock_free) return 0;
+
+    // Determine how much memory is held in free blocks beyond the minimums
+    std::size_t excess = 0;
+    for (std::size_t index = 0; index < profile.size(); index++)
+    {
+        excess += ExcessBytes(index);
+    }
+    if (excess <= target_bytes) return 0;
+
+    // Release the largest blocks first until the target is reached
+    const std::size_t needed = excess - target_bytes;
+    for (std::size_t index = profile.size(); (index > 0) && (released < needed);
+         index--)
+    {
+        released += ReleasePool(index - 1, needed - released);
+    }
+
+    return released;
+}
+
+/*
+ *  MemoryManager::ReleaseIdle()
+ *
+ *  Description:
+ *      Release free blocks retained beyond the minimum for each descriptor
+ *      whose pool has not been used for at least the given time.
+ *
+ *  Parameters:
+ *      age [in]
+ *          The time for which a pool must have been idle.
+ *
+ *  Returns:
+ *      The approximate number of bytes released.
+ *
+ *  Comments:
+ *      So that Allocate() and Free() do little additional work, a pool's use
+ *      is detected by comparing its state, including a count of the times
+ *      blocks were taken from it, with that seen by the previous call to
+ *      this function (or by the constructor).  A pool is therefore only
+ *      known to be idle from the time of a call that found it unchanged, and
+ *      should be checked at intervals shorter than the age.  Blocks taken
+ *      from and returned to a thread cache without touching the pool are not
+ *      considered use of the pool.
+ */
+std::size_t MemoryManager::ReleaseIdle(std::chrono::nanoseconds age)
+{
+    std::size_t released = 0;
+
+    // Release idle pools of each NUMA node, if used
+    if (!nodes.empty())
+    {
+        for (const auto &node : nodes) released += node->ReleaseIdle(age);
+        return released;
+    }
+
+    if (options.lock_free) return 0;
+
+    const auto now = std::chrono::steady_clock::now();
+
+    for (std::size_t index = 0; index < profile.size(); index++)
+    {
+        {
+            // Lock the descriptor's pool
+            const std::lock_guard<PoolMutex> lock(pool_locks[index].mutex);
+
+            // If the pool has been used since last observed, note its state
+            PoolActivity &state = activity[index];
+            if ((state.observed_takes != state.takes) ||
+                (state.count != allocations[index].count) ||
+                (state.held != held[index]))
+            {
+                state.observed_takes = state.takes;
+                state.count = allocations[index].count;
+                state.held = held[index];
+                state.since = now;
+                continue;
+            }
+
+            if ((now - state.since) < age) continue;
+        }
+
+        released += ReleasePool(index, std::numeric_limits<std::size_t>::max());
+    }
+
+    return released;
+}
+
+/*
+ *  MemoryManager::WarmUp()
+ *
+ *  Description:
+ *      Create any reserved blocks not yet created and touch every page of
+ *      the free blocks in each pool, so that allocations made afterward do
+ *      not cause page faults.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This is intended to be called before traffic arrives.  Only blocks
+ *      free in the pools are touched, since the contents of pages are
+ *      rewritten unchanged.  Each pool is locked while it is warmed.
+ */
+void MemoryManager::WarmUp()
+{
+    // Warm each NUMA node's pools, if used
+    if (!nodes.empty())
+    {
+        for (const auto &node : nodes) node->WarmUp();
+        return;
+    }
+
+    if (options.lock_free) return;
+
+    const std::size_t page_size = PageSize();
+
+    for (std::size_t index = 0; index < profile.size(); index++)
+    {
+        // Lock the descriptor's pool
+        const std::lock_guard<PoolMutex> lock(pool_locks[index].mutex);
+
+        // Create the remaining reserved blocks
+        while (CarveReserve(index, Reserve_Carve_Blocks) > 0) {}
+
+        // Fault in each page of the free blocks, first and last included
+        const BlockLayout &layout = layouts[index];
+        for (std::uint8_t *block = allocations[index].head; block != nullptr;
+             block = *GetNextLink(index, block))
+        {
+            volatile std::uint8_t *memory = block;
+            for (std::size_t offset = 0; offset < layout.block_size;
+                 offset += page_size)
+            {
+                memory[offset] = memory[offset];
+            }
+            memory[layout.block_size - 1] = memory[layout.block_size - 1];
+        }
+    }
+}
+
+/*
+ *  MemoryManager::ReturnBlock()
+ *
+ *  Description:
+ *      Place a free block back into the pool for the given profile index if
+ *      the maximum has not been reached, else free it to the heap.  Blocks
+ *      within a slab are always retained.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index to which the block belongs.
+ *
+ *      block [in]
+ *          The memory block being returned.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The pool lock for the profile index MUST be held by the calling
+ *      function.
+ */
+void MemoryManager::ReturnBlock(std::size_t index, std::uint8_t *block)
+{
+    // Rather than freeing the block to the heap, raise the maximum if
+    // adapting to observed usage
+    if (options.adaptive && (profile[index].maximum != 0) &&
+        (allocations[index].count >= profile[index].maximum))
+    {
+        AdaptDescriptor(index);
+    }
+
+    if ((profile[index].maximum == 0) ||
+        (allocations[index].count < profile[index].maximum) ||
+        IsSlabBlock(index, block))
+    {
+        PushListBlock(allocations[index], index, block);
+    }
+    else if (options.replenish)
+    {
+        // Retain the block, leaving it to be freed in the background
+        PushListBlock(allocations[index], index, block);
+        WakeReplenisher();
+    }
+    else
+    {
+        DeleteBlock(index, block);
+    }
+}
+
+/*
+ *  MemoryManager::WakeReplenisher()
+ *
+ *  Description:
+ *      Request that the background thread maintain the pools.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This may be called with a pool lock held.
+ */
+void MemoryManager::WakeReplenisher()
+{
+    // Only wake the thread if a request is not already pending
+    if (replenisher->pending.exchange(true, std::memory_order_relaxed)) return;
+
+    // Locking ensures the thread is either waiting or will see the request
+    const std::lock_guard<std::mutex> lock(replenisher->mutex);
+    replenisher->condition.notify_one();
+}
+
+/*
+ *  MemoryManager::RunReplenisher()
+ *
+ *  Description:
+ *      Body of the background thread that maintains the pools, which waits
+ *      until requested to do so.  If a decay time is given, the thread also
+ *      releases idle pools each time that interval elapses.  When
+ *      pre-allocating in the background, the thread first creates the
+ *      reserved blocks, a batch at a time.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The thread exits when the Memory Manager is destroyed.
+ */
+void MemoryManager::RunReplenisher()
+{
+    std::unique_lock<std::mutex> lock(replenisher->mutex);
+
+    const bool decay = (options.decay_time.count() > 0);
+    auto deadline = std::chrono::steady_clock::now() + options.decay_time;
+    const auto requested = [&]() -> bool
+    {
+        return replenisher->stop ||
+               replenisher->pending.load(std::memory_order_relaxed);
+    };
+
+    // Create reserved blocks, locking each pool only briefly
+    if (options.preallocation == PreallocationPolicy::Background)
+    {
+        for (std::size_t index = 0; index < profile.size(); index++)
+        {
+            std::size_t carved = 1;
+            while (!replenisher->stop && (carved > 0))
+            {
+                lock.unlock();
+                {
+                    const std::lock_guard<PoolMutex> pool_lock(
+                        pool_locks[index].mutex);
+                    carved = CarveReserve(index, Reserve_Carve_Blocks);
+                }
+                lock.lock();
+            }
+        }
+    }
+
+    while (true)
+    {
+        if (decay)
+        {
+            replenisher->condition.wait_until(lock, deadline, requested);
+        }
+        else
+        {
+            replenisher->condition.wait(lock, requested);
+        }
+        if (replenisher->stop) break;
+
+        // Clear the request before maintaining the pools so that further
+        // requests made meanwhile are not lost
+        const bool maintain =
+            replenisher->pending.exchange(false, std::memory_order_relaxed);
+        const bool release =
+            decay && (std::chrono::steady_clock::now() >= deadline);
+
+        lock.unlock();
+        if (maintain)
+        {
+            for (std::size_t index = 0; index < profile.size(); index++)
+            {
+                MaintainPool(index);
+            }
+        }
+        if (release)
+        {
+            ReleaseIdle(options.decay_time);
+            deadline = std::chrono::steady_clock::now() + options.decay_time;
+        }
+        lock.lock();
+    }
+}
+
+/*
+ *  MemoryManager::MaintainPool()
+ *
+ *  Description:
+ *      Free to the heap any blocks in the pool for the given profile index
+ *      beyond the maximum and, if the pool is running low, allocate blocks
+ *      so that it holds twice the replenish watermark.  When adapting to
+ *      observed usage, blocks are also allocated so that the pool and the
+ *      blocks in use together reach the adapted minimum.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index of the pool to maintain.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Individual blocks are allocated and freed without holding the pool
+ *      lock.  Slabs are allocated with the lock held, since the new blocks
+ *      are placed into the pool as the slab is created.
+ */
+void MemoryManager::MaintainPool(std::size_t index)
+{
+    FreeList blocks{};
+    std::size_t needed = 0;
+
+    {
+        // Lock the descriptor's pool
+        const std::lock_guard<PoolMutex> lock(pool_locks[index].mutex);
+
+        FreeList &pool = allocations[index];
+        const MemoryDescriptor &descriptor = profile[index];
+
+        // Unlink free blocks beyond the maximum (other than slab blocks)
+        if (descriptor.maximum != 0)
+        {
+            std::uint8_t **link = &pool.head;
+            while ((*link != nullptr) && (pool.count > descriptor.maximum))
+            {
+                std::uint8_t *block = *link;
+                if (IsSlabBlock(index, block))
+                {
+                    link = GetNextLink(index, block);
+                    continue;
+                }
+                *link = *GetNextLink(index, block);
+                pool.count--;
+                PushListBlock(blocks, index, block);
+            }
+        }
+
+        // Determine the number of free blocks wanted in the pool
+        std::size_t wanted = (pool.count < options.replenish_watermark) ?
+                                 (2 * options.replenish_watermark) :
+                                 0;
+        if (options.adaptive && (descriptor.minimum > held[index]))
+        {
+            wanted = std::max(wanted, descriptor.minimum - held[index]);
+        }
+
+        // Use any reserved blocks before allocating others
+        if (pool.count < wanted) CarveReserve(index, wanted - pool.count);
+
+        // Determine how many blocks are needed, staying within the maximum
+        if (pool.count < wanted)
+        {
+            needed = wanted - pool.count;
+            if (descriptor.maximum != 0)
+            {
+                const std::size_t existing =
+                    pool.count +
+                    (descriptor.excess_allowed ? 0 : held[index]);
+                needed = (existing < descriptor.maximum) ?
+                             std::min(needed, descriptor.maximum - existing) :
+                             0;
+            }
+
+            // Carve slabs into the pool while the lock is held
+            if (descriptor.slab_blocks > 0)
+            {
+                const std::size_t target = pool.count + needed;
+                while ((pool.count < target) && PerformAllocation(index)) {}
+                needed = 0;
+            }
+        }
+    }
+
+    // Free blocks removed from the pool
+    while (std::uint8_t *block = PopListBlock(blocks, index))
+    {
+        DeleteBlock(index, block);
+    }
+
+    if (needed == 0) return;
+
+    // Allocate the blocks needed, linking them together
+    std::uint8_t *last = nullptr;
+    for (std::size_t i = 0; i < needed; i++)
+    {
+        std::uint8_t *block = CreateBlock(index);
+        if (block == nullptr)
+        {
+            logger->error << "Failed to allocate heap memory" << std::flush;
+            break;
+        }
+        if (last == nullptr) last = block;
+        PushListBlock(blocks, index, block);
+    }
+
+    if (last == nullptr) return;
+
+    // Lock the descriptor's pool
+    const std::lock_guard<PoolMutex> lock(pool_locks[index].mutex);
+
+    // Place the allocated blocks onto the front of the pool
+    *GetNextLink(index, last) = allocations[index].head;
+    allocations[index].head = blocks.head;
+    allocations[index].count += blocks.count;
+}
+
+/*
+ *  MemoryManager::ExcessBytes()
+ *
+ *  Description:
+ *      Determine how much memory is held in free blocks in the pool for the
+ *      given profile index beyond the descriptor's minimum.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index of the pool in question.
+ *
+ *  Returns:
+ *      The approximate number of bytes held.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t MemoryManager::ExcessBytes(std::size_t index) const
+{
+    // Lock the descriptor's pool
+    const std::lock_guard<PoolMutex> lock(pool_locks[index].mutex);
+
+    const std::size_t count = allocations[index].count;
+    const std::size_t minimum = profile[index].minimum;
+
+    return (count > minimum) ? (count - minimum) * layouts[index].stride : 0;
+}
+
+/*
+ *  MemoryManager::ReleasePool()
+ *
+ *  Description:
+ *      Free to the heap (or operating system) free blocks in the pool for the
+ *      given profile index beyond the descriptor's minimum until at least
+ *      the given number of bytes has been released.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index of the pool to release.
+ *
+ *      bytes [in]
+ *          The number of bytes to release.
+ *
+ *  Returns:
+ *      The approximate number of bytes released, which may be more or less
+ *      than requested.
+ *
+ *  Comments:
+ *      Separately allocated blocks are released first.  A slab is released
+ *      only if all of its blocks are in the pool and releasing them would
+ *      not leave fewer than the minimum, which requires walking the free
+ *      list while the pool lock is held.  Memory is freed after the lock is
+ *      released.
+ */
+std::size_t MemoryManager::ReleasePool(std::size_t index, std::size_t bytes)
+{
+    const BlockLayout &layout = layouts[index];
+    FreeList blocks{};
+    std::vector<SlabRecord> released_slabs;
+    std::size_t released = 0;
+
+    {
+        // Lock the descriptor's pool
+        const std::lock_guard<PoolMutex> lock(pool_locks[index].mutex);
+
+        FreeList &pool = allocations[index];
+        const std::size_t observed = pool.count;
+        std::size_t excess = (pool.count > profile[index].minimum) ?
+                                 pool.count - profile[index].minimum :
+                                 0;
+
+        // Unlink free blocks allocated separately
+        std::uint8_t **link = &pool.head;
+        while ((*link != nullptr) && (excess > 0) && (released < bytes))
+        {
+            std::uint8_t *block = *link;
+            if (IsSlabBlock(index, block))
+            {
+                link = GetNextLink(index, block);
+                continue;
+            }
+            *link = *GetNextLink(index, block);
+            pool.count--;
+            excess--;
+            released += layout.stride;
+            PushListBlock(blocks, index, block);
+        }
+
+        // Select the most recent slabs having all of their blocks free
+        if ((excess > 0) && (released < bytes) && !slabs[index].empty())
+        {
+            std::unordered_map<std::uint8_t *, std::size_t> free_blocks;
+            for (std::uint8_t *block = pool.head; block != nullptr;
+                 block = *GetNextLink(index, block))
+            {
+                if (std::uint8_t *slab = GetSlab(index, block))
+                {
+                    free_blocks[slab]++;
+                }
+            }
+
+            // A selected slab is marked by a free block count of zero
+            auto &records = slabs[index];
+            for (std::size_t i = records.size();
+                 (i > 0) && (excess > 0) && (released < bytes);
+                 i--)
+            {
+                SlabRecord &record = records[i - 1];
+                auto found = free_blocks.find(record.slab);
+                if ((found == free_blocks.end()) ||
+                    (found->second != record.count) || (record.count > excess))
+                {
+                    continue;
+                }
+                found->second = 0;
+                excess -= record.count;
+                released += layout.slab_offset + (layout.stride * record.count);
+                released_slabs.push_back(record);
+                record.slab = nullptr;
+            }
+            std::erase_if(records,
+                          [](const SlabRecord &record) -> bool
+                          { return record.slab == nullptr; });
+
+            // Unlink the blocks within the selected slabs
+            link = &pool.head;
+            while (!released_slabs.empty() && (*link != nullptr))
+            {
+                std::uint8_t *block = *link;
+                std::uint8_t *slab = GetSlab(index, block);
+                if ((slab != nullptr) && (free_blocks.at(slab) == 0))
+                {
+                    *link = *GetNextLink(index, block);
+                    pool.count--;
+                    continue;
+                }
+                link = GetNextLink(index, block);
+            }
+        }
+
+        // Releasing blocks is not use of the pool
+        if (activity[index].count == observed)
+        {
+            activity[index].count = pool.count;
+        }
+    }
+
+    // Free the blocks and slabs removed from the pool
+    while (std::uint8_t *block = PopListBlock(blocks, index))
+    {
+        DeleteBlock(index, block);
+    }
+    ReleaseSlabs(index, released_slabs);
+
+    return released;
+}
+
+/*
+ *  MemoryManager::ReleaseSlabs()
+ *
+ *  Description:
+ *      Free the given slabs for the given profile index, which releases the
+ *      blocks they contain.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index to which the slabs belong.
+ *
+ *      released [in]
+ *          The slabs to free, none of whose blocks may remain in use.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      A slab having a non-zero length was mapped from the operating system.
+ */
+void MemoryManager::ReleaseSlabs(std::size_t index,
+                                 const std::vector<SlabRecord> &released)
+{
+    for (const SlabRecord &record : released)
+    {
+        if (options.compact_headers && options.free_any)
+        {
+            UnregisterSlab(record.slab);
+        }
+
+        if (record.length > 0)
+        {
+            UnmapMemory(record.slab, record.length);
+        }
+        else
+        {
+            DeleteMemory(record.slab, layouts[index].slab_alignment);
+        }
+
+        // Count each slab freed when collecting diagnostics
+        if constexpr (Diagnostics_Enabled)
+        {
+            diagnostics[index].heap_frees.fetch_add(
+                1,
+                std::memory_order_relaxed);
+        }
+    }
+}
+
+/*
+ *  MemoryManager::LockFreeAllocate()
+ *
+ *  Description:
+ *      Allocate memory of the requested size using the lock-free engine.
+ *      Descriptors are searched in the same order as with Allocate().
+ *
+ *  Parameters:
+ *      size [in]
+ *          The size of the memory requested.
+ *
+ *      alignment [in]
+ *          The required alignment of the memory (or 0 if none).
+ *
+ *  Returns:
+ *      A pointer to a block of memory the user may use or nullptr if the
+ *      request could not be satisfied.
+ *
+ *  Comments:
+ *      None.
+ */
+void *MemoryManager::LockFreeAllocate(std::size_t size,
+                                      std::size_t alignment)
+{
+    // Iterate over each descriptor in the profile for available memory,
+    // starting with the first that might be large enough
+    std::size_t first = profile.size();
+    std::size_t spills = 0;
+    for (std::size_t index = size_classes[SizeClass(size)];
+         index < profile.size();
+         index++)
+    {
+        // If the descriptor indicates memory is too small or insufficiently
+        // aligned, keep looking
+        if ((profile[index].size < size) ||
+            (layouts[index].alignment < alignment))
+        {
+            continue;
+        }
+
+        // Use a larger descriptor only as the first descriptor's policy allows
+        if (first == profile.size())
+        {
+            first = index;
+        }
+        else if (SpillAllowance(first, ++spills) == 0)
+        {
+            break;
+        }
+
+        StatisticsCounters &counters = statistics[index];
+
+        // Take a block from the stack or, failing that, from the heap
+        std::uint8_t *block = PopFreeBlock(index);
+        if (block == nullptr) block = LockFreeCreateBlock(index);
+        if (block == nullptr)
+        {
+            // Note a fulfillment attempt failed
+            AtomicCount(counters.unfulfilled);
+            continue;
+        }
+
+        // Update various statistics
+        if constexpr (Statistics_Enabled)
+        {
+            counters.allocations.fetch_add(1, std::memory_order_relaxed);
+            AtomicMaximum(counters.max_outstanding,
+                          counters.outstanding.fetch_add(
+                              1,
+                              std::memory_order_relaxed) + 1);
+        }
+        if (index != first) RecordSpill(first, index, block);
+
+        // Return a pointer to the data just after the MemoryHeader
+        return GetDataPointer(layouts[index], block);
+    }
+
+    return nullptr;
+}
+
+/*
+ *  MemoryManager::LockFreeFree()
+ *
+ *  Description:
+ *      Return a validated memory block using the lock-free engine.  Blocks
+ *      retained by the pool are placed back onto the stack, while others are
+ *      retained if the maximum has not been reached or freed to the heap.
+ *
+ *  Parameters:
+ *      block [in]
+ *          The memory block (i.e., header location) being freed.
+ *
+ *      index [in]
+ *          The profile index to which the block belongs.
+ *
+ *      bad_block [in]
+ *          True if the block was found to be corrupt.
+ *
+ *  Returns:
+ *      True, as the block is always accepted.
+ *
+ *  Comments:
+ *      Once a block has been placed onto a stack, it is never freed to the
+ *      heap until the Memory Manager is destroyed.  This ensures that another
+ *      thread reading the next pointer in a block's header during a
+ *      concurrent pop never touches memory that was returned to the heap.
+ */
+bool MemoryManager::LockFreeFree(std::uint8_t *block,
+                                 std::size_t index,
+                                 bool bad_block)
+{
+    LockFreeBucket &bucket = lock_free_buckets[index];
+    StatisticsCounters &counters = statistics[index];
+
+    // Update statistics
+    if constexpr (Statistics_Enabled)
+    {
+        counters.deallocations.fetch_add(1, std::memory_order_relaxed);
+        std::uint64_t outstanding =
+            counters.outstanding.load(std::memory_order_relaxed);
+        while ((outstanding > 0) &&
+               !counters.outstanding.compare_exchange_weak(
+                   outstanding,
+                   outstanding - 1,
+                   std::memory_order_relaxed))
+        {
+        }
+    }
+
+    // If the block is bad, update statistics and discard the block
+    if (bad_block)
+    {
+        AtomicCount(counters.corruption_count);
+        bucket.total.fetch_sub(1, std::memory_order_relaxed);
+
+        // Pooled blocks are not freed until destruction (see above)
+        if (IsPooled(index, block))
+        {
+            bucket.pooled.fetch_sub(1, std::memory_order_relaxed);
+            const std::lock_guard<std::mutex> lock(mutex);
+            quarantine.emplace_back(index, block);
+        }
+        else
+        {
+            DeleteBlock(index, block);
+        }
+        return true;
+    }
+
+    // If the block is not yet pooled, try to reserve space in the pool
+    if (!IsPooled(index, block))
+    {
+        std::size_t pooled = bucket.pooled.load(std::memory_order_relaxed);
+        do
+        {
+            // If the pool is full, free the block to the heap
+            if ((profile[index].maximum != 0) &&
+                (pooled >= profile[index].maximum))
+            {
+                bucket.total.fetch_sub(1, std::memory_order_relaxed);
+                DeleteBlock(index, block);
+                return true;
+            }
+        } while (!bucket.pooled.compare_exchange_weak(
+            pooled,
+            pooled + 1,
+            std::memory_order_relaxed));
+
+        SetPooled(index, block);
+    }
+
+    // Place the block onto the stack
+    PushFreeBlock(index, block);
+
+    // Order the push before Free() reads the waiting count; paired with the
+    // fence in EnqueueWaiter(), either a request that begins waiting finds
+    // the block or Free() observes the waiting request
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    return true;
+}
+
+/*
+ *  MemoryManager::LockFreeCreateBlock()
+ *
+ *  Description:
+ *      Allocate a new block from the heap for the given profile index for
+ *      use with the lock-free engine.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The index into the profile vector for which a memory allocation
+ *          is to be made.
+ *
+ *  Returns:
+ *      A pointer to the new block or nullptr if the block could not be
+ *      allocated.
+ *
+ *  Comments:
+ *      Slabs are used only for blocks pre-allocated during construction,
+ *      since adding a slab would require serializing access to the list of
+ *      slabs on the allocation path.
+ */
+std::uint8_t *MemoryManager::LockFreeCreateBlock(std::size_t index)
+{
+    LockFreeBucket &bucket = lock_free_buckets[index];
+
+    // Reserve the block, ensuring that any constraints are observed
+    std::size_t total = bucket.total.load(std::memory_order_relaxed);
+    do
+    {
+        // Perform no allocation if beyond constraints
+        if ((profile[index].maximum != 0) && (!profile[index].excess_allowed) &&
+            (total >= profile[index].maximum))
+        {
+            return nullptr;
+        }
+    } while (!bucket.total.compare_exchange_weak(total,
+                                                 total + 1,
+                                                 std::memory_order_relaxed));
+
+    // Allocate the requested memory block
+    std::uint8_t *block = CreateBlock(index);
+    if (block == nullptr)
+    {
+        bucket.total.fetch_sub(1, std::memory_order_relaxed);
+        logger->error << "Failed to allocate heap memory" << std::flush;
+        return nullptr;
+    }
+
+    return block;
+}
+
+/*
+ *  MemoryManager::PushFreeBlock()
+ *
+ *  Description:
+ *      Push a free block onto the lock-free stack for the given profile index.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index to which the block belongs.
+ *
+ *      block [in]
+ *          The memory block to push onto the stack.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void MemoryManager::PushFreeBlock(std::size_t index, std::uint8_t *block)
+{
+    auto &head = lock_free_buckets[index].head;
+    const std::atomic_ref<std::uint8_t *> next(*GetNextLink(index, block));
+
+    TaggedPointer current = head.load(std::memory_order_relaxed);
+    TaggedPointer replacement{};
+    do
+    {
+        next.store(current.block, std::memory_order_relaxed);
+        replacement = {block, current.tag + 1};
+    } while (!head.compare_exchange_weak(current,
+                                         replacement,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed));
+}
+
+/*
+ *  MemoryManager::PopFreeBlock()
+ *
+ *  Description:
+ *      Pop a free block from the lock-free stack for the given profile index.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index from which a block is needed.
+ *
+ *  Returns:
+ *      A pointer to the block or nullptr if the stack is empty.
+ *
+ *  Comments:
+ *      None.
+ */
+std::uint8_t *MemoryManager::PopFreeBlock(std::size_t index)
+{
+    auto &head = lock_free_buckets[index].head;
+
+    TaggedPointer current = head.load(std::memory_order_acquire);
+    TaggedPointer replacement{};
+    do
+    {
+        if (current.block == nullptr) return nullptr;
+
+        const std::atomic_ref<std::uint8_t *> next(
+            *GetNextLink(index, current.block));
+        replacement = {next.load(std::memory_order_relaxed), current.tag + 1};
+    } while (!head.compare_exchange_weak(current,
+                                         replacement,
+                                         std::memory_order_acquire,
+                                         std::memory_order_acquire));
+
+    return current.block;
+}
+
+/*
+ *  MemoryManager::CacheAllocate()
+ *
+ *  Description:
+ *      Allocate memory of the requested size from the calling thread's cache,
+ *      refilling the cache from the shared pool as necessary.  Descriptors
+ *      are searched in the same order as with Allocate().
+ *
+ *  Parameters:
+ *      size [in]
+ *          The size of the memory requested.
+ *
+ *      alignment [in]
+ *          The required alignment of the memory (or 0 if none).
+ *
+ *  Returns:
+ *      A pointer to a block of memory the user may use or nullptr if the
+ *      request could not be satisfied.
+ *
+ *  Comments:
+ *      The pool is locked only if the cache must be refilled.
+ */
+void *MemoryManager::CacheAllocate(std::size_t size, std::size_t alignment)
+{
+    ThreadCache *cache = GetThreadCache();
+
+    // Iterate over each descriptor in the profile for available memory,
+    // starting with the first that might be large enough
+    std::size_t first = profile.size();
+    std::size_t spills = 0;
+    for (std::size_t index = size_classes[SizeClass(size)];
+         index < profile.size();
+         index++)
+    {
+        // If the descriptor indicates memory is too small or insufficiently
+        // aligned, keep looking
+        if ((profile[index].size < size) ||
+            (layouts[index].alignment < alignment))
+        {
+            continue;
+        }
+
+        // Use a larger descriptor only as the first descriptor's policy allows
+        if (first == profile.size())
+        {
+            first = index;
+        }
+        else if (SpillAllowance(first, ++spills) == 0)
+        {
+            break;
+        }
+
+        // If the cache is empty and cannot be refilled with blocks freed by
+        // other threads or from the shared pool, keep looking
+        auto &blocks = cache->blocks[index];
+        if (blocks.empty() &&
+            !CollectRemoteBlocks(*cache, cache->queue, index) &&
+            !RefillThreadCache(*cache, index, true))
+        {
+            continue;
+        }
+
+        // Take a block from the cache
+        std::uint8_t *block = TakeCachedBlock(*cache, index);
+
+        // Record the queue to which other threads should return the block
+        if (options.remote_free)
+        {
+            GetMemoryHeader(layouts[index], block)->owner = cache->queue;
+        }
+        if (index != first) RecordSpill(first, index, block);
+
+        // Return a pointer to the data just after the MemoryHeader
+        return GetDataPointer(layouts[index], block);
+    }
+
+    return nullptr;
+}
+
+/*
+ *  MemoryManager::CacheFree()
+ *
+ *  Description:
+ *      Return a validated memory block to the calling thread's cache,
+ *      flushing excess blocks to the shared pool if the cache has grown
+ *      beyond the high watermark.
+ *
+ *  Parameters:
+ *      block [in]
+ *          The memory block (i.e., header location) being freed.
+ *
+ *      index [in]
+ *          The profile index to which the block belongs.
+ *
+ *      bad_block [in]
+ *          True if the block was found to be corrupt.
+ *
+ *  Returns:
+ *      True, as the block is always accepted.
+ *
+ *  Comments:
+ *      The pool is locked only if the cache must be flushed or the block
+ *      is corrupt.  When using remote frees, a block allocated by another
+ *      thread is placed on that thread's remote queue instead.
+ */
+bool MemoryManager::CacheFree(std::uint8_t *block,
+                              std::size_t index,
+                              bool bad_block)
+{
+    ThreadCache *cache = GetThreadCache();
+
+    // Return a block allocated by another thread to that thread's queue,
+    // unless a request is waiting for the block or the thread has exited
+    if (options.remote_free && !bad_block &&
+        (wait_queues[index].waiting.load(std::memory_order_relaxed) == 0))
+    {
+        const std::size_t owner = GetMemoryHeader(layouts[index], block)->owner;
+        if ((owner != cache->queue) && (owner != No_Remote_Queue) &&
+            !RemoteQueueOrphaned(owner))
+        {
+            // Only this thread writes the counter, so no atomic RMW is needed
+            Count(cache->counters[index].deallocations);
+            PushRemoteBlock(owner, index, block);
+
+            // If the queue was orphaned while the block was being placed onto
+            // it, take the queued blocks so they are not stranded; the fence
+            // pairs with the one in ReleaseThreadCache()
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (RemoteQueueOrphaned(owner) &&
+                CollectRemoteBlocks(*cache, owner, index) &&
+                (cache->blocks[index].size() > options.cache_high_watermark))
+            {
+                FlushThreadCache(*cache, index, options.cache_low_watermark);
+            }
+
+            return true;
+        }
+    }
+
+    ReturnCachedBlock(*cache, block, index, bad_block);
+
+    return true;
+}
+
+/*
+ *  MemoryManager::TakeCachedBlock()
+ *
+ *  Description:
+ *      Remove a block for the given profile index from a thread cache or
+ *      stripe, counting the allocation.
+ *
+ *  Parameters:
+ *      cache [in]
+ *          The thread cache or stripe's cache holding the block.
+ *
+ *      index [in]
+ *          The profile index for which a block is needed.
+ *
+ *  Returns:
+ *      A pointer to the block.
+ *
+ *  Comments:
+ *      The cache MUST hold at least one block for the profile index.  Only
+ *      one thread may use the cache at a time.
+ */
+std::uint8_t *MemoryManager::TakeCachedBlock(ThreadCache &cache,
+                                             std::size_t index)
+{
+    // Only one thread writes the counters, so no atomic RMW is needed
+    if constexpr (Statistics_Enabled)
+    {
+        auto &counters = cache.counters[index];
+        const std::uint64_t allocated =
+            counters.allocations.load(std::memory_order_relaxed) + 1;
+        counters.allocations.store(allocated, std::memory_order_relaxed);
+
+        // Track the peak number of blocks allocated since the last fold
+        const auto net = static_cast<std::int64_t>(
+            allocated -
+            counters.deallocations.load(std::memory_order_relaxed));
+        if (net > counters.peak.load(std::memory_order_relaxed))
+        {
+            counters.peak.store(net, std::memory_order_relaxed);
+        }
+    }
+
+    // Grab a memory block off the back
+    auto &blocks = cache.blocks[index];
+    std::uint8_t *block = blocks.back();
+    blocks.pop_back();
+
+    return block;
+}
+
+/*
+ *  MemoryManager::ReturnCachedBlock()
+ *
+ *  Description:
+ *      Place a freed block into a thread cache or stripe, counting the
+ *      deallocation and flushing excess blocks to the shared pool if the
+ *      cache has grown beyond the high watermark.
+ *
+ *  Parameters:
+ *      cache [in]
+ *          The thread cache or stripe's cache to receive the block.
+ *
+ *      block [in]
+ *          The memory block being freed.
+ *
+ *      index [in]
+ *          The profile index to which the block belongs.
+ *
+ *      bad_block [in]
+ *          True if the block was found to be corrupt, in which case it is
+ *          freed to the heap.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Only one thread may use the cache at a time.
+ */
+void MemoryManager::ReturnCachedBlock(ThreadCache &cache,
+                                      std::uint8_t *block,
+                                      std::size_t index,
+                                      bool bad_block)
+{
+    // Only one thread writes the counter, so no atomic RMW is needed
+    Count(cache.counters[index].deallocations);
+
+    // If the block is bad, update statistics, delete, and return to heap
+    if (bad_block)
+    {
+        {
+            const std::lock_guard<PoolMutex> lock(pool_locks[index].mutex);
+            Count(statistics[index].corruption_count);
+            held[index]--;
+        }
+        DeleteBlock(index, block);
+        return;
+    }
+
+    // Place the block in the cache, flushing if over the high watermark or
+    // entirely if requests are waiting so that the blocks may be handed over
+    cache.blocks[index].push_back(block);
+    if (wait_queues[index].waiting.load(std::memory_order_relaxed) > 0)
+    {
+        FlushThreadCache(cache, index, 0);
+    }
+    else if (cache.blocks[index].size() > options.cache_high_watermark)
+    {
+        FlushThreadCache(cache, index, options.cache_low_watermark);
+    }
+}
+
+/*
+ *  MemoryManager::GetThreadCache()
+ *
+ *  Description:
+ *      Get the calling thread's cache for this Memory Manager, creating it
+ *      if it does not yet exist.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A pointer to the calling thread's cache.
+ *
+ *  Comments:
+ *      None.
+ */
+ThreadCache *MemoryManager::GetThreadCache()
+{
+    auto &entries = Thread_Caches.entries;
+
+    // Look for an existing cache for this Memory Manager
+    for (const auto &entry : entries)
+    {
+        if (entry.registry == cache_registry) return entry.cache.get();
+    }
+
+    // Discard caches of Memory Manager objects that no longer exist
+    std::erase_if(entries,
+                  [](const ThreadCacheEntry &entry)
+                  {
+                      const std::lock_guard<std::mutex> lock(
+                          entry.registry->mutex);
+                      return entry.registry->owner == nullptr;
+                  });
+
+    // Create a new cache for this thread
+    auto cache = std::make_unique<ThreadCache>();
+    cache->blocks.resize(profile.size());
+    cache->counters = std::vector<ThreadCacheCounters>(profile.size());
+
+    // Reserve space so that refilling the cache does not allocate memory
+    // while the pool lock is held
+    for (auto &blocks : cache->blocks)
+    {
+        blocks.reserve(options.cache_high_watermark + 1);
+    }
+
+    // Register the cache so statistics and blocks can be reclaimed
+    {
+        const std::lock_guard<std::mutex> lock(cache_registry->mutex);
+        thread_caches.push_back(cache.get());
+
+        // Threads share the remote queues if there are more threads
+        cache->queue = next_remote_queue++ % Remote_Queue_Count;
+        if (options.remote_free)
+        {
+            remote_queues[cache->queue].users.fetch_add(
+                1,
+                std::memory_order_relaxed);
+        }
+    }
+
+    ThreadCache *result = cache.get();
+    entries.push_back({cache_registry, std::move(cache)});
+
+    return result;
+}
+
+/*
+ *  MemoryManager::RefillThreadCache()
+ *
+ *  Description:
+ *      Move up to cache_low_watermark blocks for the given profile index
+ *      from the shared pool into the thread cache, allocating a new block
+ *      from the heap if the shared pool is empty.
+ *
+ *  Parameters:
+ *      cache [in]
+ *          The calling thread's cache.
+ *
+ *      index [in]
+ *          The profile index for which blocks are needed.
+ *
+ *      allocate [in]
+ *          True if a block may be allocated from the heap when the shared
+ *          pool is empty.  If false, a failure is not counted as an
+ *          unfulfilled request.
+ *
+ *  Returns:
+ *      True if at least one block was placed into the cache, false if not.
+ *
+ *  Comments:
+ *      This is also used to refill the cache of a stripe.
+ */
+bool MemoryManager::RefillThreadCache(ThreadCache &cache,
+                                      std::size_t index,
+                                      bool allocate)
+{
+    // Lock the descriptor's pool
+    const std::lock_guard<PoolMutex> lock(pool_locks[index].mutex);
+
+    // Fold this thread's statistics into the shared statistics
+    FoldThreadCounters(cache, index);
+
+    // If no memory blocks are available and allocation fails, give up
+    if ((allocations[index].count == 0) &&
+        (!allocate || !ReplenishPool(index)))
+    {
+        // Note a fulfillment attempt failed
+        if (allocate) Count(statistics[index].unfulfilled);
+        return false;
+    }
+
+    // Move a batch of blocks from the shared pool into the cache
+    FreeList &shared = allocations[index];
+    const std::size_t count =
+        std::min(shared.count, options.cache_low_watermark);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        cache.blocks[index].push_back(PopListBlock(shared, index));
+    }
+    held[index] += count;
+    held_peak[index] = std::max(held[index], held_peak[index]);
+    activity[index].takes++;
+
+    // Have the pool refilled in the background when running low
+    if (options.replenish && (shared.count < options.replenish_watermark))
+    {
+        WakeReplenisher();
+    }
+
+    return true;
+}
+
+/*
+ *  MemoryManager::FlushThreadCache()
+ *
+ *  Description:
+ *      Move blocks for the given profile index from the thread cache to the
+ *      shared pool, freeing to the heap any blocks beyond the maximum.
+ *
+ *  Parameters:
+ *      cache [in]
+ *          The thread cache to flush.
+ *
+ *      index [in]
+ *          The profile index of the blocks to flush.
+ *
+ *      retain [in]
+ *          The number of blocks to leave in the thread cache.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void MemoryManager::FlushThreadCache(ThreadCache &cache,
+                                     std::size_t index,
+                                     std::size_t retain)
+{
+    // Lock the descriptor's pool
+    const std::lock_guard<PoolMutex> lock(pool_locks[index].mutex);
+
+    // Fold this thread's statistics into the shared statistics
+    FoldThreadCounters(cache, index);
+
+    // Return blocks to the shared pool, if possible else free to the heap
+    auto &blocks = cache.blocks[index];
+    while (blocks.size() > retain)
+    {
+        std::uint8_t *block = blocks.back();
+        blocks.pop_back();
+        held[index]--;
+
+        ReturnBlock(index, block);
+    }
+}
+
+/*
+ *  MemoryManager::FoldThreadCounters()
+ *
+ *  Description:
+ *      Move the statistics counted by a thread cache for the given profile
+ *      index into the shared statistics.
+ *
+ *  Parameters:
+ *      cache [in]
+ *          The thread cache holding the counters.
+ *
+ *      index [in]
+ *          The profile index of the counters to fold.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The pool lock for the profile index MUST be held by the calling
+ *      function.  This must only be called by the thread owning the cache
+ *      (or holding the stripe's lock) or while the cache cannot be in use.
+ */
+void MemoryManager::FoldThreadCounters(ThreadCache &cache, std::size_t index)
+{
+    const std::uint64_t allocated =
+        cache.counters[index].allocations.exchange(0,
+                                                   std::memory_order_relaxed);
+    const std::uint64_t deallocated =
+        cache.counters[index].deallocations.exchange(0,
+                                                     std::memory_order_relaxed);
+
+    const std::int64_t peak =
+        cache.counters[index].peak.exchange(0, std::memory_order_relaxed);
+
+    StatisticsCounters &counters = statistics[index];
+
+    // The peak was reached relative to the previously folded count
+    CountMaximum(counters.max_outstanding,
+                 PeakOutstanding(
+                     counters.outstanding.load(std::memory_order_relaxed),
+                     peak));
+
+    Count(counters.allocations, allocated);
+    Count(counters.deallocations, deallocated);
+
+    // The outstanding count uses modular arithmetic, since a block might be
+    // freed by a thread that has not folded the corresponding allocation
+    Count(counters.outstanding, allocated - deallocated);
+}
+
+/*
+ *  MemoryManager::PushRemoteBlock()
+ *
+ *  Description:
+ *      Place a block freed by a thread other than the one that allocated it
+ *      onto the allocating thread's remote queue.
+ *
+ *  Parameters:
+ *      queue [in]
+ *          The remote queue of the thread that allocated the block.
+ *
+ *      index [in]
+ *          The profile index to which the block belongs.
+ *
+ *      block [in]
+ *          The memory block being freed.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The block remains counted as held until it is collected and
+ *      returned to the shared pool.
+ */
+void MemoryManager::PushRemoteBlock(std::size_t queue,
+                                    std::size_t index,
+                                    std::uint8_t *block)
+{
+    auto &head = remote_queues[queue].heads[index];
+    const std::atomic_ref<std::uint8_t *> next(*GetNextLink(index, block));
+
+    std::uint8_t *current = head.load(std::memory_order_relaxed);
+    do
+    {
+        next.store(current, std::memory_order_relaxed);
+    } while (!head.compare_exchange_weak(current,
+                                         block,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed));
+}
+
+/*
+ *  MemoryManager::RemoteQueueOrphaned()
+ *
+ *  Description:
+ *      Determine whether every thread using the given remote queue has
+ *      exited, in which case no thread will collect blocks placed onto it.
+ *
+ *  Parameters:
+ *      queue [in]
+ *          The remote queue to check.
+ *
+ *  Returns:
+ *      True if the queue is orphaned, false if not.
+ *
+ *  Comments:
+ *      A thread created later may be assigned the queue again.
+ */
+bool MemoryManager::RemoteQueueOrphaned(std::size_t queue) const
+{
+    return remote_queues[queue].users.load(std::memory_order_relaxed) == 0;
+}
+
+/*
+ *  MemoryManager::CollectRemoteBlocks()
+ *
+ *  Description:
+ *      Move all blocks for the given profile index that other threads have
+ *      placed onto the given remote queue into the thread cache.
+ *
+ *  Parameters:
+ *      cache [in]
+ *          The calling thread's cache.
+ *
+ *      queue [in]
+ *          The remote queue from which to collect, which is the cache's own
+ *          queue unless that queue has been orphaned.
+ *
+ *      index [in]
+ *          The profile index for which blocks are needed.
+ *
+ *  Returns:
+ *      True if at least one block was placed into the cache, false if not.
+ *
+ *  Comments:
+ *      The entire queue is taken in a single exchange, so several threads
+ *      sharing a queue may collect from it safely.
+ */
+bool MemoryManager::CollectRemoteBlocks(ThreadCache &cache,
+                                        std::size_t queue,
+                                        std::size_t index)
+{
+    if (!options.remote_free) return false;
+
+    auto &head = remote_queues[queue].heads[index];
+
+    // Avoid the exchange if the queue is empty
+    if (head.load(std::memory_order_relaxed) == nullptr) return false;
+
+    std::uint8_t *block = head.exchange(nullptr, std::memory_order_acquire);
+    auto &blocks = cache.blocks[index];
+    while (block != nullptr)
+    {
+        blocks.push_back(block);
+        block = *GetNextLink(index, block);
+    }
+
+    return !blocks.empty();
+}
+
+/*
+ *  MemoryManager::ReleaseThreadCache()
+ *
+ *  Description:
+ *      Return all blocks held by a thread cache, including those on its
+ *      remote queue, to the shared pool and stop tracking the cache.
+ *
+ *  Parameters:
+ *      cache [in]
+ *          The thread cache to release.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The registry mutex MUST be locked by the calling function.  If no
+ *      other thread uses the remote queue, the queue is marked as orphaned
+ *      so that blocks freed later are not placed onto it.
+ */
+void MemoryManager::ReleaseThreadCache(ThreadCache *cache)
+{
+    // Stop using the remote queue before collecting from it; the fence
+    // pairs with the one in CacheFree()
+    if (options.remote_free)
+    {
+        remote_queues[cache->queue].users.fetch_sub(1,
+                                                   std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    for (std::size_t index = 0; index < profile.size(); index++)
+    {
+        CollectRemoteBlocks(*cache, cache->queue, index);
+        FlushThreadCache(*cache, index, 0);
+    }
+
+    std::erase(thread_caches, cache);
+}
+
+/*
+ *  MemoryManager::StripeAllocate()
+ *
+ *  Description:
+ *      Take a block for the given striped profile index from the calling
+ *      thread's stripe, refilling the stripe from the shared pool, from
+ *      another stripe, or from the heap as necessary.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index for which a block is needed.
+ *
+ *  Returns:
+ *      A pointer to the block or nullptr if one could not be obtained.
+ *
+ *  Comments:
+ *      Blocks are taken from another stripe before allocating from the heap
+ *      so that stripes do not hold blocks that other threads cannot use.
+ */
+std::uint8_t *MemoryManager::StripeAllocate(std::size_t index)
+{
+    const std::size_t selected = Stripe_Thread % stripes[index].size();
+    PoolStripe &stripe = stripes[index][selected];
+
+    // Lock the stripe
+    const std::lock_guard<PoolMutex> lock(stripe.mutex);
+
+    // If the stripe is empty and cannot be refilled, give up
+    if (stripe.cache.blocks[index].empty() &&
+        !RefillThreadCache(stripe.cache, index, false) &&
+        !StealBlocks(index, selected) &&
+        !RefillThreadCache(stripe.cache, index, true))
+    {
+        return nullptr;
+    }
+
+    return TakeCachedBlock(stripe.cache, index);
+}
+
+/*
+ *  MemoryManager::StripeFree()
+ *
+ *  Description:
+ *      Return a validated memory block for the given striped profile index
+ *      to the calling thread's stripe.
+ *
+ *  Parameters:
+ *      block [in]
+ *          The memory block (i.e., header location) being freed.
+ *
+ *      index [in]
+ *          The profile index to which the block belongs.
+ *
+ *      bad_block [in]
+ *          True if the block was found to be corrupt.
+ *
+ *  Returns:
+ *      True, as the block is always accepted.
+ *
+ *  Comments:
+ *      None.
+ */
+bool MemoryManager::StripeFree(std::uint8_t *block,
+                               std::size_t index,
+                               bool bad_block)
+{
+    PoolStripe &stripe =
+        stripes[index][Stripe_Thread % stripes[index].size()];
+
+    // Lock the stripe
+    const std::lock_guard<PoolMutex> lock(stripe.mutex);
+
+    ReturnCachedBlock(stripe.cache, block, index, bad_block);
+
+    return true;
+}
+
+/*
+ *  MemoryManager::StealBlocks()
+ *
+ *  Description:
+ *      Move half of the blocks held by another stripe for the given profile
+ *      index into the selected stripe.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index for which blocks are needed.
+ *
+ *      selected [in]
+ *          The stripe receiving the blocks, whose lock MUST be held by the
+ *          calling function.
+ *
+ *  Returns:
+ *      True if at least one block was moved, false if not.
+ *
+ *  Comments:
+ *      Other stripes are only examined if their lock is available, so two
+ *      threads stealing from each other's stripes cannot deadlock.
+ */
+bool MemoryManager::StealBlocks(std::size_t index, std::size_t selected)
+{
+    auto &stripe_set = stripes[index];
+    auto &blocks = stripe_set[selected].cache.blocks[index];
+
+    for (std::size_t i = 1; i < stripe_set.size(); i++)
+    {
+        PoolStripe &other = stripe_set[(selected + i) % stripe_set.size()];
+
+        const std::unique_lock<PoolMutex> lock(other.mutex, std::try_to_lock);
+        if (!lock.owns_lock()) continue;
+
+        auto &other_blocks = other.cache.blocks[index];
+        if (other_blocks.empty()) continue;
+
+        // Take the more recently freed half of the other stripe's blocks
+        const std::size_t count = (other_blocks.size() + 1) / 2;
+        const auto first =
+            std::prev(other_blocks.end(), PointerDiff(count));
+        blocks.insert(blocks.end(), first, other_blocks.end());
+        other_blocks.erase(first, other_blocks.end());
+
+        return true;
+    }
+
+    return false;
+}
+
+/*
+ *  MemoryManager::SpillAllowance()
+ *
+ *  Description:
+ *      Determine how many blocks a request may take from a larger descriptor
+ *      than the first descriptor large enough to satisfy it, according to
+ *      the spill policy of the first descriptor.
+ *
+ *  Parameters:
+ *      first [in]
+ *          The profile index of the first descriptor large enough to satisfy
+ *          the request.
+ *
+ *      spills [in]
+ *          The number of larger descriptors tried so far, including the one
+ *          about to be tried.
+ *
+ *  Returns:
+ *      The number of blocks that may be taken, which is 0 if the request may
+ *      not spill to the descriptor about to be tried.
+ *
+ *  Comments:
+ *      Outstanding spilled blocks are counted without holding any lock, so
+ *      concurrent requests may briefly exceed a spill budget.
+ */
+std::size_t MemoryManager::SpillAllowance(std::size_t first,
+                                          std::size_t spills) const
+{
+    const MemoryDescriptor &descriptor = profile[first];
+
+    switch (descriptor.spill)
+    {
+        case SpillPolicy::Never:
+            return 0;
+
+        case SpillPolicy::Limited:
+            return (spills <= descriptor.spill_limit) ?
+                       std::numeric_limits<std::size_t>::max() :
+                       0;
+
+        case SpillPolicy::Budget:
+        {
+            const std::size_t outstanding =
+                spill_outstanding[first].load(std::memory_order_relaxed);
+            return (outstanding < descriptor.spill_limit) ?
+                       descriptor.spill_limit - outstanding :
+                       0;
+        }
+
+        default:
+            return std::numeric_limits<std::size_t>::max();
+    }
+}
+
+/*
+ *  MemoryManager::RecordSpill()
+ *
+ *  Description:
+ *      Note that a request was satisfied by a larger descriptor than the
+ *      first descriptor large enough to satisfy it.
+ *
+ *  Parameters:
+ *      first [in]
+ *          The profile index of the first descriptor large enough to satisfy
+ *          the request.
+ *
+ *      index [in]
+ *          The profile index of the descriptor that satisfied the request.
+ *
+ *      block [in]
+ *          The memory block given to the user.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      When the first descriptor has a spill budget, the block's header
+ *      records the descriptor so that Free() returns the budget.
+ */
+void MemoryManager::RecordSpill(std::size_t first,
+                                std::size_t index,
+                                std::uint8_t *block)
+{
+    AtomicCount(statistics[first].spilled);
+
+    if (profile[first].spill != SpillPolicy::Budget) return;
+
+    spill_outstanding[first].fetch_add(1, std::memory_order_relaxed);
+    GetMemoryHeader(layouts[index], block)->spill = first + 1;
+}
+
+/*
+ *  MemoryManager::ReleaseSpill()
+ *
+ *  Description:
+ *      Return the spill budget used by a block being freed, if any.
  *
  *  Parameters:
- *      None.
+ *      index [in]
+ *          The profile index to which the block belongs.
+ *
+ *      block [in]
+ *          The memory block being freed.
  *
  *  Returns:
- *      The Memory Manager Statistics structure containing the current
- *      statistics information.
+ *      Nothing.
  *
  *  Comments:
- *      None.
+ *      Spill budgets are not used with compact headers.
  */
-std::vector<Statistics> MemoryManager::GetStatistics() const
+void MemoryManager::ReleaseSpill(std::size_t index, std::uint8_t *block)
 {
-    const std::lock_guard<std::mutex> lock(mutex);
+    if (options.compact_headers) return;
 
-    return statistics;
+    MemoryHeader *header = GetMemoryHeader(layouts[index], block);
+    if (header->spill == 0) return;
+
+    // Ignore the value if the header is corrupt
+    if ((header->spill <= profile.size()) &&
+        (spill_outstanding[header->spill - 1].load(
+             std::memory_order_relaxed) > 0))
+    {
+        spill_outstanding[header->spill - 1].fetch_sub(
+            1,
+            std::memory_order_relaxed);
+    }
+    header->spill = 0;
 }
 
 /*
- *  MemoryManager::PerformAllocation()
+ *  MemoryManager::PoisonBlock()
  *
  *  Description:
- *      Allocate a block of memory for the given profile index.
+ *      Fill the user data of a block being freed with a recognizable value
+ *      when using ValidationPolicy::Debug, so that use of the memory after
+ *      it is freed is apparent.
  *
  *  Parameters:
  *      index [in]
- *          The index into the profile vector for which a memory allocation
- *          is to be made.
+ *          The profile index to which the block belongs.
+ *
+ *      block [in]
+ *          The memory block being freed.
  *
  *  Returns:
- *      True if successful, false if not.
+ *      Nothing.
  *
  *  Comments:
- *      The mutex MUST be locked by the calling function.
+ *      Debug validation is not used with compact headers, so the free list
+ *      link in the block header is unaffected.
  */
-bool MemoryManager::PerformAllocation(std::size_t index)
+void MemoryManager::PoisonBlock(std::size_t index, std::uint8_t *block)
 {
-    // Perform no allocation if beyond constraints
-    if ((profile[index].maximum != 0) && (!profile[index].excess_allowed) &&
-        ((allocations[index].size() + statistics[index].outstanding) >=
-         profile[index].maximum))
+    if (options.validation != ValidationPolicy::Debug) return;
+
+    std::memset(GetDataPointer(layouts[index], block),
+                Freed_Poison,
+                profile[index].size);
+}
+
+/*
+ *  MemoryManager::FindDescriptor()
+ *
+ *  Description:
+ *      Locate the first descriptor in the profile large enough to satisfy a
+ *      request of the given size.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The size of the memory requested.
+ *
+ *  Returns:
+ *      The profile index of the descriptor or the number of descriptors in
+ *      the profile if none is large enough.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t MemoryManager::FindDescriptor(std::size_t size) const
+{
+    std::size_t index = size_classes[SizeClass(size)];
+    while ((index < profile.size()) && (profile[index].size < size)) index++;
+
+    return index;
+}
+
+/*
+ *  MemoryManager::EnqueueWaiter()
+ *
+ *  Description:
+ *      Place a request in the queue of requests waiting for a block of the
+ *      first descriptor large enough to satisfy it, unless a block of that
+ *      descriptor is available.
+ *
+ *  Parameters:
+ *      waiter [in/out]
+ *          The waiting request, which receives the block if one is available.
+ *
+ *      size [in]
+ *          The size of the memory requested.
+ *
+ *  Returns:
+ *      True if the request was placed in the queue, false if it was
+ *      satisfied immediately or no descriptor is large enough (in which case
+ *      the block given to the waiter is nullptr).
+ *
+ *  Comments:
+ *      Once placed in the queue, the waiter is notified by releasing its
+ *      semaphore or resuming its coroutine.  Checking for available blocks
+ *      after the waiting count is raised ensures that a block freed
+ *      concurrently is not missed, as the lock-free engine issues a
+ *      sequentially consistent fence after each free before reading the
+ *      waiting count.
+ */
+bool MemoryManager::EnqueueWaiter(AllocationWaiter &waiter, std::size_t size)
+{
+    waiter.next = nullptr;
+    waiter.block = nullptr;
+    waiter.granted = false;
+
+    // Locate the first descriptor large enough for the request
+    const std::size_t index = FindDescriptor(size);
+    if (index == profile.size()) return false;
+    waiter.index = index;
+
+    WaitQueue &queue = wait_queues[index];
+
+    // Lock the descriptor's pool
+    const std::lock_guard<PoolMutex> lock(pool_locks[index].mutex);
+
+    // Announce the request before checking again for a free block; the
+    // fence pairs with the one in LockFreeFree()
+    queue.waiting.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // If a block is now available, the request need not wait
+    std::uint8_t *block = TakeWaiterBlock(index);
+    if (block != nullptr)
     {
+        queue.waiting.fetch_sub(1, std::memory_order_relaxed);
+        waiter.block = GetDataPointer(layouts[index], block);
         return false;
     }
 
-    // Allocate the requested memory block
-    std::uint8_t *block = AllocateBlock(profile[index].size);
-    if (block == nullptr)
+    // Append the request to the queue
+    if (queue.tail == nullptr)
     {
-        logger->error << "Failed to allocate heap memory" << std::flush;
-        return false;
+        queue.head = &waiter;
+    }
+    else
+    {
+        queue.tail->next = &waiter;
     }
+    queue.tail = &waiter;
 
-    // Populate the header
-    MemoryHeader *header = reinterpret_cast<MemoryHeader *>(block);
-    (*header) = {};
-    header->memory_manager = this;
-    header->index = index;
-    header->marker = Header_Marker_Value;
+    return true;
+}
+
+/*
+ *  MemoryManager::WithdrawWaiter()
+ *
+ *  Description:
+ *      Remove a request from the queue of waiting requests after its wait
+ *      has ended without notification.
+ *
+ *  Parameters:
+ *      waiter [in]
+ *          The waiting request to remove.
+ *
+ *  Returns:
+ *      True if the request was removed, false if it had already been served,
+ *      in which case the notification will still be delivered and must be
+ *      awaited before the waiter is destroyed.
+ *
+ *  Comments:
+ *      None.
+ */
+bool MemoryManager::WithdrawWaiter(AllocationWaiter &waiter)
+{
+    WaitQueue &queue = wait_queues[waiter.index];
+
+    // Lock the descriptor's pool
+    const std::lock_guard<PoolMutex> lock(pool_locks[waiter.index].mutex);
 
-    // Populate the trailer
-    MemoryTrailer *trailer = reinterpret_cast<MemoryTrailer *>(
-            GetTrailerPointer(block, profile[header->index].size));
-    trailer->marker = Trailer_Marker_Value;
+    if (waiter.granted) return false;
 
-    // Place the allocated memory into the deque
-    allocations[index].push_back(block);
+    // Unlink the request from the queue
+    AllocationWaiter *previous = nullptr;
+    for (AllocationWaiter *current = queue.head; current != &waiter;)
+    {
+        previous = current;
+        current = current->next;
+    }
+    if (previous == nullptr)
+    {
+        queue.head = waiter.next;
+    }
+    else
+    {
+        previous->next = waiter.next;
+    }
+    if (queue.tail == &waiter) queue.tail = previous;
+    queue.waiting.fetch_sub(1, std::memory_order_relaxed);
 
     return true;
 }
 
+/*
+ *  MemoryManager::TakeWaiterBlock()
+ *
+ *  Description:
+ *      Take a block of the given profile index for a waiting request,
+ *      allocating from the heap if the descriptor's constraints allow.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index from which a block is needed.
+ *
+ *  Returns:
+ *      A pointer to the block or nullptr if none is available.
+ *
+ *  Comments:
+ *      The pool lock for the profile index MUST be held by the calling
+ *      function.  Unlike TakePoolBlock(), failing to find a block is not
+ *      counted as an unfulfilled request.
+ */
+std::uint8_t *MemoryManager::TakeWaiterBlock(std::size_t index)
+{
+    // Take a block from the stack when using the lock-free engine
+    if (options.lock_free)
+    {
+        std::uint8_t *block = PopFreeBlock(index);
+        if (block == nullptr) block = LockFreeCreateBlock(index);
+        if (block == nullptr) return nullptr;
+
+        // Update various statistics
+        if constexpr (Statistics_Enabled)
+        {
+            StatisticsCounters &counters = statistics[index];
+            counters.allocations.fetch_add(1, std::memory_order_relaxed);
+            AtomicMaximum(counters.max_outstanding,
+                          counters.outstanding.fetch_add(
+                              1,
+                              std::memory_order_relaxed) + 1);
+        }
+
+        return block;
+    }
+
+    // If no memory blocks are available and allocation fails, give up
+    if ((allocations[index].count == 0) && !ReplenishPool(index))
+    {
+        return nullptr;
+    }
+
+    std::uint8_t *block = TakePoolBlock(index);
+
+    // The block was not taken from a thread cache, so whichever thread frees
+    // it keeps it rather than placing it onto a remote queue
+    if ((block != nullptr) && options.remote_free)
+    {
+        GetMemoryHeader(layouts[index], block)->owner = No_Remote_Queue;
+    }
+
+    return block;
+}
+
+/*
+ *  MemoryManager::ServeWaiters()
+ *
+ *  Description:
+ *      Hand free blocks of the given profile index to waiting requests in
+ *      the order in which they began waiting, then notify those requests.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index for which blocks were freed.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This is called after a block is freed, without any pool lock held,
+ *      since resuming a coroutine may lead to further allocations.  Blocks
+ *      held in other threads' caches or in pool stripes are not seen.
+ */
+void MemoryManager::ServeWaiters(std::size_t index)
+{
+    WaitQueue &queue = wait_queues[index];
+
+    // Very likely no request is waiting
+    if (queue.waiting.load(std::memory_order_relaxed) == 0) return;
+
+    AllocationWaiter *served = nullptr;
+    AllocationWaiter *last = nullptr;
+    {
+        // Lock the descriptor's pool
+        const std::lock_guard<PoolMutex> lock(pool_locks[index].mutex);
+
+        // Give a block to each waiting request, oldest first
+        while (queue.head != nullptr)
+        {
+            std::uint8_t *block = TakeWaiterBlock(index);
+            if (block == nullptr) break;
+
+            AllocationWaiter *waiter = queue.head;
+            queue.head = waiter->next;
+            if (queue.head == nullptr) queue.tail = nullptr;
+            queue.waiting.fetch_sub(1, std::memory_order_relaxed);
+
+            waiter->block = GetDataPointer(layouts[index], block);
+            waiter->granted = true;
+            waiter->next = nullptr;
+            if (last == nullptr)
+            {
+                served = waiter;
+            }
+            else
+            {
+                last->next = waiter;
+            }
+            last = waiter;
+        }
+    }
+
+    // Notify the requests served; a waiter may be destroyed once notified
+    while (served != nullptr)
+    {
+        AllocationWaiter *waiter = served;
+        served = waiter->next;
+        if (waiter->handle)
+        {
+            waiter->handle.resume();
+        }
+        else
+        {
+            waiter->semaphore->release();
+        }
+    }
+}
+
+/*
+ *  AllocateAwaitable::AllocateAwaitable()
+ *
+ *  Description:
+ *      Constructor for the AllocateAwaitable object.
+ *
+ *  Parameters:
+ *      memory_manager [in]
+ *          The Memory Manager from which memory is allocated.
+ *
+ *      size [in]
+ *          The size of the memory requested.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+AllocateAwaitable::AllocateAwaitable(MemoryManager &memory_manager,
+                                     std::size_t size) :
+    memory_manager{memory_manager},
+    size{size},
+    waiter{}
+{
+}
+
+/*
+ *  AllocateAwaitable::await_ready()
+ *
+ *  Description:
+ *      Attempt to satisfy the request without suspending the coroutine.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      True if the request was satisfied, false if the coroutine should be
+ *      suspended.
+ *
+ *  Comments:
+ *      None.
+ */
+bool AllocateAwaitable::await_ready()
+{
+    waiter.block = memory_manager.Allocate(size);
+
+    return waiter.block != nullptr;
+}
+
+/*
+ *  AllocateAwaitable::await_suspend()
+ *
+ *  Description:
+ *      Place the request in the queue of waiting requests so that the
+ *      coroutine is resumed once a block is freed.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The handle of the suspending coroutine.
+ *
+ *  Returns:
+ *      True if the coroutine remains suspended, false if the request was
+ *      satisfied (or cannot be) and the coroutine should continue.
+ *
+ *  Comments:
+ *      Once the request is queued, the coroutine may be resumed by another
+ *      thread at any time, so this object must not be touched thereafter.
+ */
+bool AllocateAwaitable::await_suspend(std::coroutine_handle<> handle)
+{
+    waiter.handle = handle;
+
+    return memory_manager.EnqueueWaiter(waiter, size);
+}
+
+/*
+ *  LatencyBucketFloor()
+ *
+ *  Description:
+ *      Determine the shortest duration counted by a bucket of a latency
+ *      histogram reported by MemoryManager::GetDiagnostics().
+ *
+ *  Parameters:
+ *      bucket [in]
+ *          The index of the histogram bucket.
+ *
+ *  Returns:
+ *      The shortest duration in nanoseconds counted by the bucket.  Each
+ *      bucket counts durations shorter than the floor of the next bucket,
+ *      except that the last bucket counts all longer durations.
+ *
+ *  Comments:
+ *      None.
+ */
+std::uint64_t LatencyBucketFloor(std::size_t bucket)
+{
+    if (bucket < 4) return bucket;
+
+    return (std::uint64_t{4} + (bucket & 3)) << ((bucket >> 2) - 1);
+}
+
+/*
+ *  FreeAny()
+ *
+ *  Description:
+ *      Free memory allocated by any Memory Manager, returning it to the
+ *      Memory Manager that allocated it.
+ *
+ *  Parameters:
+ *      p [in]
+ *          Pointer to a block of memory provided by MemoryManager::Allocate()
+ *          on any Memory Manager object.
+ *
+ *  Returns:
+ *      True if the memory was freed, false if the owning Memory Manager could
+ *      not be located or it rejected the block.
+ *
+ *  Comments:
+ *      A block having a compact header is located by finding the slab
+ *      containing it among those recorded by Memory Managers given the
+ *      free_any option; otherwise, the owner is taken from the block header
+ *      and accepted only if that Memory Manager still exists.  The owner is
+ *      pinned while it validates and frees the block as usual, so that it is
+ *      not destroyed in the meantime.
+ */
+bool FreeAny(void *p)
+{
+    if (p == nullptr) return false;
+
+    const auto *data = static_cast<const std::uint8_t *>(p);
+    ManagerRegistry &registry = GetManagerRegistry();
+    MemoryManager *owner = nullptr;
+    RegistryEntry *entry = nullptr;
+
+    // Look for a recorded slab containing p, if any slabs are recorded;
+    // this is done first since the memory before a block having a compact
+    // header might not be readable
+    if (registry.slab_count.load(std::memory_order_relaxed) > 0)
+    {
+        const auto address = reinterpret_cast<std::uintptr_t>(p);
+        const std::shared_lock<std::shared_mutex> lock(registry.slab_mutex);
+        auto slab = registry.slabs.upper_bound(address);
+        if ((slab != registry.slabs.begin()) &&
+            (address < std::prev(slab)->second.end))
+        {
+            owner = std::prev(slab)->second.memory_manager;
+        }
+    }
+
+    // Otherwise, take the owner from the block header
+    if (owner == nullptr) owner = ReadHeaderOwner(data);
+
+    // Pin the owner if it still exists and is not being destroyed
+    {
+        const std::shared_lock<std::shared_mutex> lock(registry.mutex);
+        auto found = registry.managers.find(owner);
+        if (found == registry.managers.end()) return false;
+        entry = found->second;
+        entry->pins.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const bool freed = owner->Free(p);
+
+    // Release the owner, waking it if it is waiting to be destroyed; if the
+    // entry has already been reused, this at most wakes a waiter needlessly
+    if ((entry->pins.fetch_sub(1, std::memory_order_seq_cst) == 1) &&
+        entry->retiring.load(std::memory_order_seq_cst))
+    {
+        const std::lock_guard<std::mutex> lock(registry.release_mutex);
+        registry.released.notify_all();
+    }
+
+    return freed;
+}
+
 } // namespace Terra::MemoryManager
@@ -0,0 +1,128 @@
+/*
+ *  memory_resource.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This file implements the MemoryResource object.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstddef>
+#include <new>
+#include <terra/memory_manager/memory_resource.h>
+
+namespace Terra::MemoryManager
+{
+
+/*
+ *  MemoryResource::MemoryResource()
+ *
+ *  Description:
+ *      Constructor for the MemoryResource object.
+ *
+ *  Parameters:
+ *      memory_manager [in]
+ *          The Memory Manager used to allocate and free memory.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+MemoryResource::MemoryResource(const MemoryManagerPointer &memory_manager) :
+    memory_manager{memory_manager}
+{
+}
+
+/*
+ *  MemoryResource::do_allocate()
+ *
+ *  Description:
+ *      Allocate memory of the requested size and alignment.
+ *
+ *  Parameters:
+ *      bytes [in]
+ *          The size of the memory requested.
+ *
+ *      alignment [in]
+ *          The required alignment of the memory.
+ *
+ *  Returns:
+ *      A pointer to the allocated memory.
+ *
+ *  Comments:
+ *      This function will throw std::bad_alloc on failure.
+ */
+void *MemoryResource::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    void *p = memory_manager->Allocate(bytes, alignment);
+    if (p == nullptr) throw std::bad_alloc();
+
+    return p;
+}
+
+/*
+ *  MemoryResource::do_deallocate()
+ *
+ *  Description:
+ *      Free memory previously allocated by do_allocate().
+ *
+ *  Parameters:
+ *      p [in]
+ *          A pointer to the memory to be freed.
+ *
+ *      bytes [in]
+ *          The size of the memory that was requested.
+ *
+ *      alignment [in]
+ *          The alignment of the memory that was requested.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void MemoryResource::do_deallocate(void *p,
+                                   std::size_t bytes,
+                                   [[maybe_unused]] std::size_t alignment)
+{
+    memory_manager->Free(p, bytes);
+}
+
+/*
+ *  MemoryResource::do_is_equal()
+ *
+ *  Description:
+ *      Checks to see if memory allocated by one memory resource can be freed
+ *      by another memory resource.
+ *
+ *  Parameters:
+ *      other [in]
+ *          A reference to the other memory resource object.
+ *
+ *  Returns:
+ *      Returns true if the other object is a MemoryResource using the same
+ *      Memory Manager as this object.
+ *
+ *  Comments:
+ *      None.
+ */
+bool MemoryResource::do_is_equal(
+    const std::pmr::memory_resource &other) const noexcept
+{
+    if (this == &other) return true;
+
+    const auto *resource = dynamic_cast<const MemoryResource *>(&other);
+
+    return (resource != nullptr) &&
+           (resource->memory_manager.get() == memory_manager.get());
+}
+
+} // namespace Terra::MemoryManager
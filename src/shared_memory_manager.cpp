@@ -0,0 +1,961 @@
+/*
+ *  shared_memory_manager.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This file implements the SharedMemoryManager object.  The shared
+ *      region begins with a SharedRegionHeader, followed by a
+ *      SharedDescriptor for each descriptor in the profile and then the
+ *      blocks of each descriptor in turn.  Each block's SharedBlockHeader
+ *      immediately precedes its data.  Free blocks are identified by their
+ *      number within the descriptor (plus one, so that zero means none),
+ *      which allows the head of each free list to hold both the block
+ *      number and a modification tag in a single 64-bit atomic value.
+ *
+ *  Portability Issues:
+ *      Shared memory regions are only supported on Linux.
+ */
+
+#include <version>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include <terra/memory_manager/shared_memory_manager.h>
+#include <terra/logger/logger.h>
+
+namespace Terra::MemoryManager
+{
+
+namespace
+{
+
+// Define memory alignment
+#ifdef __cpp_lib_hardware_interference_size
+    constexpr std::size_t Allocation_Alignment =
+        std::hardware_destructive_interference_size;
+#else
+    constexpr std::size_t Allocation_Alignment = alignof(std::max_align_t);
+#endif
+
+// Atomic values in the region are shared between processes, which is only
+// possible if they are lock-free
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "64-bit atomic values must be lock-free");
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free,
+              "32-bit atomic values must be lock-free");
+
+// Values used to identify the region and its blocks
+constexpr std::uint64_t Region_Marker_Value = 0x52E9C3A17D4F0B68;
+constexpr std::uint64_t Region_Version = 1;
+constexpr std::uint32_t Shared_Marker_Value = 0x6B1DE24F;
+
+// States of a block, used to detect blocks freed more than once
+constexpr std::uint32_t Block_Free = 0;
+constexpr std::uint32_t Block_Allocated = 1;
+
+// Block numbers are held in the low half of a free list head
+constexpr unsigned Number_Bits = 32;
+constexpr std::uint64_t Number_Mask = (std::uint64_t{1} << Number_Bits) - 1;
+
+// Helper function to do type casting
+constexpr auto PointerDiff(std::size_t distance)
+{
+    using DiffType = std::iterator_traits<std::uint8_t *>::difference_type;
+    return static_cast<DiffType>(distance);
+}
+
+// Round the given value up to a multiple of the given power of two
+constexpr std::size_t RoundUp(std::size_t value, std::size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Get the system page size
+inline std::size_t PageSize()
+{
+#ifdef __linux__
+    const long page_size = sysconf(_SC_PAGESIZE);
+    if (page_size > 0) return static_cast<std::size_t>(page_size);
+#endif
+    return 4096;
+}
+
+// Atomically raise a maximum value to the given value
+inline void AtomicMaximum(std::atomic<std::uint64_t> &maximum,
+                          std::uint64_t value)
+{
+    std::uint64_t current = maximum.load(std::memory_order_relaxed);
+    while ((value > current) &&
+           !maximum.compare_exchange_weak(current,
+                                          value,
+                                          std::memory_order_relaxed))
+    {
+    }
+}
+
+// Header placed just before the user data of each block
+struct SharedBlockHeader
+{
+    std::uint32_t index;                        // Profile index
+    std::uint32_t marker;                       // Head identifier
+    std::atomic<std::uint32_t> next;            // Next free block number + 1
+    std::atomic<std::uint32_t> state;           // Free or allocated
+};
+
+} // namespace
+
+// Disable MSVC warning "Structure was padded due to alignment specifier"
+#ifdef _MSC_VER
+    #pragma warning(push)
+    #pragma warning(disable : 4324)
+#endif
+
+// Header at the start of the shared region; the marker is written last by
+// the creating process, so a region with a valid marker is fully initialized
+struct alignas(Allocation_Alignment) SharedRegionHeader
+{
+    std::atomic<std::uint64_t> marker;          // Region identifier
+    std::uint64_t version;                      // Layout version
+    std::uint64_t length;                       // Length of the region
+    std::uint64_t descriptor_count;             // Descriptors in the profile
+};
+
+// Layout, free list, and statistics for a single descriptor, each placed on
+// its own cache line
+struct alignas(Allocation_Alignment) SharedDescriptor
+{
+    std::uint64_t size;                         // Size of memory blocks
+    std::uint64_t alignment;                    // Alignment of block data
+    std::uint64_t stride;                       // Distance between blocks
+    std::uint64_t first_block;                  // Offset of first block data
+    std::uint64_t block_count;                  // Number of blocks
+    std::uint64_t spill_never;                  // Only this descriptor used
+    std::atomic<std::uint64_t> free_head;       // Tag and first free block
+    std::atomic<std::uint64_t> allocations;     // User allocations
+    std::atomic<std::uint64_t> deallocations;   // User deallocations
+    std::atomic<std::uint64_t> corruption_count;// Corrupt block count
+    std::atomic<std::uint64_t> max_outstanding; // Maximum blocks outstanding
+    std::atomic<std::uint64_t> outstanding;     // Blocks outstanding
+    std::atomic<std::uint64_t> unfulfilled;     // Allocations unfulfilled
+    std::atomic<std::uint64_t> spilled;         // Allocations spilled
+};
+
+#ifdef _MSC_VER
+    #pragma warning(pop)
+#endif
+
+namespace
+{
+
+// Get the header of the block whose data is at the given location
+inline SharedBlockHeader *GetBlockHeader(std::uint8_t *block)
+{
+    return reinterpret_cast<SharedBlockHeader *>(
+        std::prev(block, PointerDiff(sizeof(SharedBlockHeader))));
+}
+
+// Get the data of the given block number within the region
+inline std::uint8_t *GetBlock(std::uint8_t *region,
+                              const SharedDescriptor &descriptor,
+                              std::uint64_t number)
+{
+    return std::next(region,
+                     PointerDiff(descriptor.first_block +
+                                 (number * descriptor.stride)));
+}
+
+} // namespace
+
+/*
+ *  SharedMemoryManager::SharedMemoryManager()
+ *
+ *  Description:
+ *      Constructor for the SharedMemoryManager object that creates a new
+ *      named shared memory region holding the blocks for the given profile.
+ *
+ *  Parameters:
+ *      name [in]
+ *          The name of the shared memory region (e.g., "/packets").
+ *
+ *      profile [in]
+ *          The memory profile describing the blocks to place in the region.
+ *
+ *      parent_logger [in]
+ *          The parent logger object to use for logging.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      If the region cannot be created, an error is logged and the object
+ *      is not attached (see IsAttached()).
+ */
+SharedMemoryManager::SharedMemoryManager(
+    const std::string &name,
+    MemoryProfile profile,
+    const Logger::LoggerPointer &parent_logger) :
+    name{name},
+    logger{std::make_shared<Logger::Logger>(parent_logger, "SMMGR")},
+    creator{false},
+    region{nullptr},
+    length{0},
+    header{nullptr},
+    descriptors{nullptr}
+{
+    // Sort the profile according to size
+    std::ranges::sort(
+        profile,
+        [](const MemoryDescriptor &a, const MemoryDescriptor &b) -> bool
+        { return a.size < b.size; });
+
+    if (!CreateRegion(profile))
+    {
+        logger->error << "Failed to create shared memory region " << name
+                      << std::flush;
+    }
+}
+
+/*
+ *  SharedMemoryManager::SharedMemoryManager()
+ *
+ *  Description:
+ *      Constructor for the SharedMemoryManager object that attaches to an
+ *      existing named shared memory region.
+ *
+ *  Parameters:
+ *      name [in]
+ *          The name of the shared memory region.
+ *
+ *      parent_logger [in]
+ *          The parent logger object to use for logging.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      If the region does not exist or has not been fully created, an error
+ *      is logged and the object is not attached (see IsAttached()).
+ */
+SharedMemoryManager::SharedMemoryManager(
+    const std::string &name,
+    const Logger::LoggerPointer &parent_logger) :
+    name{name},
+    logger{std::make_shared<Logger::Logger>(parent_logger, "SMMGR")},
+    creator{false},
+    region{nullptr},
+    length{0},
+    header{nullptr},
+    descriptors{nullptr}
+{
+    if (!AttachRegion())
+    {
+        logger->error << "Failed to attach to shared memory region " << name
+                      << std::flush;
+    }
+}
+
+/*
+ *  SharedMemoryManager::~SharedMemoryManager()
+ *
+ *  Description:
+ *      Destructor for the SharedMemoryManager object, which detaches from
+ *      the shared memory region.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      If this object created the region, the region's name is removed.
+ */
+SharedMemoryManager::~SharedMemoryManager()
+{
+    DetachRegion();
+}
+
+/*
+ *  SharedMemoryManager::Allocate()
+ *
+ *  Description:
+ *      This function will allocate a block from the shared region large
+ *      enough to hold the requested size.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The size of the memory requested.
+ *
+ *  Returns:
+ *      A pointer to a block of memory the user may use or nullptr if the
+ *      request could not be satisfied.
+ *
+ *  Comments:
+ *      None.
+ */
+void *SharedMemoryManager::Allocate(std::size_t size)
+{
+    return Allocate(size, 0);
+}
+
+/*
+ *  SharedMemoryManager::Allocate()
+ *
+ *  Description:
+ *      This function will allocate a block from the shared region large
+ *      enough to hold the requested size and aligned at least as strictly
+ *      as requested.  The first descriptor large enough is used if it has a
+ *      free block; otherwise, larger descriptors are tried in turn.
+ *
+ *  Parameters:
+ *      size [in]
+ *          The size of the memory requested.
+ *
+ *      alignment [in]
+ *          The required alignment of the memory, which must be a power of
+ *          two (or 0 if no particular alignment is required).
+ *
+ *  Returns:
+ *      A pointer to a block of memory the user may use or nullptr if the
+ *      request could not be satisfied.
+ *
+ *  Comments:
+ *      None.
+ */
+void *SharedMemoryManager::Allocate(std::size_t size, std::size_t alignment)
+{
+    if (region == nullptr) return nullptr;
+
+    // Alignment values must be a power of two
+    if ((alignment != 0) && !std::has_single_bit(alignment)) return nullptr;
+
+    const std::size_t count = header->descriptor_count;
+    std::size_t first = count;
+    for (std::size_t index = 0; index < count; index++)
+    {
+        SharedDescriptor &descriptor = descriptors[index];
+
+        // If the descriptor indicates memory is too small or insufficiently
+        // aligned, keep looking
+        if ((descriptor.size < size) || (descriptor.alignment < alignment))
+        {
+            continue;
+        }
+
+        // Use a larger descriptor only if the first descriptor allows it
+        if (first == count)
+        {
+            first = index;
+        }
+        else if (descriptors[first].spill_never != 0)
+        {
+            break;
+        }
+
+        // If no block is free, keep looking
+        std::uint8_t *block = PopBlock(index);
+        if (block == nullptr)
+        {
+            // Note a fulfillment attempt failed
+            descriptor.unfulfilled.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        // Update various statistics
+        descriptor.allocations.fetch_add(1, std::memory_order_relaxed);
+        AtomicMaximum(descriptor.max_outstanding,
+                      descriptor.outstanding.fetch_add(
+                          1,
+                          std::memory_order_relaxed) + 1);
+        if (index != first)
+        {
+            descriptors[first].spilled.fetch_add(1,
+                                                 std::memory_order_relaxed);
+        }
+
+        return block;
+    }
+
+    return nullptr;
+}
+
+/*
+ *  SharedMemoryManager::Free()
+ *
+ *  Description:
+ *      This function will return a block to the shared region.  The block
+ *      may have been allocated by any process attached to the region.
+ *
+ *  Parameters:
+ *      p [in]
+ *          Pointer to a block of memory provided by Allocate() or
+ *          GetPointer().
+ *
+ *  Returns:
+ *      True if memory is freed, false if the pointer does not refer to a
+ *      block in the region or the block is already free.
+ *
+ *  Comments:
+ *      None.
+ */
+bool SharedMemoryManager::Free(void *p)
+{
+    return Free(p, 0);
+}
+
+/*
+ *  SharedMemoryManager::Free()
+ *
+ *  Description:
+ *      This function will return a block to the shared region, just as
+ *      Free() above, given the size that was requested from Allocate().
+ *
+ *  Parameters:
+ *      p [in]
+ *          Pointer to a block of memory provided by Allocate() or
+ *          GetPointer().
+ *
+ *      size [in]
+ *          The size of the memory requested from Allocate(), or 0 if not
+ *          known.
+ *
+ *  Returns:
+ *      True if memory is freed, false if the pointer does not refer to a
+ *      block in the region or the block is already free.
+ *
+ *  Comments:
+ *      A size larger than the block indicates the caller may have written
+ *      beyond the end of the block, which is counted as corruption, though
+ *      the block is still returned to the region.
+ */
+bool SharedMemoryManager::Free(void *p, std::size_t size)
+{
+    // Ensure the pointer refers to data within the region
+    const std::uint64_t offset = GetOffset(p);
+    if (offset < sizeof(SharedBlockHeader))
+    {
+        logger->error << "Free request made for memory not in the shared "
+                         "region"
+                      << std::flush;
+        return false;
+    }
+
+    // Ensure the pointer refers to the start of a block
+    auto *block = static_cast<std::uint8_t *>(p);
+    SharedBlockHeader *block_header = GetBlockHeader(block);
+    if ((block_header->marker != Shared_Marker_Value) ||
+        (block_header->index >= header->descriptor_count))
+    {
+        logger->error << "Free request made for an invalid block"
+                      << std::flush;
+        return false;
+    }
+    SharedDescriptor &descriptor = descriptors[block_header->index];
+    if ((offset < descriptor.first_block) ||
+        (((offset - descriptor.first_block) % descriptor.stride) != 0) ||
+        (((offset - descriptor.first_block) / descriptor.stride) >=
+         descriptor.block_count))
+    {
+        logger->error << "Free request made for an invalid block"
+                      << std::flush;
+        return false;
+    }
+
+    // Ensure the block is not already free
+    std::uint32_t state = Block_Allocated;
+    if (!block_header->state.compare_exchange_strong(
+            state,
+            Block_Free,
+            std::memory_order_relaxed))
+    {
+        logger->error << "Free request made for a block that is not "
+                         "allocated"
+                      << std::flush;
+        return false;
+    }
+
+    // Ensure the block is large enough for the given size
+    if (size > descriptor.size)
+    {
+        logger->error << "Free request made with a size larger than the "
+                         "memory block"
+                      << std::flush;
+        descriptor.corruption_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Update various statistics
+    descriptor.deallocations.fetch_add(1, std::memory_order_relaxed);
+    descriptor.outstanding.fetch_sub(1, std::memory_order_relaxed);
+
+    PushBlock(block_header->index, block);
+
+    return true;
+}
+
+/*
+ *  SharedMemoryManager::GetOffset()
+ *
+ *  Description:
+ *      Determine the offset of the given memory from the start of the
+ *      shared region, which may be passed to another process and converted
+ *      back into a pointer using GetPointer().
+ *
+ *  Parameters:
+ *      p [in]
+ *          Pointer to memory within the shared region.
+ *
+ *  Returns:
+ *      The offset of the memory or 0 if the memory is not within the region.
+ *
+ *  Comments:
+ *      None.
+ */
+std::uint64_t SharedMemoryManager::GetOffset(const void *p) const
+{
+    const auto address = reinterpret_cast<std::uintptr_t>(p);
+    const auto start = reinterpret_cast<std::uintptr_t>(region);
+
+    if ((region == nullptr) || (address <= start) ||
+        (address >= start + length))
+    {
+        return 0;
+    }
+
+    return address - start;
+}
+
+/*
+ *  SharedMemoryManager::GetPointer()
+ *
+ *  Description:
+ *      Convert an offset from the start of the shared region, as returned by
+ *      GetOffset() in any attached process, into a pointer valid within this
+ *      process.
+ *
+ *  Parameters:
+ *      offset [in]
+ *          The offset of the memory within the region.
+ *
+ *  Returns:
+ *      A pointer to the memory or nullptr if the offset is not within the
+ *      region.
+ *
+ *  Comments:
+ *      None.
+ */
+void *SharedMemoryManager::GetPointer(std::uint64_t offset) const
+{
+    if ((region == nullptr) || (offset == 0) || (offset >= length))
+    {
+        return nullptr;
+    }
+
+    return std::next(region, PointerDiff(offset));
+}
+
+/*
+ *  SharedMemoryManager::GetStatistics()
+ *
+ *  Description:
+ *      Get the current statistics for the shared region.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The statistics for each descriptor in the profile.
+ *
+ *  Comments:
+ *      Statistics reflect the activity of all attached processes.
+ */
+std::vector<Statistics> SharedMemoryManager::GetStatistics() const
+{
+    std::vector<Statistics> snapshot;
+
+    GetStatistics(snapshot);
+
+    return snapshot;
+}
+
+/*
+ *  SharedMemoryManager::GetStatistics()
+ *
+ *  Description:
+ *      Get a snapshot of the current statistics for the shared region,
+ *      reusing the storage of the given vector.
+ *
+ *  Parameters:
+ *      snapshot [out]
+ *          The vector to receive the statistics for each descriptor.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      If not attached, the snapshot is empty.
+ */
+void SharedMemoryManager::GetStatistics(std::vector<Statistics> &snapshot) const
+{
+    snapshot.clear();
+    if (region == nullptr) return;
+
+    snapshot.resize(header->descriptor_count);
+    for (std::size_t index = 0; index < snapshot.size(); index++)
+    {
+        const SharedDescriptor &descriptor = descriptors[index];
+        snapshot[index].size = descriptor.size;
+        snapshot[index].allocations =
+            descriptor.allocations.load(std::memory_order_relaxed);
+        snapshot[index].deallocations =
+            descriptor.deallocations.load(std::memory_order_relaxed);
+        snapshot[index].corruption_count =
+            descriptor.corruption_count.load(std::memory_order_relaxed);
+        snapshot[index].max_outstanding =
+            descriptor.max_outstanding.load(std::memory_order_relaxed);
+        snapshot[index].outstanding =
+            descriptor.outstanding.load(std::memory_order_relaxed);
+        snapshot[index].unfulfilled =
+            descriptor.unfulfilled.load(std::memory_order_relaxed);
+        snapshot[index].spilled =
+            descriptor.spilled.load(std::memory_order_relaxed);
+    }
+}
+
+/*
+ *  SharedMemoryManager::CreateRegion()
+ *
+ *  Description:
+ *      Create the named shared memory region, map it, and initialize the
+ *      descriptors and blocks for the given profile.
+ *
+ *  Parameters:
+ *      profile [in]
+ *          The memory profile, sorted by size.
+ *
+ *  Returns:
+ *      True if the region was created, false if not.
+ *
+ *  Comments:
+ *      The region marker is written only once initialization is complete.
+ */
+bool SharedMemoryManager::CreateRegion(const MemoryProfile &profile)
+{
+    const std::size_t page_size = PageSize();
+
+    // Determine the layout of the region
+    std::vector<SharedDescriptor> layouts(profile.size());
+    std::size_t cursor = sizeof(SharedRegionHeader) +
+                         (sizeof(SharedDescriptor) * profile.size());
+    for (std::size_t index = 0; index < profile.size(); index++)
+    {
+        const MemoryDescriptor &descriptor = profile[index];
+        const std::size_t alignment =
+            std::max(descriptor.alignment, alignof(std::max_align_t));
+        const std::size_t count =
+            std::max(descriptor.minimum, descriptor.maximum);
+
+        if (!std::has_single_bit(alignment) || (alignment > page_size))
+        {
+            logger->error << "Invalid alignment for descriptor size "
+                          << descriptor.size << std::flush;
+            return false;
+        }
+        if ((descriptor.size == 0) || (count >= Number_Mask))
+        {
+            logger->error << "Invalid descriptor size " << descriptor.size
+                          << std::flush;
+            return false;
+        }
+
+        layouts[index].size = descriptor.size;
+        layouts[index].alignment = alignment;
+        layouts[index].stride =
+            RoundUp(descriptor.size + sizeof(SharedBlockHeader), alignment);
+        layouts[index].first_block =
+            RoundUp(cursor + sizeof(SharedBlockHeader), alignment);
+        layouts[index].block_count = count;
+        layouts[index].spill_never =
+            (descriptor.spill == SpillPolicy::Never) ? 1 : 0;
+        cursor = layouts[index].first_block - sizeof(SharedBlockHeader) +
+                 (layouts[index].stride * count);
+    }
+    const std::size_t region_length = RoundUp(cursor, page_size);
+
+#ifdef __linux__
+    // Create the region, failing if the name is already in use
+    const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) return false;
+    if (ftruncate(fd, static_cast<off_t>(region_length)) != 0)
+    {
+        close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+    void *memory = mmap(nullptr,
+                        region_length,
+                        PROT_READ | PROT_WRITE,
+                        MAP_SHARED,
+                        fd,
+                        0);
+    close(fd);
+    if (memory == MAP_FAILED)
+    {
+        shm_unlink(name.c_str());
+        return false;
+    }
+    region = static_cast<std::uint8_t *>(memory);
+    length = region_length;
+    creator = true;
+
+    // Initialize the region header and descriptors
+    header = new (region) SharedRegionHeader{};
+    header->version = Region_Version;
+    header->length = region_length;
+    header->descriptor_count = profile.size();
+    descriptors = reinterpret_cast<SharedDescriptor *>(
+        std::next(region, PointerDiff(sizeof(SharedRegionHeader))));
+    for (std::size_t index = 0; index < profile.size(); index++)
+    {
+        SharedDescriptor &descriptor =
+            *new (&descriptors[index]) SharedDescriptor{};
+        descriptor.size = layouts[index].size;
+        descriptor.alignment = layouts[index].alignment;
+        descriptor.stride = layouts[index].stride;
+        descriptor.first_block = layouts[index].first_block;
+        descriptor.block_count = layouts[index].block_count;
+        descriptor.spill_never = layouts[index].spill_never;
+
+        // Link every block onto the free list in order
+        for (std::uint64_t number = 0; number < descriptor.block_count;
+             number++)
+        {
+            auto *block_header = new (GetBlockHeader(
+                GetBlock(region, descriptor, number))) SharedBlockHeader{};
+            block_header->index = static_cast<std::uint32_t>(index);
+            block_header->marker = Shared_Marker_Value;
+            block_header->next.store(
+                (number + 1 < descriptor.block_count) ?
+                    static_cast<std::uint32_t>(number + 2) :
+                    0,
+                std::memory_order_relaxed);
+            block_header->state.store(Block_Free, std::memory_order_relaxed);
+        }
+        descriptor.free_head.store((descriptor.block_count > 0) ? 1 : 0,
+                                   std::memory_order_relaxed);
+    }
+
+    // Make the region available to other processes
+    header->marker.store(Region_Marker_Value, std::memory_order_release);
+
+    logger->info << "Created shared memory region " << name << " of "
+                 << region_length << " octets" << std::flush;
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*
+ *  SharedMemoryManager::AttachRegion()
+ *
+ *  Description:
+ *      Open and map an existing named shared memory region.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      True if attached to the region, false if not.
+ *
+ *  Comments:
+ *      None.
+ */
+bool SharedMemoryManager::AttachRegion()
+{
+#ifdef __linux__
+    const int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) return false;
+
+    // The region must at least hold its header
+    struct stat status{};
+    if ((fstat(fd, &status) != 0) ||
+        (static_cast<std::size_t>(status.st_size) <
+         sizeof(SharedRegionHeader)))
+    {
+        close(fd);
+        return false;
+    }
+    const auto region_length = static_cast<std::size_t>(status.st_size);
+
+    void *memory = mmap(nullptr,
+                        region_length,
+                        PROT_READ | PROT_WRITE,
+                        MAP_SHARED,
+                        fd,
+                        0);
+    close(fd);
+    if (memory == MAP_FAILED) return false;
+    region = static_cast<std::uint8_t *>(memory);
+    length = region_length;
+
+    // Ensure the region has been fully created and has the expected layout
+    header = reinterpret_cast<SharedRegionHeader *>(region);
+    descriptors = reinterpret_cast<SharedDescriptor *>(
+        std::next(region, PointerDiff(sizeof(SharedRegionHeader))));
+    if ((header->marker.load(std::memory_order_acquire) !=
+         Region_Marker_Value) ||
+        (header->version != Region_Version) ||
+        (header->length != region_length) ||
+        (header->descriptor_count >
+         (region_length - sizeof(SharedRegionHeader)) /
+             sizeof(SharedDescriptor)))
+    {
+        DetachRegion();
+        return false;
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*
+ *  SharedMemoryManager::DetachRegion()
+ *
+ *  Description:
+ *      Unmap the shared memory region, removing its name if this object
+ *      created it.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void SharedMemoryManager::DetachRegion()
+{
+#ifdef __linux__
+    if (region != nullptr) munmap(region, length);
+    if (creator) shm_unlink(name.c_str());
+#endif
+
+    region = nullptr;
+    length = 0;
+    header = nullptr;
+    descriptors = nullptr;
+    creator = false;
+}
+
+/*
+ *  SharedMemoryManager::PopBlock()
+ *
+ *  Description:
+ *      Take a block from the free list for the given profile index.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index from which a block is needed.
+ *
+ *  Returns:
+ *      A pointer to the block's data or nullptr if no block is free.
+ *
+ *  Comments:
+ *      The tag in the free list head changes on each update to prevent the
+ *      ABA problem.  Reading the next block number of a block that another
+ *      process has just taken is harmless, since blocks are never unmapped
+ *      while attached and the tag causes the update to fail.
+ */
+std::uint8_t *SharedMemoryManager::PopBlock(std::size_t index)
+{
+    SharedDescriptor &descriptor = descriptors[index];
+
+    std::uint64_t head = descriptor.free_head.load(std::memory_order_acquire);
+    std::uint8_t *block = nullptr;
+    std::uint64_t replacement = 0;
+    do
+    {
+        const std::uint64_t number = head & Number_Mask;
+        if (number == 0) return nullptr;
+
+        block = GetBlock(region, descriptor, number - 1);
+        const std::uint64_t next =
+            GetBlockHeader(block)->next.load(std::memory_order_relaxed);
+        replacement = (((head >> Number_Bits) + 1) << Number_Bits) | next;
+    } while (!descriptor.free_head.compare_exchange_weak(
+        head,
+        replacement,
+        std::memory_order_acq_rel,
+        std::memory_order_acquire));
+
+    GetBlockHeader(block)->state.store(Block_Allocated,
+                                       std::memory_order_relaxed);
+
+    return block;
+}
+
+/*
+ *  SharedMemoryManager::PushBlock()
+ *
+ *  Description:
+ *      Return a block to the free list for the given profile index.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The profile index to which the block belongs.
+ *
+ *      block [in]
+ *          A pointer to the block's data.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void SharedMemoryManager::PushBlock(std::size_t index, std::uint8_t *block)
+{
+    SharedDescriptor &descriptor = descriptors[index];
+    SharedBlockHeader *block_header = GetBlockHeader(block);
+    const auto number = static_cast<std::uint64_t>(
+        ((block - region) - static_cast<std::ptrdiff_t>(
+                                descriptor.first_block)) /
+        static_cast<std::ptrdiff_t>(descriptor.stride));
+
+    std::uint64_t head = descriptor.free_head.load(std::memory_order_relaxed);
+    std::uint64_t replacement = 0;
+    do
+    {
+        block_header->next.store(static_cast<std::uint32_t>(head & Number_Mask),
+                                 std::memory_order_relaxed);
+        replacement =
+            (((head >> Number_Bits) + 1) << Number_Bits) | (number + 1);
+    } while (!descriptor.free_head.compare_exchange_weak(
+        head,
+        replacement,
+        std::memory_order_release,
+        std::memory_order_relaxed));
+}
+
+} // namespace Terra::MemoryManager
@@ -13,6 +13,9 @@
  */
 
 #include <vector>
+#include <list>
+#include <map>
+#include <cstdint>
 #include <cstring>
 #include <terra/memory_manager/memory_manager.h>
 #include <terra/memory_manager/memory_allocator.h>
@@ -291,3 +294,161 @@ STF_TEST(MemoryAllocator, TestVectorOfPackets)
         STF_ASSERT_TRUE(allocated);
     }
 }
+
+STF_TEST(MemoryAllocator, NonOwning)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {    64,       5,      10, true  },
+        {   256,       2,      10, true  },
+        {   512,       2,      10, true  },
+        {  1024,       1,      20, true  },
+        { 65536,       0,       1, true  }
+    };
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManagerPointer memory_manager =
+        std::make_shared<Terra::MemoryManager::MemoryManager>(profile);
+
+    {
+        using Allocator = Terra::MemoryManager::NonOwningMemoryAllocator<
+            std::pair<const int, int>>;
+        std::map<int, int, std::less<int>, Allocator> map(*memory_manager);
+
+        for (int i = 0; i < 10; i++) map[i] = i;
+        for (int i = 0; i < 10; i++) STF_ASSERT_EQ(i, map[i]);
+
+        // Copies do not take a reference to the Memory Manager
+        STF_ASSERT_EQ(1, memory_manager.use_count());
+
+        // Allocators may be created from an owning MemoryAllocator and
+        // are equal if they use the same Memory Manager
+        Terra::MemoryManager::MemoryAllocator<int> owning(memory_manager);
+        STF_ASSERT_TRUE(map.get_allocator() == Allocator(owning));
+    }
+
+    // Get the statistics
+    auto stats = memory_manager->GetStatistics();
+    STF_ASSERT_EQ(10, stats[0].allocations);
+    STF_ASSERT_EQ(10, stats[0].deallocations);
+    STF_ASSERT_EQ(0, stats[0].outstanding);
+}
+
+STF_TEST(MemoryAllocator, Alignment)
+{
+    // Define a type requiring page alignment
+    struct alignas(4096) Page
+    {
+        std::uint8_t data[4096];
+    };
+
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed, Slab Blocks, Alignment
+        {    64,       5,      10, true,           0,           0    },
+        { 16384,       1,       2, true,           0,           0    },
+        { 65536,       1,       2, true,           0,           4096 }
+    };
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManagerPointer memory_manager =
+        std::make_shared<Terra::MemoryManager::MemoryManager>(profile);
+
+    {
+        std::vector<Page, Terra::MemoryManager::MemoryAllocator<Page>> pages(
+            4,
+            memory_manager);
+        STF_ASSERT_EQ(
+            0,
+            reinterpret_cast<std::uintptr_t>(pages.data()) % alignof(Page));
+    }
+
+    // Get the statistics
+    auto stats = memory_manager->GetStatistics();
+    STF_ASSERT_EQ(0, stats[1].allocations);
+    STF_ASSERT_EQ(1, stats[2].allocations);
+    STF_ASSERT_EQ(1, stats[2].deallocations);
+}
+
+STF_TEST(MemoryAllocator, PoolAllocator)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {    64,       0,      10, true  },
+        {  4096,       0,      10, true  },
+        { 65536,       0,       1, true  }
+    };
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManagerPointer memory_manager =
+        std::make_shared<Terra::MemoryManager::MemoryManager>(profile);
+
+    {
+        using Allocator =
+            Terra::MemoryManager::PoolAllocator<std::pair<const int, int>>;
+        Allocator allocator(memory_manager);
+        std::map<int, int, std::less<int>, Allocator> map(allocator);
+        std::list<int, Terra::MemoryManager::PoolAllocator<int>> list(
+            allocator);
+
+        // Nodes are carved from a small number of chunks
+        for (int i = 0; i < 200; i++)
+        {
+            map[i] = i;
+            list.push_back(i);
+        }
+        for (int i = 0; i < 200; i++) STF_ASSERT_EQ(i, map[i]);
+        STF_ASSERT_EQ(200, list.size());
+        auto stats = memory_manager->GetStatistics();
+        STF_ASSERT_EQ(0, stats[0].allocations);
+        STF_ASSERT_LE(stats[1].allocations, 8);
+
+        // Freed nodes are reused without further chunks
+        const std::uint64_t chunks = stats[1].allocations;
+        for (int i = 0; i < 100; i++)
+        {
+            map.erase(i);
+            list.pop_front();
+        }
+        for (int i = 0; i < 100; i++)
+        {
+            map[i + 1000] = i;
+            list.push_back(i);
+        }
+        STF_ASSERT_EQ(200, map.size());
+        STF_ASSERT_EQ(chunks,
+                      memory_manager->GetStatistics()[1].allocations);
+
+        // Requests for several objects are made of the Memory Manager, as
+        // are those for objects too large for a chunk
+        Terra::MemoryManager::PoolAllocator<int> ints(allocator);
+        int *p = ints.allocate(8);
+        ints.deallocate(p, 8);
+        Terra::MemoryManager::PoolAllocator<std::uint8_t[32768]> large(
+            allocator);
+        auto *q = large.allocate(1);
+        large.deallocate(q, 1);
+        stats = memory_manager->GetStatistics();
+        STF_ASSERT_EQ(1, stats[0].allocations);
+        STF_ASSERT_EQ(1, stats[2].allocations);
+
+        // Rebound copies share the pool
+        STF_ASSERT_TRUE(map.get_allocator() == list.get_allocator());
+        STF_ASSERT_FALSE(
+            map.get_allocator() ==
+            Terra::MemoryManager::PoolAllocator<int>(memory_manager));
+    }
+
+    // Chunks are returned once no allocator shares the pool
+    auto stats = memory_manager->GetStatistics();
+    for (const auto &statistic : stats)
+    {
+        STF_ASSERT_EQ(statistic.allocations, statistic.deallocations);
+        STF_ASSERT_EQ(0, statistic.outstanding);
+    }
+}
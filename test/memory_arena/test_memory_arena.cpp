@@ -0,0 +1,192 @@
+/*
+ *  test_memory_arena.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the MemoryArena and ArenaAllocator objects.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <vector>
+#include <map>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <terra/memory_manager/memory_manager.h>
+#include <terra/memory_manager/memory_arena.h>
+#include <terra/memory_manager/arena_allocator.h>
+#include <terra/stf/stf.h>
+
+STF_TEST(MemoryArena, BumpAllocation)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {  4096,       2,       4, true  },
+        { 65536,       0,       2, true  }
+    };
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManagerPointer memory_manager =
+        std::make_shared<Terra::MemoryManager::MemoryManager>(profile);
+
+    Terra::MemoryManager::MemoryArena arena(memory_manager, 4096);
+
+    // Nothing is allocated until memory is requested
+    STF_ASSERT_EQ(0, arena.ChunkCount());
+
+    // Allocate many small objects, which should span several chunks
+    std::vector<std::uint8_t *> allocations;
+    for (unsigned i = 0; i < 100; i++)
+    {
+        auto *p = static_cast<std::uint8_t *>(arena.Allocate(100));
+        STF_ASSERT_NE(nullptr, p);
+        STF_ASSERT_EQ(
+            0,
+            reinterpret_cast<std::uintptr_t>(p) % alignof(std::max_align_t));
+        std::memset(p, static_cast<int>(i), 100);
+        allocations.push_back(p);
+    }
+    STF_ASSERT_EQ(3, arena.ChunkCount());
+
+    // Ensure no allocations overlap
+    for (unsigned i = 0; i < allocations.size(); i++)
+    {
+        for (unsigned j = 0; j < 100; j++)
+        {
+            STF_ASSERT_EQ(i, allocations[i][j]);
+        }
+    }
+
+    // Strict alignment requests are honored
+    void *aligned = arena.Allocate(8, 256);
+    STF_ASSERT_NE(nullptr, aligned);
+    STF_ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(aligned) % 256);
+
+    // An alignment of 0 uses the default alignment
+    void *unaligned = arena.Allocate(8, 0);
+    STF_ASSERT_NE(nullptr, unaligned);
+    STF_ASSERT_EQ(0,
+                  reinterpret_cast<std::uintptr_t>(unaligned) %
+                      alignof(std::max_align_t));
+
+    // Alignment values that are not a power of two are rejected
+    STF_ASSERT_EQ(nullptr, arena.Allocate(8, 48));
+
+    // Requests larger than a chunk use a dedicated allocation
+    void *large = arena.Allocate(10000);
+    STF_ASSERT_NE(nullptr, large);
+    STF_ASSERT_EQ(4, arena.ChunkCount());
+
+    // The current chunk is still used after a large request
+    void *small = arena.Allocate(16);
+    STF_ASSERT_NE(nullptr, small);
+    STF_ASSERT_EQ(4, arena.ChunkCount());
+
+    auto stats = memory_manager->GetStatistics();
+    STF_ASSERT_EQ(3, stats[0].outstanding);
+    STF_ASSERT_EQ(1, stats[1].outstanding);
+
+    // Reset the arena, returning all chunks
+    arena.Reset();
+    STF_ASSERT_EQ(0, arena.ChunkCount());
+
+    stats = memory_manager->GetStatistics();
+    STF_ASSERT_EQ(3, stats[0].deallocations);
+    STF_ASSERT_EQ(0, stats[0].outstanding);
+    STF_ASSERT_EQ(1, stats[1].deallocations);
+    STF_ASSERT_EQ(0, stats[1].outstanding);
+
+    // The arena may be used again after a reset
+    STF_ASSERT_NE(nullptr, arena.Allocate(64));
+    STF_ASSERT_EQ(1, arena.ChunkCount());
+}
+
+STF_TEST(MemoryArena, Exhaustion)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {  1024,       2,       2, false }
+    };
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManagerPointer memory_manager =
+        std::make_shared<Terra::MemoryManager::MemoryManager>(profile);
+
+    {
+        Terra::MemoryManager::MemoryArena arena(memory_manager, 1024);
+
+        // Only two chunks are available
+        STF_ASSERT_NE(nullptr, arena.Allocate(1000));
+        STF_ASSERT_NE(nullptr, arena.Allocate(1000));
+        STF_ASSERT_EQ(nullptr, arena.Allocate(1000));
+        STF_ASSERT_EQ(nullptr, arena.Allocate(4096));
+        STF_ASSERT_EQ(2, arena.ChunkCount());
+    }
+
+    // Destroying the arena returns the chunks
+    auto stats = memory_manager->GetStatistics();
+    STF_ASSERT_EQ(2, stats[0].allocations);
+    STF_ASSERT_EQ(2, stats[0].deallocations);
+    STF_ASSERT_EQ(0, stats[0].outstanding);
+}
+
+STF_TEST(MemoryArena, ArenaAllocator)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        { 16384,       4,      16, true  },
+        { 65536,       0,       4, true  }
+    };
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManagerPointer memory_manager =
+        std::make_shared<Terra::MemoryManager::MemoryManager>(profile);
+
+    // Create an arena using the smaller blocks
+    Terra::MemoryManager::MemoryArenaPointer arena =
+        std::make_shared<Terra::MemoryManager::MemoryArena>(memory_manager,
+                                                            16384);
+
+    {
+        using Allocator = Terra::MemoryManager::ArenaAllocator<
+            std::pair<const int, double>>;
+        std::map<int, double, std::less<int>, Allocator> map(arena);
+        std::vector<int, Terra::MemoryManager::ArenaAllocator<int>> vector(
+            arena);
+
+        for (int i = 0; i < 1000; i++)
+        {
+            map[i] = i * 2.0;
+            vector.push_back(i);
+        }
+
+        for (int i = 0; i < 1000; i++)
+        {
+            STF_ASSERT_EQ(i * 2.0, map[i]);
+            STF_ASSERT_EQ(i, vector[static_cast<std::size_t>(i)]);
+        }
+
+        // Allocators using the same arena are equal
+        STF_ASSERT_TRUE(map.get_allocator() ==
+                        Allocator(vector.get_allocator()));
+    }
+
+    // All memory remains allocated until the arena is reset
+    STF_ASSERT_GT(arena->ChunkCount(), 0);
+    arena->Reset();
+
+    auto stats = memory_manager->GetStatistics();
+    STF_ASSERT_EQ(0, stats[0].outstanding);
+    STF_ASSERT_EQ(0, stats[1].outstanding);
+}
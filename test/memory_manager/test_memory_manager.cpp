@@ -13,7 +13,18 @@
  */
 
 #include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <cstdint>
 #include <cstring>
+#include <thread>
+#include <mutex>
+#include <set>
+#include <tuple>
 #include <terra/memory_manager/memory_manager.h>
 #include <terra/stf/stf.h>
 
@@ -511,3 +522,2284 @@ STF_TEST(MemMgr, ManyAllocateFree2)
         STF_ASSERT_EQ(0, stats[i].unfulfilled);
     }
 }
+
+STF_TEST(MemMgr, ThreadCacheStatistics)
+{
+    std::vector<void *> allocations;
+
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {    64,       5,      10, true    },
+        {   256,       2,      10, true    },
+        {   512,       2,      10, true    },
+        {  1500,       1,      20, true    },
+        { 65536,       0,       1, true    }
+    };
+
+    // Enable thread caching
+    Terra::MemoryManager::ManagerOptions options{};
+    options.thread_cache = true;
+    options.cache_high_watermark = 8;
+    options.cache_low_watermark = 4;
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+    // Allocate memory blocks in excess of the maximum
+    for(unsigned i = 0; i < 20; i++)
+    {
+        void *p = memory_manager.Allocate(128);
+        STF_ASSERT_NE(nullptr, p);
+        allocations.push_back(p);
+    }
+
+    // Get the statistics
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(5, stats.size());
+    STF_ASSERT_EQ(20, stats[1].allocations);
+    STF_ASSERT_EQ(20, stats[1].outstanding);
+    STF_ASSERT_EQ(20, stats[1].max_outstanding);
+    STF_ASSERT_EQ(0, stats[1].deallocations);
+
+    // Now free all of the memory
+    for (auto *p : allocations)
+    {
+        STF_ASSERT_TRUE(memory_manager.Free(p));
+    }
+
+    // Get the statistics again
+    stats = memory_manager.GetStatistics();
+
+    // Ensure all of the allocations were recorded
+    for (std::size_t i = 0; i < stats.size(); i++)
+    {
+        STF_ASSERT_EQ(profile[i].size, stats[i].size);
+        if (i == 1)
+        {
+            STF_ASSERT_EQ(20, stats[i].allocations);
+            STF_ASSERT_EQ(20, stats[i].deallocations);
+            STF_ASSERT_EQ(20, stats[i].max_outstanding);
+        }
+        else
+        {
+            STF_ASSERT_EQ(0, stats[i].allocations);
+            STF_ASSERT_EQ(0, stats[i].deallocations);
+            STF_ASSERT_EQ(0, stats[i].max_outstanding);
+        }
+        STF_ASSERT_EQ(0, stats[i].corruption_count);
+        STF_ASSERT_EQ(0, stats[i].outstanding);
+        STF_ASSERT_EQ(0, stats[i].unfulfilled);
+    }
+}
+
+STF_TEST(MemMgr, ThreadCacheCrossThread)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {    64,      16,      64, true    },
+        {  1500,       8,      32, true    }
+    };
+
+    // Enable thread caching
+    Terra::MemoryManager::ManagerOptions options{};
+    options.thread_cache = true;
+    options.cache_high_watermark = 8;
+    options.cache_low_watermark = 4;
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+    // Allocate blocks on several threads, freeing them on this thread
+    std::vector<std::vector<void *>> allocations(4);
+    std::vector<std::thread> threads;
+    for (auto &thread_allocations : allocations)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                for (unsigned i = 0; i < 100; i++)
+                {
+                    void *p = memory_manager.Allocate(i % 2 ? 64 : 1500);
+                    void *q = memory_manager.Allocate(32);
+                    if (p != nullptr) thread_allocations.push_back(p);
+                    memory_manager.Free(q);
+                }
+            });
+    }
+    for (auto &thread : threads) thread.join();
+
+    // Free the blocks allocated by other threads
+    for (auto &thread_allocations : allocations)
+    {
+        STF_ASSERT_EQ(100, thread_allocations.size());
+        for (auto *p : thread_allocations)
+        {
+            STF_ASSERT_TRUE(memory_manager.Free(p));
+        }
+    }
+
+    // Get the statistics
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(2, stats.size());
+    STF_ASSERT_EQ(600, stats[0].allocations);
+    STF_ASSERT_EQ(600, stats[0].deallocations);
+    STF_ASSERT_EQ(0, stats[0].outstanding);
+    STF_ASSERT_EQ(200, stats[1].allocations);
+    STF_ASSERT_EQ(200, stats[1].deallocations);
+    STF_ASSERT_EQ(0, stats[1].outstanding);
+    STF_ASSERT_GE(stats[1].max_outstanding, 50);
+    STF_ASSERT_LE(stats[1].max_outstanding, 200);
+}
+
+STF_TEST(MemMgr, SlabAllocations)
+{
+    std::vector<void *> allocations;
+
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed, Slab Blocks
+        {    64,      96,     200, true,           32 },
+        {  1500,      10,      10, true,           8  }
+    };
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManager memory_manager(profile);
+
+    // Allocate blocks from the first slab, which should be contiguous
+    for (unsigned i = 0; i < 8; i++)
+    {
+        void *p = memory_manager.Allocate(64);
+        STF_ASSERT_NE(nullptr, p);
+        allocations.push_back(p);
+    }
+    const auto stride = reinterpret_cast<std::uintptr_t>(allocations[0]) -
+                        reinterpret_cast<std::uintptr_t>(allocations[1]);
+    STF_ASSERT_GT(stride, 64);
+    for (std::size_t i = 1; i < allocations.size(); i++)
+    {
+        STF_ASSERT_EQ(stride,
+                      reinterpret_cast<std::uintptr_t>(allocations[i - 1]) -
+                          reinterpret_cast<std::uintptr_t>(allocations[i]));
+    }
+
+    // Allocate beyond the maximum for the second descriptor
+    for (unsigned i = 0; i < 20; i++)
+    {
+        void *p = memory_manager.Allocate(1000);
+        STF_ASSERT_NE(nullptr, p);
+        std::memset(p, 0, 1000);
+        allocations.push_back(p);
+    }
+
+    // Now free all of the memory
+    for (auto *p : allocations)
+    {
+        STF_ASSERT_TRUE(memory_manager.Free(p));
+    }
+
+    // Get the statistics
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(2, stats.size());
+    STF_ASSERT_EQ(8, stats[0].allocations);
+    STF_ASSERT_EQ(8, stats[0].deallocations);
+    STF_ASSERT_EQ(20, stats[1].allocations);
+    STF_ASSERT_EQ(20, stats[1].deallocations);
+    STF_ASSERT_EQ(20, stats[1].max_outstanding);
+    STF_ASSERT_EQ(0, stats[1].outstanding);
+    STF_ASSERT_EQ(0, stats[1].corruption_count);
+}
+
+STF_TEST(MemMgr, SlabCorruption)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed, Slab Blocks
+        {   256,       4,       4, false,          4 }
+    };
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManager memory_manager(profile);
+
+    // Allocate memory and overrun the end of the block
+    void *p = memory_manager.Allocate(256);
+    STF_ASSERT_NE(nullptr, p);
+    std::memset(p, 0, 257);
+
+    // Free the memory, which is not returned to the pool
+    STF_ASSERT_TRUE(memory_manager.Free(p));
+
+    // Get the statistics
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(1, stats[0].allocations);
+    STF_ASSERT_EQ(1, stats[0].deallocations);
+    STF_ASSERT_EQ(1, stats[0].corruption_count);
+    STF_ASSERT_EQ(0, stats[0].outstanding);
+}
+
+STF_TEST(MemMgr, DenseProfile)
+{
+    // Define a profile with many irregularly sized descriptors
+    Terra::MemoryManager::MemoryProfile profile;
+    for (std::size_t i = 1; i <= 40; i++)
+    {
+        profile.push_back({i * i * 7 + 3, 1, 4, true});
+    }
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManager memory_manager(profile);
+
+    // Allocate and free memory using a range of sizes
+    std::vector<std::uint64_t> expected(profile.size());
+    for (std::size_t size = 0; size <= profile.back().size; size += 5)
+    {
+        void *p = memory_manager.Allocate(size);
+        STF_ASSERT_NE(nullptr, p);
+        STF_ASSERT_TRUE(memory_manager.Free(p));
+
+        // Determine which descriptor should have satisfied the request
+        std::size_t index = 0;
+        while (profile[index].size < size) index++;
+        expected[index]++;
+    }
+
+    // Requests larger than any descriptor cannot be satisfied
+    STF_ASSERT_EQ(nullptr, memory_manager.Allocate(profile.back().size + 1));
+
+    // Get the statistics
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(profile.size(), stats.size());
+
+    // Ensure each request was satisfied by the smallest suitable descriptor
+    for (std::size_t i = 0; i < stats.size(); i++)
+    {
+        STF_ASSERT_EQ(profile[i].size, stats[i].size);
+        STF_ASSERT_EQ(expected[i], stats[i].allocations);
+        STF_ASSERT_EQ(expected[i], stats[i].deallocations);
+        STF_ASSERT_EQ(0, stats[i].unfulfilled);
+    }
+}
+
+STF_TEST(MemMgr, LockFreeAllocations)
+{
+    std::vector<void *> allocations;
+
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {    64,       5,      10, false   },
+        {   256,       2,      10, false   },
+        {   512,       2,      10, false   },
+        {  1500,       1,      20, false   },
+        { 65536,       0,       1, false   }
+    };
+
+    // Use the lock-free engine
+    Terra::MemoryManager::ManagerOptions options{};
+    options.lock_free = true;
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+    // Allocate memory blocks in excess of the maximum, additional allocations
+    // will be pulled from the next Descriptor (i.e., 512 block)
+    for(unsigned i = 0; i < 20; i++)
+    {
+        void *p = memory_manager.Allocate(128);
+        STF_ASSERT_NE(nullptr, p);
+        allocations.push_back(p);
+    }
+
+    // Get the statistics
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(5, stats.size());
+    STF_ASSERT_EQ(10, stats[1].allocations);
+    STF_ASSERT_EQ(10, stats[1].outstanding);
+    STF_ASSERT_EQ(10, stats[1].unfulfilled);
+    STF_ASSERT_EQ(10, stats[2].allocations);
+    STF_ASSERT_EQ(10, stats[2].max_outstanding);
+
+    // Now free all of the memory
+    for (auto *p : allocations)
+    {
+        STF_ASSERT_TRUE(memory_manager.Free(p));
+    }
+
+    // Get the statistics again
+    stats = memory_manager.GetStatistics();
+    for (std::size_t i = 0; i < stats.size(); i++)
+    {
+        STF_ASSERT_EQ(profile[i].size, stats[i].size);
+        STF_ASSERT_EQ(stats[i].allocations, stats[i].deallocations);
+        STF_ASSERT_EQ(0, stats[i].outstanding);
+        STF_ASSERT_EQ(0, stats[i].corruption_count);
+    }
+}
+
+STF_TEST(MemMgr, LockFreeCrossThread)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed, Slab Blocks
+        {    64,      64,     128, true,           16 },
+        {  1500,       8,      16, true                }
+    };
+
+    // Use the lock-free engine
+    Terra::MemoryManager::ManagerOptions options{};
+    options.lock_free = true;
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+    // Producer threads allocate blocks that consumer threads free
+    constexpr unsigned Iterations = 10000;
+    std::atomic<void *> slots[4] = {};
+    std::vector<std::thread> threads;
+    for (auto &slot : slots)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                for (unsigned i = 0; i < Iterations; i++)
+                {
+                    void *p = memory_manager.Allocate(i % 2 ? 64 : 1500);
+                    std::memset(p, 0xff, i % 2 ? 64 : 1500);
+                    while (slot.load() != nullptr) std::this_thread::yield();
+                    slot.store(p);
+                }
+            });
+        threads.emplace_back(
+            [&]()
+            {
+                for (unsigned i = 0; i < Iterations; i++)
+                {
+                    void *p = nullptr;
+                    while ((p = slot.exchange(nullptr)) == nullptr)
+                    {
+                        std::this_thread::yield();
+                    }
+                    memory_manager.Free(p);
+                }
+            });
+    }
+    for (auto &thread : threads) thread.join();
+
+    // Get the statistics
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(2, stats.size());
+    for (std::size_t i = 0; i < stats.size(); i++)
+    {
+        STF_ASSERT_EQ(2 * Iterations, stats[i].allocations);
+        STF_ASSERT_EQ(2 * Iterations, stats[i].deallocations);
+        STF_ASSERT_EQ(0, stats[i].outstanding);
+        STF_ASSERT_EQ(0, stats[i].corruption_count);
+        STF_ASSERT_EQ(0, stats[i].unfulfilled);
+    }
+}
+
+STF_TEST(MemMgr, CompactHeaders)
+{
+    std::vector<void *> allocations;
+
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {    16,      64,     128, true    },
+        {  1500,       4,       8, true    },
+        { 70000,       0,       1, true    }
+    };
+
+    // Use compact headers
+    Terra::MemoryManager::ManagerOptions options{};
+    options.compact_headers = true;
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+    // Small blocks should be packed closely together
+    for (unsigned i = 0; i < 8; i++)
+    {
+        void *p = memory_manager.Allocate(16);
+        STF_ASSERT_NE(nullptr, p);
+        allocations.push_back(p);
+    }
+    const auto stride = reinterpret_cast<std::uintptr_t>(allocations[0]) -
+                        reinterpret_cast<std::uintptr_t>(allocations[1]);
+    STF_ASSERT_GT(stride, 16);
+    STF_ASSERT_LE(stride, 48);
+
+    // Allocate beyond the maximum of the other descriptors
+    for (unsigned i = 0; i < 20; i++)
+    {
+        void *p = memory_manager.Allocate(1000);
+        STF_ASSERT_NE(nullptr, p);
+        std::memset(p, 0, 1000);
+        allocations.push_back(p);
+    }
+    for (unsigned i = 0; i < 3; i++)
+    {
+        void *p = memory_manager.Allocate(70000);
+        STF_ASSERT_NE(nullptr, p);
+        std::memset(p, 0, 70000);
+        allocations.push_back(p);
+    }
+
+    // All allocations should be suitably aligned
+    for (auto *p : allocations)
+    {
+        STF_ASSERT_EQ(0,
+                      reinterpret_cast<std::uintptr_t>(p) %
+                          alignof(std::max_align_t));
+    }
+
+    // Now free all of the memory
+    for (auto *p : allocations)
+    {
+        STF_ASSERT_TRUE(memory_manager.Free(p));
+    }
+
+    // Get the statistics
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(3, stats.size());
+    STF_ASSERT_EQ(8, stats[0].allocations);
+    STF_ASSERT_EQ(8, stats[0].deallocations);
+    STF_ASSERT_EQ(20, stats[1].allocations);
+    STF_ASSERT_EQ(20, stats[1].deallocations);
+    STF_ASSERT_EQ(3, stats[2].allocations);
+    STF_ASSERT_EQ(3, stats[2].deallocations);
+    for (std::size_t i = 0; i < stats.size(); i++)
+    {
+        STF_ASSERT_EQ(0, stats[i].outstanding);
+        STF_ASSERT_EQ(0, stats[i].corruption_count);
+    }
+
+    // Memory not belonging to this Memory Manager should be rejected
+    Terra::MemoryManager::MemoryManager other(profile, options);
+    void *p = other.Allocate(16);
+    STF_ASSERT_FALSE(memory_manager.Free(p));
+    STF_ASSERT_TRUE(other.Free(p));
+}
+
+STF_TEST(MemMgr, CompactCorruption)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {    32,       8,       8, true    }
+    };
+
+    // Use compact headers
+    Terra::MemoryManager::ManagerOptions options{};
+    options.compact_headers = true;
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+    // Allocate memory and overrun the end of the block
+    void *p = memory_manager.Allocate(32);
+    STF_ASSERT_NE(nullptr, p);
+    std::memset(p, 0, 33);
+
+    // Free the memory, which is not returned to the pool
+    STF_ASSERT_TRUE(memory_manager.Free(p));
+
+    // Get the statistics
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(1, stats[0].allocations);
+    STF_ASSERT_EQ(1, stats[0].deallocations);
+    STF_ASSERT_EQ(1, stats[0].corruption_count);
+    STF_ASSERT_EQ(0, stats[0].outstanding);
+}
+
+STF_TEST(MemMgr, CompactLockFree)
+{
+    std::vector<void *> allocations;
+
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {    24,      16,      32, true    },
+        {   512,       2,       4, true    }
+    };
+
+    // Use the lock-free engine with compact headers
+    Terra::MemoryManager::ManagerOptions options{};
+    options.lock_free = true;
+    options.compact_headers = true;
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+    // Allocate, free, and allocate again to reuse free blocks
+    for (unsigned round = 0; round < 2; round++)
+    {
+        for (unsigned i = 0; i < 40; i++)
+        {
+            void *p = memory_manager.Allocate(i % 2 ? 24 : 512);
+            STF_ASSERT_NE(nullptr, p);
+            std::memset(p, 0xff, i % 2 ? 24 : 512);
+            allocations.push_back(p);
+        }
+        for (auto *p : allocations)
+        {
+            STF_ASSERT_TRUE(memory_manager.Free(p));
+        }
+        allocations.clear();
+    }
+
+    // Get the statistics
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(2, stats.size());
+    for (std::size_t i = 0; i < stats.size(); i++)
+    {
+        STF_ASSERT_EQ(40, stats[i].allocations);
+        STF_ASSERT_EQ(40, stats[i].deallocations);
+        STF_ASSERT_EQ(0, stats[i].outstanding);
+        STF_ASSERT_EQ(0, stats[i].corruption_count);
+    }
+}
+
+STF_TEST(MemMgr, DescriptorAlignment)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed, Slab Blocks, Alignment
+        {    48,       4,       8, true,           0,           64   },
+        {  4096,       2,       4, true,           2,           4096 },
+        {  8192,       0,       4, true,           0,           24   }
+    };
+
+    // Test both the standard and compact header layouts
+    for (bool compact : {false, true})
+    {
+        std::vector<void *> allocations;
+
+        Terra::MemoryManager::ManagerOptions options{};
+        options.compact_headers = compact;
+
+        // Create a Memory Manager for the given profile
+        Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+        // Allocate memory in excess of the maximum
+        for (unsigned i = 0; i < 10; i++)
+        {
+            void *p = memory_manager.Allocate(48);
+            STF_ASSERT_NE(nullptr, p);
+            STF_ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(p) % 64);
+            std::memset(p, 0, 48);
+            allocations.push_back(p);
+
+            p = memory_manager.Allocate(4096);
+            STF_ASSERT_NE(nullptr, p);
+            STF_ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(p) % 4096);
+            std::memset(p, 0, 4096);
+            allocations.push_back(p);
+
+            // An invalid alignment value results in the default alignment
+            p = memory_manager.Allocate(8192);
+            STF_ASSERT_NE(nullptr, p);
+            STF_ASSERT_EQ(0,
+                          reinterpret_cast<std::uintptr_t>(p) %
+                              alignof(std::max_align_t));
+            allocations.push_back(p);
+        }
+
+        // Now free all of the memory
+        for (auto *p : allocations)
+        {
+            STF_ASSERT_TRUE(memory_manager.Free(p));
+        }
+
+        // Get the statistics
+        auto stats = memory_manager.GetStatistics();
+        STF_ASSERT_EQ(3, stats.size());
+        for (std::size_t i = 0; i < stats.size(); i++)
+        {
+            STF_ASSERT_EQ(10, stats[i].allocations);
+            STF_ASSERT_EQ(10, stats[i].deallocations);
+            STF_ASSERT_EQ(0, stats[i].outstanding);
+            STF_ASSERT_EQ(0, stats[i].corruption_count);
+        }
+    }
+}
+
+STF_TEST(MemMgr, BatchAllocations)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed, Slab Blocks
+        {  2048,      32,      64, false,          16 },
+        {  4096,       8,      16, false               }
+    };
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManager memory_manager(profile);
+
+    // Allocate a batch that the first descriptor can satisfy
+    std::vector<void *> allocations(100, nullptr);
+    STF_ASSERT_EQ(48,
+                  memory_manager.AllocateBatch(1500, 48, allocations.data()));
+    for (std::size_t i = 0; i < 48; i++)
+    {
+        STF_ASSERT_NE(nullptr, allocations[i]);
+        std::memset(allocations[i], 0, 1500);
+    }
+
+    // Allocate a batch that spills into the next descriptor, then is limited
+    STF_ASSERT_EQ(32,
+                  memory_manager.AllocateBatch(1500,
+                                               52,
+                                               allocations.data() + 48));
+    for (std::size_t i = 48; i < 80; i++)
+    {
+        STF_ASSERT_NE(nullptr, allocations[i]);
+        std::memset(allocations[i], 0, 1500);
+    }
+
+    // Get the statistics
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(2, stats.size());
+    STF_ASSERT_EQ(64, stats[0].allocations);
+    STF_ASSERT_EQ(64, stats[0].outstanding);
+    STF_ASSERT_EQ(1, stats[0].unfulfilled);
+    STF_ASSERT_EQ(16, stats[1].allocations);
+    STF_ASSERT_EQ(16, stats[1].max_outstanding);
+    STF_ASSERT_EQ(1, stats[1].unfulfilled);
+
+    // Free the memory in a batch, including one foreign pointer
+    std::uint64_t foreign[32] = {};
+    allocations[80] = &foreign[16];
+    STF_ASSERT_EQ(80, memory_manager.FreeBatch(allocations.data(), 81));
+
+    // Get the statistics again
+    stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(64, stats[0].deallocations);
+    STF_ASSERT_EQ(0, stats[0].outstanding);
+    STF_ASSERT_EQ(16, stats[1].deallocations);
+    STF_ASSERT_EQ(0, stats[1].outstanding);
+
+    // The same functions work with thread caches
+    Terra::MemoryManager::ManagerOptions options{};
+    options.thread_cache = true;
+    Terra::MemoryManager::MemoryManager cached_manager(profile, options);
+    STF_ASSERT_EQ(80,
+                  cached_manager.AllocateBatch(100, 100, allocations.data()));
+    STF_ASSERT_EQ(80, cached_manager.FreeBatch(allocations.data(), 80));
+    stats = cached_manager.GetStatistics();
+    STF_ASSERT_EQ(64, stats[0].allocations);
+    STF_ASSERT_EQ(64, stats[0].deallocations);
+    STF_ASSERT_EQ(16, stats[1].allocations);
+    STF_ASSERT_EQ(16, stats[1].deallocations);
+}
+
+STF_TEST(MemMgr, SizedFree)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {    64,       4,       8, true    },
+        {   256,       4,       8, true    }
+    };
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManager memory_manager(profile);
+
+    // Free memory giving the size originally requested
+    void *p = memory_manager.Allocate(48);
+    STF_ASSERT_NE(nullptr, p);
+    STF_ASSERT_TRUE(memory_manager.Free(p, 48));
+
+    // A size larger than the block indicates corruption
+    p = memory_manager.Allocate(200);
+    STF_ASSERT_NE(nullptr, p);
+    STF_ASSERT_TRUE(memory_manager.Free(p, 300));
+
+    // Get the statistics
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(1, stats[0].deallocations);
+    STF_ASSERT_EQ(0, stats[0].corruption_count);
+    STF_ASSERT_EQ(1, stats[1].deallocations);
+    STF_ASSERT_EQ(1, stats[1].corruption_count);
+    STF_ASSERT_EQ(0, stats[1].outstanding);
+}
+
+STF_TEST(MemMgr, UnvalidatedFree)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {    64,       4,       8, true    },
+        {   256,       4,       8, true    }
+    };
+
+    // Test both the standard and compact header layouts
+    for (bool compact : {false, true})
+    {
+        std::vector<void *> allocations;
+
+        // Do not validate blocks when freed
+        Terra::MemoryManager::ManagerOptions options{};
+        options.compact_headers = compact;
+        options.validate_blocks = false;
+
+        // Create a Memory Manager for the given profile
+        Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+        // Allocate memory in excess of the maximum
+        for (unsigned i = 0; i < 20; i++)
+        {
+            void *p = memory_manager.Allocate(i % 2 ? 64 : 256);
+            STF_ASSERT_NE(nullptr, p);
+            allocations.push_back(p);
+        }
+
+        // Now free all of the memory, alternately passing the size
+        for (std::size_t i = 0; i < allocations.size(); i++)
+        {
+            if (i % 4 < 2)
+            {
+                STF_ASSERT_TRUE(
+                    memory_manager.Free(allocations[i], i % 2 ? 64 : 256));
+            }
+            else
+            {
+                STF_ASSERT_TRUE(memory_manager.Free(allocations[i]));
+            }
+        }
+
+        // Get the statistics
+        auto stats = memory_manager.GetStatistics();
+        STF_ASSERT_EQ(2, stats.size());
+        for (std::size_t i = 0; i < stats.size(); i++)
+        {
+            STF_ASSERT_EQ(10, stats[i].allocations);
+            STF_ASSERT_EQ(10, stats[i].deallocations);
+            STF_ASSERT_EQ(10, stats[i].max_outstanding);
+            STF_ASSERT_EQ(0, stats[i].outstanding);
+            STF_ASSERT_EQ(0, stats[i].corruption_count);
+        }
+    }
+}
+
+STF_TEST(MemMgr, StatisticsSnapshot)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {    64,      16,      32, true    },
+        {  1500,       8,      16, true    }
+    };
+
+    // Test with both the mutex and thread caches
+    for (bool thread_cache : {false, true})
+    {
+        Terra::MemoryManager::ManagerOptions options{};
+        options.thread_cache = thread_cache;
+
+        // Create a Memory Manager for the given profile
+        Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+        // Take snapshots while other threads allocate and free memory
+        constexpr unsigned Iterations = 5000;
+        std::atomic<bool> done = false;
+        std::atomic<bool> consistent = true;
+        std::atomic<unsigned> failures = 0;
+        std::thread poller(
+            [&]()
+            {
+                std::vector<Terra::MemoryManager::Statistics> snapshot;
+                while (!done)
+                {
+                    memory_manager.GetStatistics(snapshot);
+                    if ((snapshot.size() != 2) ||
+                        (snapshot[0].size != 64) ||
+                        (snapshot[1].size != 1500) ||
+                        (snapshot[0].outstanding >
+                         snapshot[0].max_outstanding) ||
+                        (snapshot[1].outstanding >
+                         snapshot[1].max_outstanding))
+                    {
+                        consistent = false;
+                    }
+                    std::this_thread::yield();
+                }
+            });
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < 2; t++)
+        {
+            threads.emplace_back(
+                [&]()
+                {
+                    for (unsigned i = 0; i < Iterations; i++)
+                    {
+                        void *p = memory_manager.Allocate(i % 2 ? 64 : 1500);
+                        if (!memory_manager.Free(p)) failures++;
+                    }
+                });
+        }
+        for (auto &thread : threads) thread.join();
+        done = true;
+        poller.join();
+        STF_ASSERT_TRUE(consistent);
+        STF_ASSERT_EQ(0, failures);
+
+        // A snapshot reuses the storage of the given vector
+        std::vector<Terra::MemoryManager::Statistics> stats(5);
+        memory_manager.GetStatistics(stats);
+        STF_ASSERT_EQ(2, stats.size());
+        for (std::size_t i = 0; i < stats.size(); i++)
+        {
+            STF_ASSERT_EQ(Iterations, stats[i].allocations);
+            STF_ASSERT_EQ(Iterations, stats[i].deallocations);
+            STF_ASSERT_EQ(0, stats[i].outstanding);
+            STF_ASSERT_GE(stats[i].max_outstanding, 1);
+        }
+    }
+}
+
+STF_TEST(MemMgr, AdaptiveProfile)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {    64,       2,       4, false   },
+        {   256,       0,       4, true    }
+    };
+
+    // Adapt the profile to observed usage
+    Terra::MemoryManager::ManagerOptions options{};
+    options.adaptive = true;
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+    // Allocate and free many blocks several times
+    std::set<void *> steady_state;
+    for (unsigned round = 0; round < 3; round++)
+    {
+        std::vector<void *> allocations;
+        for (unsigned i = 0; i < 6; i++)
+        {
+            void *p = memory_manager.Allocate(64);
+            STF_ASSERT_NE(nullptr, p);
+            allocations.push_back(p);
+        }
+        for (unsigned i = 0; i < 20; i++)
+        {
+            void *p = memory_manager.Allocate(200);
+            STF_ASSERT_NE(nullptr, p);
+            allocations.push_back(p);
+        }
+
+        // Once adapted, the same blocks should be reused from the pool
+        // (the first four blocks are from the first descriptor)
+        for (std::size_t i = 4; i < allocations.size(); i++)
+        {
+            if (round == 1)
+            {
+                steady_state.insert(allocations[i]);
+            }
+            else if (round == 2)
+            {
+                STF_ASSERT_TRUE(steady_state.contains(allocations[i]));
+            }
+        }
+
+        for (auto *p : allocations)
+        {
+            STF_ASSERT_TRUE(memory_manager.Free(p));
+        }
+    }
+
+    // The maximum of the first descriptor is a hard limit
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(12, stats[0].allocations);
+    STF_ASSERT_EQ(4, stats[0].max_outstanding);
+    STF_ASSERT_EQ(6, stats[0].unfulfilled);
+    STF_ASSERT_EQ(66, stats[1].allocations);
+    STF_ASSERT_EQ(22, stats[1].max_outstanding);
+
+    // Get the recommended profile
+    auto recommended = memory_manager.GetRecommendedProfile();
+    STF_ASSERT_EQ(2, recommended.size());
+    STF_ASSERT_EQ(64, recommended[0].size);
+    STF_ASSERT_EQ(5, recommended[0].minimum);
+    STF_ASSERT_EQ(8, recommended[0].maximum);
+    STF_ASSERT_FALSE(recommended[0].excess_allowed);
+    STF_ASSERT_EQ(256, recommended[1].size);
+    STF_ASSERT_EQ(27, recommended[1].minimum);
+    STF_ASSERT_EQ(27, recommended[1].maximum);
+    STF_ASSERT_TRUE(recommended[1].excess_allowed);
+}
+
+STF_TEST(MemMgr, NumaPools)
+{
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {    64,      10,      20, true  },
+        {  1500,       2,       4, false }
+    };
+
+    Terra::MemoryManager::ManagerOptions options;
+    options.numa = true;
+
+    Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+    // Allocate blocks from the pools for the current node
+    std::vector<void *> allocations;
+    for (unsigned i = 0; i < 30; i++)
+    {
+        void *p = memory_manager.Allocate(32);
+        STF_ASSERT_NE(nullptr, p);
+        std::memset(p, 0xa5, 32);
+        allocations.push_back(p);
+    }
+
+    // Blocks are allocated and freed from other threads as well
+    std::atomic<unsigned> failures = 0;
+    std::thread thread(
+        [&]()
+        {
+            std::vector<void *> blocks(8);
+            if (memory_manager.AllocateBatch(1024, 8, blocks.data()) != 4)
+            {
+                failures++;
+            }
+            if (memory_manager.FreeBatch(blocks.data(), 4) != 4) failures++;
+            if (!memory_manager.Free(allocations.back())) failures++;
+        });
+    thread.join();
+    STF_ASSERT_EQ(0, failures);
+    allocations.pop_back();
+
+    // Memory not allocated by the Memory Manager is rejected
+    Terra::MemoryManager::MemoryManager other(profile);
+    void *foreign = other.Allocate(32);
+    STF_ASSERT_NE(nullptr, foreign);
+    STF_ASSERT_FALSE(memory_manager.Free(foreign));
+    STF_ASSERT_FALSE(memory_manager.Free(nullptr));
+    STF_ASSERT_TRUE(other.Free(foreign));
+
+    for (auto *p : allocations)
+    {
+        STF_ASSERT_TRUE(memory_manager.Free(p));
+    }
+
+    // Statistics are summed over all nodes
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(2, stats.size());
+    STF_ASSERT_EQ(64, stats[0].size);
+    STF_ASSERT_EQ(30, stats[0].allocations);
+    STF_ASSERT_EQ(30, stats[0].deallocations);
+    STF_ASSERT_EQ(0, stats[0].outstanding);
+    STF_ASSERT_EQ(4, stats[1].allocations);
+    STF_ASSERT_EQ(4, stats[1].deallocations);
+    STF_ASSERT_EQ(0, stats[1].corruption_count);
+
+    // The recommended profile covers the usage of each node
+    auto recommended = memory_manager.GetRecommendedProfile();
+    STF_ASSERT_EQ(2, recommended.size());
+    STF_ASSERT_EQ(64, recommended[0].size);
+    STF_ASSERT_EQ(1500, recommended[1].size);
+}
+
+STF_TEST(MemMgr, MappedSlabs)
+{
+    using Terra::MemoryManager::MemorySource;
+
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed, Slab Blocks, Alignment,
+        // Source, Prefault, Lock Pages
+        {    64,     100,     100, true,  0,    0, MemorySource::Pages,
+             true,  true  },
+        {  1500,      40,      50, true,  0,    0, MemorySource::HugePages,
+             false, false },
+        {  4000,       4,       8, true,  2, 8192, MemorySource::Pages,
+             true,  false },
+        { 65535,       2,       4, true,  0,    0, MemorySource::HugePages,
+             true,  false }
+    };
+
+    Terra::MemoryManager::MemoryManager memory_manager(profile);
+
+    // Allocate all blocks, including some in excess of the maximum
+    std::vector<std::pair<void *, std::size_t>> allocations;
+    for (std::size_t index = 0; index < profile.size(); index++)
+    {
+        for (std::size_t i = 0; i < profile[index].maximum + 2; i++)
+        {
+            void *p = memory_manager.Allocate(profile[index].size);
+            STF_ASSERT_NE(nullptr, p);
+            std::memset(p, 0xa5, profile[index].size);
+            allocations.emplace_back(p, profile[index].size);
+        }
+    }
+
+    // Blocks having a stricter alignment are aligned as requested
+    for (auto [p, size] : allocations)
+    {
+        if (size == 4000)
+        {
+            STF_ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(p) % 8192);
+        }
+    }
+
+    for (auto [p, size] : allocations)
+    {
+        STF_ASSERT_TRUE(memory_manager.Free(p, size));
+    }
+
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(4, stats.size());
+    STF_ASSERT_EQ(102, stats[0].allocations);
+    STF_ASSERT_EQ(52, stats[1].allocations);
+    STF_ASSERT_EQ(10, stats[2].allocations);
+    STF_ASSERT_EQ(6, stats[3].allocations);
+    for (const auto &statistic : stats)
+    {
+        STF_ASSERT_EQ(0, statistic.corruption_count);
+        STF_ASSERT_EQ(0, statistic.outstanding);
+    }
+}
+
+STF_TEST(MemMgr, AlignedAllocate)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed, Slab Blocks, Alignment
+        {    64,       4,       8, true,           0,           0    },
+        {   256,       2,       4, true,           0,           0    },
+        {  2048,       2,       4, true,           0,           4096 }
+    };
+
+    // Test each engine along with the compact header layout
+    for (unsigned variant = 0; variant < 4; variant++)
+    {
+        Terra::MemoryManager::ManagerOptions options{};
+        options.compact_headers = (variant == 1);
+        options.lock_free = (variant == 2);
+        options.thread_cache = (variant == 3);
+
+        // Create a Memory Manager for the given profile
+        Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+        // Default alignment is satisfied by the smallest descriptor
+        void *p1 = memory_manager.Allocate(32, 1);
+        STF_ASSERT_NE(nullptr, p1);
+        void *p2 = memory_manager.Allocate(32, alignof(std::max_align_t));
+        STF_ASSERT_NE(nullptr, p2);
+
+        // Page alignment is satisfied only by the last descriptor
+        void *p3 = memory_manager.Allocate(32, 4096);
+        STF_ASSERT_NE(nullptr, p3);
+        STF_ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(p3) % 4096);
+        void *p4 = memory_manager.Allocate(1024, 2048);
+        STF_ASSERT_NE(nullptr, p4);
+        STF_ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(p4) % 4096);
+
+        // Requests that no descriptor can satisfy fail
+        STF_ASSERT_EQ(nullptr, memory_manager.Allocate(32, 8192));
+        STF_ASSERT_EQ(nullptr, memory_manager.Allocate(4096, 4096));
+        STF_ASSERT_EQ(nullptr, memory_manager.Allocate(32, 24));
+
+        for (void *p : {p1, p2, p3, p4})
+        {
+            STF_ASSERT_TRUE(memory_manager.Free(p));
+        }
+
+        // Get the statistics
+        auto stats = memory_manager.GetStatistics();
+        STF_ASSERT_EQ(3, stats.size());
+        STF_ASSERT_EQ(2, stats[0].allocations);
+        STF_ASSERT_EQ(0, stats[1].allocations);
+        STF_ASSERT_EQ(2, stats[2].allocations);
+        for (const auto &statistic : stats)
+        {
+            STF_ASSERT_EQ(statistic.allocations, statistic.deallocations);
+            STF_ASSERT_EQ(0, statistic.outstanding);
+            STF_ASSERT_EQ(0, statistic.unfulfilled);
+        }
+    }
+}
+
+STF_TEST(MemMgr, BackgroundReplenish)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed, Slab Blocks
+        {    64,       0,      32, true,           0  },
+        {   256,       4,      16, false,          0  },
+        {  1500,       0,      64, true,           16 }
+    };
+
+    // Test with and without thread caches, and while adapting to usage so
+    // that adapted descriptors are pre-allocated in the background
+    for (unsigned variant = 0; variant < 3; variant++)
+    {
+        Terra::MemoryManager::ManagerOptions options{};
+        options.replenish = true;
+        options.replenish_watermark = 8;
+        options.thread_cache = (variant == 1);
+        options.adaptive = (variant == 2);
+
+        // Create a Memory Manager for the given profile
+        Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+        // Several threads allocate and free memory, exceeding the maximum
+        std::atomic<unsigned> failures = 0;
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < 4; t++)
+        {
+            threads.emplace_back(
+                [&]()
+                {
+                    for (unsigned round = 0; round < 50; round++)
+                    {
+                        std::vector<void *> allocations;
+                        for (unsigned i = 0; i < 20; i++)
+                        {
+                            void *p = memory_manager.Allocate(48);
+                            if (p == nullptr) failures++;
+                            allocations.push_back(p);
+                            p = memory_manager.Allocate(1024);
+                            if (p == nullptr) failures++;
+                            allocations.push_back(p);
+                        }
+                        for (auto *p : allocations)
+                        {
+                            if (!memory_manager.Free(p)) failures++;
+                        }
+                    }
+                });
+        }
+        for (auto &thread : threads) thread.join();
+        STF_ASSERT_EQ(0, failures);
+
+        // The limit of a descriptor not allowing excess is never exceeded,
+        // so the remaining requests are satisfied by the next descriptor
+        std::vector<void *> allocations;
+        for (unsigned i = 0; i < 20; i++)
+        {
+            void *p = memory_manager.Allocate(256);
+            STF_ASSERT_NE(nullptr, p);
+            allocations.push_back(p);
+        }
+        for (auto *p : allocations)
+        {
+            STF_ASSERT_TRUE(memory_manager.Free(p));
+        }
+
+        // Get the statistics
+        auto stats = memory_manager.GetStatistics();
+        STF_ASSERT_EQ(3, stats.size());
+        STF_ASSERT_EQ(4000, stats[0].allocations);
+        STF_ASSERT_EQ(16, stats[1].allocations);
+        STF_ASSERT_EQ(4004, stats[2].allocations);
+        for (const auto &statistic : stats)
+        {
+            STF_ASSERT_EQ(statistic.allocations, statistic.deallocations);
+            STF_ASSERT_EQ(0, statistic.outstanding);
+            STF_ASSERT_EQ(0, statistic.corruption_count);
+        }
+    }
+}
+
+STF_TEST(MemMgr, RemoteFree)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {  1500,       8,       8, false }
+    };
+
+    // Enable thread caching with remote frees
+    Terra::MemoryManager::ManagerOptions options{};
+    options.thread_cache = true;
+    options.cache_high_watermark = 4;
+    options.cache_low_watermark = 2;
+    options.remote_free = true;
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+    // Allocate all of the blocks on this thread
+    std::vector<void *> allocations;
+    for (unsigned i = 0; i < 8; i++)
+    {
+        void *p = memory_manager.Allocate(1500);
+        STF_ASSERT_NE(nullptr, p);
+        allocations.push_back(p);
+    }
+    STF_ASSERT_EQ(nullptr, memory_manager.Allocate(1500));
+
+    // Free the blocks on another thread
+    bool freed = true;
+    std::thread(
+        [&]()
+        {
+            for (auto *p : allocations)
+            {
+                if (!memory_manager.Free(p)) freed = false;
+            }
+        }).join();
+    STF_ASSERT_TRUE(freed);
+
+    // The blocks are held for this thread, so another thread cannot get one
+    void *other = &other;
+    std::thread([&]() { other = memory_manager.Allocate(1500); }).join();
+    STF_ASSERT_EQ(nullptr, other);
+
+    // This thread collects the freed blocks
+    for (auto *&p : allocations)
+    {
+        p = memory_manager.Allocate(1500);
+        STF_ASSERT_NE(nullptr, p);
+    }
+    for (auto *p : allocations)
+    {
+        STF_ASSERT_TRUE(memory_manager.Free(p));
+    }
+
+    // One thread allocates blocks that another thread frees; since excess is
+    // not allowed, this only progresses if freed blocks reach the allocator
+    std::mutex pipeline_mutex;
+    std::vector<void *> pipeline;
+    std::atomic<unsigned> received = 0;
+    std::thread producer(
+        [&]()
+        {
+            for (unsigned i = 0; i < 1000;)
+            {
+                void *p = memory_manager.Allocate(1500);
+                if (p == nullptr)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                const std::lock_guard<std::mutex> lock(pipeline_mutex);
+                pipeline.push_back(p);
+                i++;
+            }
+        });
+    std::thread consumer(
+        [&]()
+        {
+            while (received < 1000)
+            {
+                void *p = nullptr;
+                {
+                    const std::lock_guard<std::mutex> lock(pipeline_mutex);
+                    if (!pipeline.empty())
+                    {
+                        p = pipeline.back();
+                        pipeline.pop_back();
+                    }
+                }
+                if (p == nullptr)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                memory_manager.Free(p);
+                received++;
+            }
+        });
+    producer.join();
+    consumer.join();
+
+    // Get the statistics
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(1, stats.size());
+    STF_ASSERT_EQ(1016, stats[0].allocations);
+    STF_ASSERT_EQ(1016, stats[0].deallocations);
+    STF_ASSERT_EQ(0, stats[0].outstanding);
+    STF_ASSERT_EQ(0, stats[0].corruption_count);
+}
+
+STF_TEST(MemMgr, RemoteFreeAfterExit)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {  1500,       8,       8, false }
+    };
+
+    // Enable thread caching with remote frees
+    Terra::MemoryManager::ManagerOptions options{};
+    options.thread_cache = true;
+    options.cache_high_watermark = 4;
+    options.cache_low_watermark = 2;
+    options.remote_free = true;
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+    // Allocate all of the blocks on a thread that then exits
+    std::vector<void *> allocations;
+    std::thread(
+        [&]()
+        {
+            for (unsigned i = 0; i < 8; i++)
+            {
+                allocations.push_back(memory_manager.Allocate(1500));
+            }
+        }).join();
+    for (auto *p : allocations) STF_ASSERT_NE(nullptr, p);
+
+    // Free the blocks on this thread; since the allocating thread exited,
+    // the blocks must not be left on its remote queue
+    for (auto *p : allocations)
+    {
+        STF_ASSERT_TRUE(memory_manager.Free(p));
+    }
+
+    // All of the blocks can be allocated again
+    for (auto *&p : allocations)
+    {
+        p = memory_manager.Allocate(1500);
+        STF_ASSERT_NE(nullptr, p);
+    }
+    STF_ASSERT_EQ(nullptr, memory_manager.Allocate(1500));
+    for (auto *p : allocations)
+    {
+        STF_ASSERT_TRUE(memory_manager.Free(p));
+    }
+
+    // Get the statistics
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(1, stats.size());
+    STF_ASSERT_EQ(16, stats[0].allocations);
+    STF_ASSERT_EQ(16, stats[0].deallocations);
+    STF_ASSERT_EQ(0, stats[0].outstanding);
+}
+
+STF_TEST(MemMgr, StripedPools)
+{
+    // Define the memory profile, with the first descriptor striped
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed, Slab Blocks, Alignment,
+        // Source, Prefault, Lock Pages, Stripes
+        {    64,      16,      16, false,          0,          0,
+             Terra::MemoryManager::MemorySource::Heap, false, false, 64 },
+        {  1500,       8,      32, true  }
+    };
+
+    // Move blocks between stripes and the shared pool in small batches
+    Terra::MemoryManager::ManagerOptions options{};
+    options.cache_high_watermark = 8;
+    options.cache_low_watermark = 4;
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+    // Allocate and free all of the striped blocks on one thread, leaving
+    // some in that thread's stripe
+    const auto allocate_all = [&]() -> unsigned
+    {
+        std::vector<void *> allocations;
+        for (unsigned i = 0; i < 16; i++)
+        {
+            void *p = memory_manager.Allocate(64);
+            if (p == nullptr) break;
+            allocations.push_back(p);
+        }
+        for (auto *p : allocations) memory_manager.Free(p);
+        return static_cast<unsigned>(allocations.size());
+    };
+    unsigned allocated = 0;
+    std::thread([&]() { allocated = allocate_all(); }).join();
+    STF_ASSERT_EQ(16, allocated);
+
+    // Another thread can obtain all of the blocks, stealing from the stripe
+    // of the first thread as necessary
+    std::thread([&]() { allocated = allocate_all(); }).join();
+    STF_ASSERT_EQ(16, allocated);
+
+    // Several threads allocate and free memory at once
+    std::vector<std::thread> threads;
+    std::atomic<unsigned> failures = 0;
+    for (unsigned t = 0; t < 4; t++)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                for (unsigned i = 0; i < 1000; i++)
+                {
+                    void *p = memory_manager.Allocate(64);
+                    void *q = memory_manager.Allocate(1500);
+                    if (q == nullptr) failures++;
+                    if ((p != nullptr) && !memory_manager.Free(p)) failures++;
+                    if (!memory_manager.Free(q)) failures++;
+                }
+            });
+    }
+    for (auto &thread : threads) thread.join();
+    STF_ASSERT_EQ(0, failures);
+
+    // Batches may mix striped and unstriped descriptors
+    std::vector<void *> allocations(8);
+    STF_ASSERT_EQ(4, memory_manager.AllocateBatch(64, 4, allocations.data()));
+    STF_ASSERT_EQ(4,
+                  memory_manager.AllocateBatch(1500,
+                                               4,
+                                               allocations.data() + 4));
+    STF_ASSERT_EQ(8, memory_manager.FreeBatch(allocations.data(), 8));
+
+    // Get the statistics
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(2, stats.size());
+    STF_ASSERT_EQ(4004, stats[1].allocations);
+    STF_ASSERT_GE(stats[0].max_outstanding, 16);
+    for (const auto &statistic : stats)
+    {
+        STF_ASSERT_EQ(statistic.allocations, statistic.deallocations);
+        STF_ASSERT_EQ(0, statistic.outstanding);
+        STF_ASSERT_EQ(0, statistic.corruption_count);
+    }
+}
+
+STF_TEST(MemMgr, FreeListReuse)
+{
+    // Define the memory profile, with no limit on the number of blocks
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {    64,       4,       0, true  }
+    };
+
+    // Test with standard and compact headers
+    for (bool compact_headers : {false, true})
+    {
+        Terra::MemoryManager::ManagerOptions options{};
+        options.compact_headers = compact_headers;
+
+        // Create a Memory Manager for the given profile
+        Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+        // Allocate many blocks, filling each one with data
+        std::vector<void *> allocations;
+        for (unsigned i = 0; i < 1000; i++)
+        {
+            void *p = memory_manager.Allocate(64);
+            STF_ASSERT_NE(nullptr, p);
+            std::memset(p, 0xff, 64);
+            allocations.push_back(p);
+        }
+
+        // Free all of the blocks, which are retained in the pool
+        for (auto *p : allocations) STF_ASSERT_TRUE(memory_manager.Free(p));
+
+        // The most recently freed block is the first to be reused, and all
+        // of the retained blocks are reused before any others
+        std::set<void *> freed(allocations.begin(), allocations.end());
+        void *last = allocations.back();
+        allocations.clear();
+        for (unsigned i = 0; i < 1000; i++)
+        {
+            void *p = memory_manager.Allocate(64);
+            if (i == 0) STF_ASSERT_EQ(last, p);
+            STF_ASSERT_EQ(1, freed.count(p));
+            allocations.push_back(p);
+        }
+        for (auto *p : allocations) STF_ASSERT_TRUE(memory_manager.Free(p));
+
+        // Get the statistics
+        auto stats = memory_manager.GetStatistics();
+        STF_ASSERT_EQ(1, stats.size());
+        STF_ASSERT_EQ(2000, stats[0].allocations);
+        STF_ASSERT_EQ(2000, stats[0].deallocations);
+        STF_ASSERT_EQ(1000, stats[0].max_outstanding);
+        STF_ASSERT_EQ(0, stats[0].outstanding);
+        STF_ASSERT_EQ(0, stats[0].corruption_count);
+    }
+}
+
+STF_TEST(MemMgr, SpillPolicies)
+{
+    using Terra::MemoryManager::MemorySource;
+    using Terra::MemoryManager::SpillPolicy;
+
+    // Create a profile with the given spill policy for the first descriptor
+    const auto make_profile = [](SpillPolicy spill, std::size_t spill_limit)
+    {
+        return Terra::MemoryManager::MemoryProfile
+        {
+            // Size, Minimum, Maximum, Excess Allowed, Slab Blocks, Alignment,
+            // Source, Prefault, Lock Pages, Stripes, Spill, Spill Limit
+            {    64,       2,       2, false,          0,          0,
+                 MemorySource::Heap, false, false, 0, spill, spill_limit },
+            {   256,       2,       2, false },
+            {  1024,       2,       2, false }
+        };
+    };
+
+    // Policies with the number of 64-octet requests that may be satisfied
+    const std::vector<std::tuple<SpillPolicy, std::size_t, unsigned>> policies =
+    {
+        { SpillPolicy::Any,     0, 6 },
+        { SpillPolicy::Limited, 1, 4 },
+        { SpillPolicy::Budget,  3, 5 },
+        { SpillPolicy::Never,   0, 2 }
+    };
+
+    // Test with each allocation engine
+    for (unsigned engine = 0; engine < 3; engine++)
+    {
+        for (auto [spill, spill_limit, expected] : policies)
+        {
+            Terra::MemoryManager::ManagerOptions options{};
+            options.thread_cache = (engine == 1);
+            options.lock_free = (engine == 2);
+
+            // Create a Memory Manager for the given profile
+            Terra::MemoryManager::MemoryManager memory_manager(
+                make_profile(spill, spill_limit),
+                options);
+
+            // Allocate until the policy refuses to spill further
+            std::vector<void *> allocations;
+            for (unsigned i = 0; i < 8; i++)
+            {
+                void *p = memory_manager.Allocate(64);
+                if (p != nullptr) allocations.push_back(p);
+            }
+            STF_ASSERT_EQ(expected, allocations.size());
+
+            // Freeing a spilled block returns its share of a spill budget
+            if (spill == SpillPolicy::Budget)
+            {
+                STF_ASSERT_TRUE(memory_manager.Free(allocations.back()));
+                allocations.back() = memory_manager.Allocate(64);
+                STF_ASSERT_NE(nullptr, allocations.back());
+                STF_ASSERT_EQ(nullptr, memory_manager.Allocate(64));
+            }
+
+            // The larger descriptors remain available to larger requests
+            if (spill == SpillPolicy::Never)
+            {
+                void *p = memory_manager.Allocate(1024);
+                STF_ASSERT_NE(nullptr, p);
+                STF_ASSERT_TRUE(memory_manager.Free(p));
+            }
+
+            for (auto *p : allocations)
+            {
+                STF_ASSERT_TRUE(memory_manager.Free(p));
+            }
+
+            // Get the statistics
+            auto stats = memory_manager.GetStatistics();
+            STF_ASSERT_EQ(3, stats.size());
+            STF_ASSERT_EQ((spill == SpillPolicy::Budget) ? 4 : expected - 2,
+                          stats[0].spilled);
+            STF_ASSERT_EQ(0, stats[1].spilled);
+            for (const auto &statistic : stats)
+            {
+                STF_ASSERT_EQ(statistic.allocations, statistic.deallocations);
+                STF_ASSERT_EQ(0, statistic.outstanding);
+            }
+        }
+    }
+
+    // Batches observe the spill budget
+    Terra::MemoryManager::MemoryManager memory_manager(
+        make_profile(SpillPolicy::Budget, 3));
+    std::vector<void *> allocations(8);
+    STF_ASSERT_EQ(5, memory_manager.AllocateBatch(64, 8, allocations.data()));
+    STF_ASSERT_EQ(5, memory_manager.FreeBatch(allocations.data(), 5));
+    STF_ASSERT_EQ(5, memory_manager.AllocateBatch(64, 8, allocations.data()));
+    STF_ASSERT_EQ(5, memory_manager.FreeBatch(allocations.data(), 5));
+    STF_ASSERT_EQ(6, memory_manager.GetStatistics()[0].spilled);
+}
+
+STF_TEST(MemMgr, Reallocate)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed, Slab Blocks, Alignment
+        {    64,       4,       8, true,           0,           0    },
+        {   256,       2,       4, true,           0,           0    },
+        {  1024,       1,       1, false,          0,           4096 }
+    };
+
+    // Test with each allocation engine
+    for (unsigned engine = 0; engine < 3; engine++)
+    {
+        Terra::MemoryManager::ManagerOptions options{};
+        options.thread_cache = (engine == 1);
+        options.lock_free = (engine == 2);
+
+        // Create a Memory Manager for the given profile
+        Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+        // The usable size is that of the descriptor providing the block
+        auto *p = static_cast<std::uint8_t *>(memory_manager.Allocate(10));
+        STF_ASSERT_NE(nullptr, p);
+        STF_ASSERT_EQ(64, memory_manager.UsableSize(p));
+        for (unsigned i = 0; i < 64; i++) p[i] = static_cast<std::uint8_t>(i);
+
+        // Growing within the usable size or shrinking does not move the block
+        STF_ASSERT_EQ(p, memory_manager.Reallocate(p, 64));
+        STF_ASSERT_EQ(p, memory_manager.Reallocate(p, 1));
+
+        // Growing beyond the usable size moves the contents
+        auto *q =
+            static_cast<std::uint8_t *>(memory_manager.Reallocate(p, 200));
+        STF_ASSERT_NE(nullptr, q);
+        STF_ASSERT_EQ(256, memory_manager.UsableSize(q));
+        for (unsigned i = 0; i < 64; i++) STF_ASSERT_EQ(i, q[i]);
+
+        // A stricter alignment also moves the block
+        p = static_cast<std::uint8_t *>(
+            memory_manager.Reallocate(q, 200, 4096));
+        STF_ASSERT_NE(nullptr, p);
+        STF_ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(p) % 4096);
+        STF_ASSERT_EQ(1024, memory_manager.UsableSize(p));
+        for (unsigned i = 0; i < 64; i++) STF_ASSERT_EQ(i, p[i]);
+
+        // If the request cannot be satisfied, the original block remains
+        void *r = memory_manager.Allocate(100);
+        STF_ASSERT_NE(nullptr, r);
+        STF_ASSERT_EQ(nullptr, memory_manager.Reallocate(r, 1000));
+        STF_ASSERT_EQ(256, memory_manager.UsableSize(r));
+        STF_ASSERT_TRUE(memory_manager.Free(r));
+
+        // A null pointer requests a new block, while invalid blocks fail
+        r = memory_manager.Reallocate(nullptr, 64);
+        STF_ASSERT_NE(nullptr, r);
+        STF_ASSERT_TRUE(memory_manager.Free(r));
+        std::uint64_t buffer[16]{};
+        STF_ASSERT_EQ(nullptr, memory_manager.Reallocate(&buffer[8], 64));
+        STF_ASSERT_EQ(0, memory_manager.UsableSize(&buffer[8]));
+        STF_ASSERT_EQ(0, memory_manager.UsableSize(nullptr));
+
+        STF_ASSERT_TRUE(memory_manager.Free(p));
+
+        // Get the statistics
+        auto stats = memory_manager.GetStatistics();
+        STF_ASSERT_EQ(3, stats.size());
+        STF_ASSERT_EQ(2, stats[0].allocations);
+        STF_ASSERT_EQ(2, stats[1].allocations);
+        STF_ASSERT_EQ(1, stats[2].allocations);
+        for (const auto &statistic : stats)
+        {
+            STF_ASSERT_EQ(statistic.allocations, statistic.deallocations);
+            STF_ASSERT_EQ(0, statistic.outstanding);
+            STF_ASSERT_EQ(0, statistic.corruption_count);
+        }
+    }
+}
+
+// Coroutine type that runs immediately and is destroyed on completion
+struct DetachedTask
+{
+    struct promise_type
+    {
+        DetachedTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+// Coroutine that awaits a block and records the order in which it was served
+DetachedTask AwaitBlock(Terra::MemoryManager::MemoryManager &memory_manager,
+                        std::size_t size,
+                        void *&block,
+                        std::vector<unsigned> &order,
+                        unsigned id)
+{
+    block = co_await memory_manager.AllocateAsync(size);
+    order.push_back(id);
+}
+
+STF_TEST(MemMgr, WaitingAllocations)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {    64,       1,       1, false }
+    };
+
+    // Test with each allocation engine
+    for (unsigned engine = 0; engine < 3; engine++)
+    {
+        Terra::MemoryManager::ManagerOptions options{};
+        options.thread_cache = (engine == 1);
+        options.lock_free = (engine == 2);
+
+        // Create a Memory Manager for the given profile
+        Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+        // Exhaust the pool
+        void *p = memory_manager.Allocate(64);
+        STF_ASSERT_NE(nullptr, p);
+
+        // Coroutines awaiting a block are suspended
+        std::vector<unsigned> order;
+        void *first = nullptr;
+        void *second = nullptr;
+        AwaitBlock(memory_manager, 64, first, order, 1);
+        AwaitBlock(memory_manager, 32, second, order, 2);
+        STF_ASSERT_TRUE(order.empty());
+
+        // A request too large for the profile never waits
+        void *none = &order;
+        AwaitBlock(memory_manager, 100, none, order, 0);
+        STF_ASSERT_EQ(1, order.size());
+        STF_ASSERT_EQ(nullptr, none);
+        STF_ASSERT_EQ(nullptr, memory_manager.AllocateWait(100));
+        order.clear();
+
+        // A waiting thread gives up after the timeout
+        STF_ASSERT_EQ(nullptr,
+                      memory_manager.AllocateWait(
+                          64,
+                          std::chrono::milliseconds(1)));
+
+        // Freed blocks are handed to waiters in the order they waited
+        STF_ASSERT_TRUE(memory_manager.Free(p));
+        STF_ASSERT_EQ(1, order.size());
+        STF_ASSERT_EQ(p, first);
+        STF_ASSERT_TRUE(memory_manager.Free(first));
+        STF_ASSERT_EQ(2, order.size());
+        STF_ASSERT_EQ(2, order[1]);
+        STF_ASSERT_EQ(p, second);
+
+        // A thread waiting without a timeout receives the next freed block
+        void *waited = nullptr;
+        std::thread thread([&]() { waited = memory_manager.AllocateWait(64); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        STF_ASSERT_TRUE(memory_manager.Free(second));
+        thread.join();
+        STF_ASSERT_EQ(p, waited);
+        STF_ASSERT_TRUE(memory_manager.Free(waited));
+
+        // Get the statistics
+        auto stats = memory_manager.GetStatistics();
+        STF_ASSERT_EQ(4, stats[0].allocations);
+        STF_ASSERT_EQ(4, stats[0].deallocations);
+        STF_ASSERT_EQ(0, stats[0].outstanding);
+        STF_ASSERT_EQ(0, stats[0].corruption_count);
+    }
+}
+
+STF_TEST(MemMgr, Diagnostics)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {    64,       2,       2, true  },
+        {   256,       0,       0, true  }
+    };
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManager memory_manager(profile);
+
+    // Allocate more blocks than are pre-allocated, then free them
+    std::vector<void *> blocks;
+    for (unsigned i = 0; i < 4; i++)
+    {
+        blocks.push_back(memory_manager.Allocate(64));
+        STF_ASSERT_NE(nullptr, blocks.back());
+    }
+    for (void *block : blocks) STF_ASSERT_TRUE(memory_manager.Free(block));
+
+    auto diagnostics = memory_manager.GetDiagnostics();
+    STF_ASSERT_EQ(2, diagnostics.size());
+    STF_ASSERT_EQ(64, diagnostics[0].size);
+    STF_ASSERT_EQ(256, diagnostics[1].size);
+
+    // Diagnostics are collected only if enabled when built
+    std::uint64_t allocations = 0;
+    std::uint64_t frees = 0;
+    for (std::size_t i = 0; i < Terra::MemoryManager::Latency_Buckets; i++)
+    {
+        allocations += diagnostics[0].allocate_latency[i];
+        frees += diagnostics[0].free_latency[i];
+    }
+    if (allocations > 0)
+    {
+        STF_ASSERT_EQ(4, allocations);
+        STF_ASSERT_EQ(4, frees);
+        STF_ASSERT_GE(diagnostics[0].lock_acquisitions, 8);
+        STF_ASSERT_EQ(4, diagnostics[0].heap_allocations);
+        STF_ASSERT_EQ(2, diagnostics[0].heap_frees);
+    }
+    else
+    {
+        STF_ASSERT_EQ(0, frees);
+        STF_ASSERT_EQ(0, diagnostics[0].lock_acquisitions);
+        STF_ASSERT_EQ(0, diagnostics[0].heap_allocations);
+        STF_ASSERT_EQ(0, diagnostics[0].heap_frees);
+    }
+    STF_ASSERT_EQ(0, diagnostics[1].heap_allocations);
+
+    // Histogram buckets cover successively longer durations
+    STF_ASSERT_EQ(0, Terra::MemoryManager::LatencyBucketFloor(0));
+    STF_ASSERT_EQ(4, Terra::MemoryManager::LatencyBucketFloor(4));
+    STF_ASSERT_EQ(10, Terra::MemoryManager::LatencyBucketFloor(9));
+    for (std::size_t i = 1; i < Terra::MemoryManager::Latency_Buckets; i++)
+    {
+        STF_ASSERT_LT(Terra::MemoryManager::LatencyBucketFloor(i - 1),
+                      Terra::MemoryManager::LatencyBucketFloor(i));
+    }
+}
+
+STF_TEST(MemMgr, ValidationPolicies)
+{
+    using Terra::MemoryManager::ValidationPolicy;
+
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {   256,       4,       4, true    }
+    };
+
+    // Without validation, blocks are still freed and reused
+    {
+        Terra::MemoryManager::ManagerOptions options{};
+        options.validation = ValidationPolicy::Release;
+        Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+        void *p = memory_manager.Allocate(256);
+        STF_ASSERT_NE(nullptr, p);
+        std::memset(p, 0x11, 256);
+        STF_ASSERT_TRUE(memory_manager.Free(p, 512));
+        STF_ASSERT_EQ(p, memory_manager.Allocate(256));
+        STF_ASSERT_TRUE(memory_manager.Free(p));
+
+        auto stats = memory_manager.GetStatistics();
+        STF_ASSERT_EQ(2, stats[0].allocations);
+        STF_ASSERT_EQ(2, stats[0].deallocations);
+        STF_ASSERT_EQ(0, stats[0].corruption_count);
+    }
+
+    // When sampling every free, an overrun is detected
+    {
+        Terra::MemoryManager::ManagerOptions options{};
+        options.validation = ValidationPolicy::Sampling;
+        options.validation_interval = 1;
+        Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+        void *p = memory_manager.Allocate(256);
+        STF_ASSERT_NE(nullptr, p);
+        std::memset(p, 0, 257);
+        STF_ASSERT_TRUE(memory_manager.Free(p));
+
+        auto stats = memory_manager.GetStatistics();
+        STF_ASSERT_EQ(1, stats[0].corruption_count);
+        STF_ASSERT_EQ(0, stats[0].outstanding);
+    }
+
+    // When sampling rarely, the free is very likely not checked
+    {
+        Terra::MemoryManager::ManagerOptions options{};
+        options.validation = ValidationPolicy::Sampling;
+        options.validation_interval = 1000000;
+        Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+        void *p = memory_manager.Allocate(256);
+        STF_ASSERT_NE(nullptr, p);
+        std::memset(p, 0, 257);
+        STF_ASSERT_TRUE(memory_manager.Free(p));
+
+        auto stats = memory_manager.GetStatistics();
+        STF_ASSERT_EQ(0, stats[0].corruption_count);
+        STF_ASSERT_EQ(0, stats[0].outstanding);
+    }
+
+    // When debugging, new and freed memory is poisoned
+    {
+        Terra::MemoryManager::ManagerOptions options{};
+        options.validation = ValidationPolicy::Debug;
+        Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+        auto *p = static_cast<std::uint8_t *>(memory_manager.Allocate(256));
+        STF_ASSERT_NE(nullptr, p);
+        for (unsigned i = 0; i < 256; i++) STF_ASSERT_EQ(0xCD, p[i]);
+
+#ifdef __linux__
+        // The block ends just before a page boundary
+        const auto end = reinterpret_cast<std::uintptr_t>(p) + 256;
+        STF_ASSERT_LE(4096 - (end % 4096), 64);
+#endif
+
+        std::memset(p, 0x22, 256);
+        STF_ASSERT_TRUE(memory_manager.Free(p));
+        for (unsigned i = 0; i < 256; i++) STF_ASSERT_EQ(0xDD, p[i]);
+
+        // Blocks created beyond the maximum are also unmapped when freed
+        std::vector<void *> blocks;
+        for (unsigned i = 0; i < 8; i++)
+        {
+            blocks.push_back(memory_manager.Allocate(256));
+            STF_ASSERT_NE(nullptr, blocks.back());
+        }
+        for (void *block : blocks) STF_ASSERT_TRUE(memory_manager.Free(block));
+
+        auto stats = memory_manager.GetStatistics();
+        STF_ASSERT_EQ(9, stats[0].allocations);
+        STF_ASSERT_EQ(9, stats[0].deallocations);
+        STF_ASSERT_EQ(0, stats[0].corruption_count);
+        STF_ASSERT_EQ(0, stats[0].outstanding);
+    }
+
+    // Debug validation is not used with compact headers
+    {
+        Terra::MemoryManager::ManagerOptions options{};
+        options.validation = ValidationPolicy::Debug;
+        options.compact_headers = true;
+        Terra::MemoryManager::MemoryManager memory_manager(profile, options);
+
+        void *p = memory_manager.Allocate(256);
+        STF_ASSERT_NE(nullptr, p);
+        std::memset(p, 0, 257);
+        STF_ASSERT_TRUE(memory_manager.Free(p));
+        STF_ASSERT_EQ(1, memory_manager.GetStatistics()[0].corruption_count);
+    }
+}
+
+STF_TEST(MemMgr, Trim)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed, Slab Blocks
+        {    64,       2,       0, true,           0 },
+        {   256,       0,       0, true,           4 }
+    };
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManager memory_manager(profile);
+
+    // Nothing beyond the minimum is retained initially
+    STF_ASSERT_EQ(0, memory_manager.Trim(0));
+
+    // Leave a burst of blocks retained in each pool, other than one block in
+    // the second of two slabs
+    std::vector<void *> allocations;
+    for (unsigned i = 0; i < 8; i++)
+    {
+        allocations.push_back(memory_manager.Allocate(64));
+        allocations.push_back(memory_manager.Allocate(256));
+    }
+    for (void *p : allocations) STF_ASSERT_NE(nullptr, p);
+    void *held = allocations.back();
+    allocations.pop_back();
+    for (void *p : allocations) STF_ASSERT_TRUE(memory_manager.Free(p));
+
+    // A generous target releases nothing
+    STF_ASSERT_EQ(0, memory_manager.Trim(1024 * 1024));
+
+    // Trimming releases the free blocks and the wholly free slab
+    STF_ASSERT_GT(memory_manager.Trim(0), 6 * 64 + 4 * 256);
+    STF_ASSERT_EQ(0, memory_manager.Trim(0));
+
+    // Once the last block is freed, its slab may be released as well
+    STF_ASSERT_TRUE(memory_manager.Free(held));
+    STF_ASSERT_GT(memory_manager.Trim(0), 4 * 256);
+    STF_ASSERT_EQ(0, memory_manager.Trim(0));
+
+    // The pools continue to satisfy requests
+    void *p = memory_manager.Allocate(256);
+    STF_ASSERT_NE(nullptr, p);
+    STF_ASSERT_TRUE(memory_manager.Free(p));
+
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(8, stats[0].allocations);
+    STF_ASSERT_EQ(9, stats[1].allocations);
+    for (const auto &statistic : stats)
+    {
+        STF_ASSERT_EQ(statistic.allocations, statistic.deallocations);
+        STF_ASSERT_EQ(0, statistic.outstanding);
+    }
+}
+
+STF_TEST(MemMgr, ReleaseIdle)
+{
+    using namespace std::chrono_literals;
+
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {    64,       1,       0, true    },
+        {   256,       0,       0, true    }
+    };
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManager memory_manager(profile);
+
+    // Leave blocks retained in the first pool only
+    std::vector<void *> allocations;
+    for (unsigned i = 0; i < 10; i++)
+    {
+        allocations.push_back(memory_manager.Allocate(64));
+    }
+    for (void *p : allocations) STF_ASSERT_TRUE(memory_manager.Free(p));
+
+    // The pool was used since constructed, so it is not yet idle
+    STF_ASSERT_EQ(0, memory_manager.ReleaseIdle(0ns));
+
+    // Once found unchanged, the pool is released if idle for long enough
+    STF_ASSERT_EQ(0, memory_manager.ReleaseIdle(1h));
+    STF_ASSERT_GE(memory_manager.ReleaseIdle(0ns), 9 * 64);
+    STF_ASSERT_EQ(0, memory_manager.ReleaseIdle(0ns));
+    STF_ASSERT_EQ(0, memory_manager.Trim(0));
+
+    // With a decay time, idle pools are released automatically
+    Terra::MemoryManager::ManagerOptions options{};
+    options.decay_time = 10ms;
+    Terra::MemoryManager::MemoryManager decaying(profile, options);
+    allocations.clear();
+    for (unsigned i = 0; i < 10; i++)
+    {
+        allocations.push_back(decaying.Allocate(256));
+    }
+    for (void *p : allocations) STF_ASSERT_TRUE(decaying.Free(p));
+    std::this_thread::sleep_for(500ms);
+    STF_ASSERT_EQ(0, decaying.Trim(0));
+
+    auto stats = decaying.GetStatistics();
+    STF_ASSERT_EQ(10, stats[1].allocations);
+    STF_ASSERT_EQ(10, stats[1].deallocations);
+}
+
+STF_TEST(MemMgr, DeferredPreallocation)
+{
+    using Terra::MemoryManager::PreallocationPolicy;
+
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed, Slab Blocks
+        {    64,     100,       0, true,           0 },
+        {   256,     100,     100, false,          8 }
+    };
+
+    for (auto preallocation :
+         {PreallocationPolicy::Lazy, PreallocationPolicy::Background})
+    {
+        for (bool compact : {false, true})
+        {
+            Terra::MemoryManager::ManagerOptions options{};
+            options.preallocation = preallocation;
+            options.compact_headers = compact;
+            Terra::MemoryManager::MemoryManager memory_manager(profile,
+                                                               options);
+            memory_manager.WarmUp();
+
+            // Pre-allocated blocks are carved from a single reserved slab
+            std::vector<std::uintptr_t> addresses;
+            std::vector<void *> blocks;
+            for (unsigned i = 0; i < 100; i++)
+            {
+                blocks.push_back(memory_manager.Allocate(256));
+                STF_ASSERT_NE(nullptr, blocks.back());
+                addresses.push_back(
+                    reinterpret_cast<std::uintptr_t>(blocks.back()));
+            }
+            std::ranges::sort(addresses);
+            const std::uintptr_t stride = addresses[1] - addresses[0];
+            STF_ASSERT_GE(stride, 256);
+            for (std::size_t i = 1; i < addresses.size(); i++)
+            {
+                STF_ASSERT_EQ(stride, addresses[i] - addresses[i - 1]);
+            }
+
+            // The maximum still applies
+            STF_ASSERT_EQ(nullptr, memory_manager.Allocate(256));
+
+            // Blocks beyond the minimum are allocated when needed
+            for (unsigned i = 0; i < 101; i++)
+            {
+                blocks.push_back(memory_manager.Allocate(64));
+                STF_ASSERT_NE(nullptr, blocks.back());
+            }
+            for (void *block : blocks)
+            {
+                STF_ASSERT_TRUE(memory_manager.Free(block));
+            }
+
+            // Only blocks beyond the minimum may be trimmed
+            STF_ASSERT_GT(memory_manager.Trim(0), 0);
+            STF_ASSERT_EQ(0, memory_manager.Trim(0));
+
+            auto stats = memory_manager.GetStatistics();
+            STF_ASSERT_EQ(101, stats[0].allocations);
+            STF_ASSERT_EQ(100, stats[1].allocations);
+            STF_ASSERT_EQ(1, stats[1].unfulfilled);
+            for (const auto &statistic : stats)
+            {
+                STF_ASSERT_EQ(statistic.allocations, statistic.deallocations);
+                STF_ASSERT_EQ(0, statistic.corruption_count);
+            }
+        }
+    }
+}
+
+STF_TEST(MemMgr, FreeAny)
+{
+    // Define the memory profiles
+    Terra::MemoryManager::MemoryProfile standard_profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {  1500,       2,       4, true  }
+    };
+    Terra::MemoryManager::MemoryProfile compact_profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed, Slab Blocks
+        {    64,       0,       4, true,           4 },
+        {   256,       1,       0, true,           0 }
+    };
+
+    Terra::MemoryManager::ManagerOptions compact_options{};
+    compact_options.compact_headers = true;
+    compact_options.free_any = true;
+    Terra::MemoryManager::ManagerOptions release_options{};
+    release_options.validation =
+        Terra::MemoryManager::ValidationPolicy::Release;
+
+    Terra::MemoryManager::MemoryManager standard(standard_profile);
+    Terra::MemoryManager::MemoryManager compact(compact_profile,
+                                                compact_options);
+    Terra::MemoryManager::MemoryManager release(standard_profile,
+                                                release_options);
+
+    // Allocate blocks from each, including blocks beyond the slabs and the
+    // maximum for the compact Memory Manager
+    std::vector<void *> blocks;
+    for (unsigned i = 0; i < 6; i++)
+    {
+        blocks.push_back(standard.Allocate(1000));
+        blocks.push_back(compact.Allocate(50));
+        blocks.push_back(compact.Allocate(200));
+        blocks.push_back(release.Allocate(1000));
+    }
+    for (void *block : blocks) STF_ASSERT_NE(nullptr, block);
+
+    // Each block is returned to the Memory Manager that allocated it
+    for (void *block : blocks)
+    {
+        STF_ASSERT_TRUE(Terra::MemoryManager::FreeAny(block));
+    }
+
+    // Memory not provided by any Memory Manager is rejected
+    std::uint64_t buffer[32]{};
+    STF_ASSERT_FALSE(Terra::MemoryManager::FreeAny(&buffer[16]));
+    STF_ASSERT_FALSE(Terra::MemoryManager::FreeAny(nullptr));
+
+    // Blocks from released slabs are no longer located through the registry
+    STF_ASSERT_GT(compact.Trim(0), 0);
+    void *p = compact.Allocate(50);
+    STF_ASSERT_NE(nullptr, p);
+    STF_ASSERT_TRUE(Terra::MemoryManager::FreeAny(p));
+
+    for (auto *memory_manager : {&standard, &compact, &release})
+    {
+        for (const auto &statistic : memory_manager->GetStatistics())
+        {
+            STF_ASSERT_EQ(statistic.allocations, statistic.deallocations);
+            STF_ASSERT_EQ(0, statistic.outstanding);
+            STF_ASSERT_EQ(0, statistic.corruption_count);
+        }
+    }
+    STF_ASSERT_EQ(7, compact.GetStatistics()[0].allocations);
+    STF_ASSERT_EQ(6, release.GetStatistics()[0].deallocations);
+}
+
+STF_TEST(MemMgr, FreeAnyThreads)
+{
+    // Define the memory profiles
+    Terra::MemoryManager::MemoryProfile standard_profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {  1500,       4,      16, true  }
+    };
+    Terra::MemoryManager::MemoryProfile compact_profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed, Slab Blocks
+        {    64,       0,      16, true,           8 }
+    };
+
+    Terra::MemoryManager::ManagerOptions compact_options{};
+    compact_options.compact_headers = true;
+    compact_options.free_any = true;
+
+    Terra::MemoryManager::MemoryManager standard(standard_profile);
+    Terra::MemoryManager::MemoryManager compact(compact_profile,
+                                                compact_options);
+
+    // Several threads free blocks from both Memory Managers at once, while
+    // another thread creates and destroys Memory Managers of its own
+    std::atomic<unsigned> failures = 0;
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < 4; t++)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                for (unsigned i = 0; i < 1000; i++)
+                {
+                    void *a = standard.Allocate(1000);
+                    void *b = compact.Allocate(50);
+                    if (!Terra::MemoryManager::FreeAny(a)) failures++;
+                    if (!Terra::MemoryManager::FreeAny(b)) failures++;
+                }
+            });
+    }
+    threads.emplace_back(
+        [&]()
+        {
+            for (unsigned i = 0; i < 100; i++)
+            {
+                Terra::MemoryManager::MemoryManager transient(
+                    (i % 2 == 0) ? standard_profile : compact_profile,
+                    (i % 2 == 0) ? Terra::MemoryManager::ManagerOptions{}
+                                 : compact_options);
+                void *p = transient.Allocate(50);
+                if (!Terra::MemoryManager::FreeAny(p)) failures++;
+            }
+        });
+    for (auto &thread : threads) thread.join();
+    STF_ASSERT_EQ(0, failures);
+
+    for (auto *memory_manager : {&standard, &compact})
+    {
+        const auto statistics = memory_manager->GetStatistics();
+        STF_ASSERT_EQ(4000, statistics[0].allocations);
+        STF_ASSERT_EQ(4000, statistics[0].deallocations);
+        STF_ASSERT_EQ(0, statistics[0].outstanding);
+        STF_ASSERT_EQ(0, statistics[0].corruption_count);
+    }
+}
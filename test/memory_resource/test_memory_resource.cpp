@@ -0,0 +1,121 @@
+/*
+ *  test_memory_resource.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the MemoryResource object.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <new>
+#include <vector>
+#include <memory_resource>
+#include <terra/memory_manager/memory_manager.h>
+#include <terra/memory_manager/memory_resource.h>
+#include <terra/stf/stf.h>
+
+STF_TEST(MemoryResource, Containers)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {    64,      10,     100, true  },
+        {   256,       2,      10, true  },
+        {  4096,       1,      20, true  }
+    };
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManagerPointer memory_manager =
+        std::make_shared<Terra::MemoryManager::MemoryManager>(profile);
+
+    Terra::MemoryManager::MemoryResource memory_resource(memory_manager);
+
+    {
+        std::pmr::map<int, int> map(&memory_resource);
+        std::pmr::list<int> list(&memory_resource);
+        std::pmr::vector<int> vector(&memory_resource);
+
+        for (int i = 0; i < 50; i++)
+        {
+            map[i] = i;
+            list.push_back(i);
+        }
+        vector.resize(500);
+
+        for (int i = 0; i < 50; i++) STF_ASSERT_EQ(i, map[i]);
+
+        auto stats = memory_manager->GetStatistics();
+        STF_ASSERT_EQ(100, stats[0].outstanding);
+        STF_ASSERT_EQ(1, stats[2].outstanding);
+    }
+
+    // All memory should be returned to the Memory Manager
+    auto stats = memory_manager->GetStatistics();
+    for (const auto &statistic : stats)
+    {
+        STF_ASSERT_EQ(statistic.allocations, statistic.deallocations);
+        STF_ASSERT_EQ(0, statistic.corruption_count);
+        STF_ASSERT_EQ(0, statistic.outstanding);
+    }
+}
+
+STF_TEST(MemoryResource, Failure)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {    64,       1,       1, false }
+    };
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManagerPointer memory_manager =
+        std::make_shared<Terra::MemoryManager::MemoryManager>(profile);
+
+    Terra::MemoryManager::MemoryResource memory_resource(memory_manager);
+
+    // Requests that cannot be satisfied throw an exception
+    void *p = memory_resource.allocate(64);
+    STF_ASSERT_NE(nullptr, p);
+    STF_ASSERT_EXCEPTION(static_cast<void>(memory_resource.allocate(64)));
+    STF_ASSERT_EXCEPTION(static_cast<void>(memory_resource.allocate(128)));
+    memory_resource.deallocate(p, 64);
+
+    auto stats = memory_manager->GetStatistics();
+    STF_ASSERT_EQ(1, stats[0].allocations);
+    STF_ASSERT_EQ(1, stats[0].deallocations);
+}
+
+STF_TEST(MemoryResource, Equality)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {    64,       1,      10, true  }
+    };
+
+    // Create Memory Managers for the given profile
+    Terra::MemoryManager::MemoryManagerPointer memory_manager =
+        std::make_shared<Terra::MemoryManager::MemoryManager>(profile);
+    Terra::MemoryManager::MemoryManagerPointer other_manager =
+        std::make_shared<Terra::MemoryManager::MemoryManager>(profile);
+
+    Terra::MemoryManager::MemoryResource resource1(memory_manager);
+    Terra::MemoryManager::MemoryResource resource2(memory_manager);
+    Terra::MemoryManager::MemoryResource resource3(other_manager);
+
+    // Resources using the same Memory Manager are equal
+    STF_ASSERT_TRUE(resource1 == resource2);
+    STF_ASSERT_FALSE(resource1 == resource3);
+    STF_ASSERT_FALSE(resource1 == *std::pmr::new_delete_resource());
+}
@@ -0,0 +1,82 @@
+/*
+ *  test_no_statistics.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the MemoryManager object when built without
+ *      usage statistics.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <chrono>
+#include <vector>
+#include <terra/memory_manager/memory_manager.h>
+#include <terra/stf/stf.h>
+
+STF_TEST(NoStatistics, StatisticsRemoved)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {    64,       1,       0, true    }
+    };
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManager memory_manager(profile);
+
+    void *p = memory_manager.Allocate(64);
+    STF_ASSERT_NE(nullptr, p);
+    STF_ASSERT_TRUE(memory_manager.Free(p));
+
+    // No statistics are collected
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(1, stats.size());
+    STF_ASSERT_EQ(0, stats[0].allocations);
+    STF_ASSERT_EQ(0, stats[0].deallocations);
+}
+
+STF_TEST(NoStatistics, ReleaseIdle)
+{
+    using namespace std::chrono_literals;
+
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {    64,       1,       0, true    }
+    };
+
+    // Create a Memory Manager for the given profile
+    Terra::MemoryManager::MemoryManager memory_manager(profile);
+
+    // Leave blocks retained in the pool
+    std::vector<void *> allocations;
+    for (unsigned i = 0; i < 10; i++)
+    {
+        allocations.push_back(memory_manager.Allocate(64));
+    }
+    for (void *p : allocations) STF_ASSERT_TRUE(memory_manager.Free(p));
+
+    // The pool was used since constructed, so it is not yet idle
+    STF_ASSERT_EQ(0, memory_manager.ReleaseIdle(0ns));
+
+    // Allocating and freeing a block leaves the number of free and held
+    // blocks unchanged, but the pool is still in use and not released
+    for (unsigned i = 0; i < 5; i++)
+    {
+        void *p = memory_manager.Allocate(64);
+        STF_ASSERT_NE(nullptr, p);
+        STF_ASSERT_TRUE(memory_manager.Free(p));
+        STF_ASSERT_EQ(0, memory_manager.ReleaseIdle(0ns));
+    }
+
+    // Once no longer used, the pool is released
+    STF_ASSERT_GE(memory_manager.ReleaseIdle(0ns), 9 * 64);
+    STF_ASSERT_EQ(0, memory_manager.Trim(0));
+}
@@ -0,0 +1,256 @@
+/*
+ *  test_shared_memory_manager.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the SharedMemoryManager object.
+ *
+ *  Portability Issues:
+ *      Shared memory regions are only supported on Linux.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+#include <terra/memory_manager/memory_manager.h>
+#include <terra/memory_manager/memory_allocator.h>
+#include <terra/memory_manager/shared_memory_manager.h>
+#include <terra/stf/stf.h>
+
+#ifdef __linux__
+
+namespace
+{
+
+// Produce a region name unique to this test process
+std::string RegionName(const std::string &test)
+{
+    return "/terra_memory_manager_" + test + "_" + std::to_string(getpid());
+}
+
+} // namespace
+
+STF_TEST(SharedMemoryManager, SharedBlocks)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {  1500,       4,       4, false },
+        {    64,       2,       0, false }
+    };
+
+    const std::string name = RegionName("blocks");
+
+    // Create the region and attach to it separately
+    Terra::MemoryManager::SharedMemoryManager producer(name, profile);
+    STF_ASSERT_TRUE(producer.IsAttached());
+    STF_ASSERT_TRUE(producer.IsCreator());
+    Terra::MemoryManager::SharedMemoryManager consumer(name);
+    STF_ASSERT_TRUE(consumer.IsAttached());
+    STF_ASSERT_FALSE(consumer.IsCreator());
+
+    // A region with the same name cannot be created again
+    Terra::MemoryManager::SharedMemoryManager duplicate(name, profile);
+    STF_ASSERT_FALSE(duplicate.IsAttached());
+    STF_ASSERT_EQ(nullptr, duplicate.Allocate(64));
+
+    // The producer fills a block that the consumer reads using its offset
+    auto *p = static_cast<std::uint8_t *>(producer.Allocate(1000));
+    STF_ASSERT_NE(nullptr, p);
+    std::memset(p, 0x5a, 1000);
+    const std::uint64_t offset = producer.GetOffset(p);
+    STF_ASSERT_NE(0, offset);
+    auto *q = static_cast<std::uint8_t *>(consumer.GetPointer(offset));
+    STF_ASSERT_NE(nullptr, q);
+    STF_ASSERT_NE(p, q);
+    for (unsigned i = 0; i < 1000; i++) STF_ASSERT_EQ(0x5a, q[i]);
+
+    // The consumer frees the block, which may be freed only once
+    STF_ASSERT_TRUE(consumer.Free(q, 1000));
+    STF_ASSERT_FALSE(producer.Free(p));
+
+    // Memory outside the region cannot be freed
+    std::uint64_t buffer[16]{};
+    STF_ASSERT_FALSE(producer.Free(&buffer[8]));
+    STF_ASSERT_FALSE(producer.Free(nullptr));
+    STF_ASSERT_EQ(0, producer.GetOffset(&buffer[8]));
+    STF_ASSERT_EQ(nullptr, producer.GetPointer(0));
+
+    // Blocks are never allocated beyond those in the region, though small
+    // requests may use larger blocks; pointers are only valid in the process
+    // (and mapping) that obtained them
+    std::vector<void *> blocks;
+    while (void *block = producer.Allocate(10)) blocks.push_back(block);
+    STF_ASSERT_EQ(6, blocks.size());
+    STF_ASSERT_EQ(nullptr, consumer.Allocate(10));
+    for (void *block : blocks)
+    {
+        STF_ASSERT_FALSE(consumer.Free(block));
+        STF_ASSERT_TRUE(
+            consumer.Free(consumer.GetPointer(producer.GetOffset(block))));
+    }
+
+    // Statistics are shared by all attached objects
+    auto stats = consumer.GetStatistics();
+    STF_ASSERT_EQ(2, stats.size());
+    STF_ASSERT_EQ(64, stats[0].size);
+    STF_ASSERT_EQ(2, stats[0].allocations);
+    STF_ASSERT_EQ(4, stats[0].spilled);
+    STF_ASSERT_EQ(1500, stats[1].size);
+    STF_ASSERT_EQ(5, stats[1].allocations);
+    STF_ASSERT_EQ(4, stats[1].max_outstanding);
+    for (const auto &statistic : stats)
+    {
+        STF_ASSERT_EQ(statistic.allocations, statistic.deallocations);
+        STF_ASSERT_EQ(0, statistic.outstanding);
+        STF_ASSERT_EQ(0, statistic.corruption_count);
+    }
+    STF_ASSERT_EQ(stats[0].allocations,
+                  producer.GetStatistics()[0].allocations);
+}
+
+STF_TEST(SharedMemoryManager, CrossProcess)
+{
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed
+        {   256,       0,       8, false }
+    };
+
+    const std::string name = RegionName("process");
+    Terra::MemoryManager::SharedMemoryManager producer(name, profile);
+    STF_ASSERT_TRUE(producer.IsAttached());
+
+    // The parent allocates a block for the child to free
+    void *p = producer.Allocate(256);
+    STF_ASSERT_NE(nullptr, p);
+    const std::uint64_t parent_offset = producer.GetOffset(p);
+
+    int fds[2];
+    STF_ASSERT_EQ(0, pipe(fds));
+
+    const pid_t child = fork();
+    STF_ASSERT_GE(child, 0);
+    if (child == 0)
+    {
+        // In the child, attach to the region, free the parent's block, and
+        // fill a new block for the parent
+        int result = 1;
+        {
+            Terra::MemoryManager::SharedMemoryManager consumer(name);
+            auto *q = static_cast<std::uint8_t *>(consumer.Allocate(200));
+            if (consumer.IsAttached() &&
+                consumer.Free(consumer.GetPointer(parent_offset)) &&
+                (q != nullptr))
+            {
+                std::memset(q, 0x3c, 200);
+                const std::uint64_t offset = consumer.GetOffset(q);
+                if (write(fds[1], &offset, sizeof(offset)) ==
+                    static_cast<ssize_t>(sizeof(offset)))
+                {
+                    result = 0;
+                }
+            }
+        }
+        _exit(result);
+    }
+
+    // Wait for the child, then read and free its block
+    close(fds[1]);
+    std::uint64_t offset = 0;
+    STF_ASSERT_EQ(static_cast<ssize_t>(sizeof(offset)),
+                  read(fds[0], &offset, sizeof(offset)));
+    close(fds[0]);
+    int status = -1;
+    STF_ASSERT_EQ(child, waitpid(child, &status, 0));
+    STF_ASSERT_TRUE(WIFEXITED(status));
+    STF_ASSERT_EQ(0, WEXITSTATUS(status));
+
+    auto *q = static_cast<std::uint8_t *>(producer.GetPointer(offset));
+    STF_ASSERT_NE(nullptr, q);
+    for (unsigned i = 0; i < 200; i++) STF_ASSERT_EQ(0x3c, q[i]);
+    STF_ASSERT_TRUE(producer.Free(q));
+
+    auto stats = producer.GetStatistics();
+    STF_ASSERT_EQ(2, stats[0].allocations);
+    STF_ASSERT_EQ(2, stats[0].deallocations);
+    STF_ASSERT_EQ(0, stats[0].outstanding);
+}
+
+STF_TEST(SharedMemoryManager, Descriptors)
+{
+    using Terra::MemoryManager::SpillPolicy;
+
+    // Define the memory profile
+    Terra::MemoryManager::MemoryProfile profile =
+    {
+        // Size, Minimum, Maximum, Excess Allowed, Slab Blocks, Alignment
+        {    64,       1,       1, false,          0,           0    },
+        {   128,       1,       1, false,          0,           256  },
+        {   512,       1,       1, false,          0,           0    }
+    };
+    profile[0].spill = SpillPolicy::Never;
+
+    const std::string name = RegionName("descriptors");
+    Terra::MemoryManager::SharedMemoryManager memory_manager(name, profile);
+    STF_ASSERT_TRUE(memory_manager.IsAttached());
+
+    // Strict alignment requests use suitably aligned descriptors
+    void *p = memory_manager.Allocate(8, 256);
+    STF_ASSERT_NE(nullptr, p);
+    STF_ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(p) % 256);
+    STF_ASSERT_EQ(nullptr, memory_manager.Allocate(8, 3));
+
+    // Requests for the first descriptor never spill into larger blocks
+    void *q = memory_manager.Allocate(64);
+    STF_ASSERT_NE(nullptr, q);
+    STF_ASSERT_EQ(nullptr, memory_manager.Allocate(64));
+
+    // Requests for larger descriptors may still spill
+    void *r = memory_manager.Allocate(100);
+    STF_ASSERT_NE(nullptr, r);
+
+    // The SharedMemoryManager may be used with the MemoryAllocator
+    auto shared =
+        std::make_shared<Terra::MemoryManager::SharedMemoryManager>(
+            RegionName("allocator"),
+            Terra::MemoryManager::MemoryProfile{{64, 0, 16, false}});
+    {
+        std::vector<int,
+                    Terra::MemoryManager::MemoryAllocator<
+                        int,
+                        Terra::MemoryManager::SharedMemoryManager>>
+            vector(shared);
+        for (int i = 0; i < 10; i++) vector.push_back(i);
+        for (int i = 0; i < 10; i++)
+        {
+            STF_ASSERT_EQ(i, vector[static_cast<std::size_t>(i)]);
+        }
+    }
+    STF_ASSERT_EQ(0, shared->GetStatistics()[0].outstanding);
+
+    STF_ASSERT_TRUE(memory_manager.Free(p));
+    STF_ASSERT_TRUE(memory_manager.Free(q));
+    STF_ASSERT_TRUE(memory_manager.Free(r));
+
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(1, stats[0].allocations);
+    STF_ASSERT_EQ(1, stats[0].unfulfilled);
+    STF_ASSERT_EQ(0, stats[0].spilled);
+    STF_ASSERT_EQ(1, stats[1].spilled);
+    STF_ASSERT_EQ(1, stats[1].allocations);
+    STF_ASSERT_EQ(1, stats[2].allocations);
+}
+
+#endif
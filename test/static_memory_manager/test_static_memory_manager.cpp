@@ -0,0 +1,261 @@
+/*
+ *  test_static_memory_manager.cpp
+ *
+ *  Copyright (C) 2026
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the StaticMemoryManager object.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <vector>
+#include <map>
+#include <memory>
+#include <thread>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <terra/memory_manager/static_memory_manager.h>
+#include <terra/memory_manager/memory_allocator.h>
+#include <terra/stf/stf.h>
+
+namespace
+{
+
+using Terra::MemoryManager::MemoryDescriptor;
+
+// Memory Manager with a profile defined at compile time
+using TestMemoryManager = Terra::MemoryManager::StaticMemoryManager<
+    // Size, Minimum, Maximum, Excess Allowed, Slab Blocks, Alignment
+    MemoryDescriptor{    64,      10,      20, true  },
+    MemoryDescriptor{   256,       2,       4, false },
+    MemoryDescriptor{  4096,       1,       4, true,           0, 4096 }>;
+
+// Descriptors for constant sizes are selected at compile time
+static_assert(TestMemoryManager::SelectDescriptor(1) == 0);
+static_assert(TestMemoryManager::SelectDescriptor(64) == 0);
+static_assert(TestMemoryManager::SelectDescriptor(65) == 1);
+static_assert(TestMemoryManager::SelectDescriptor(4096) == 2);
+static_assert(TestMemoryManager::SelectDescriptor(4097) == 3);
+
+} // namespace
+
+STF_TEST(StaticMemMgr, Basic)
+{
+    TestMemoryManager memory_manager;
+
+    // Allocate memory of each size and ensure it is usable
+    std::vector<void *> allocations;
+    for (std::size_t size : {1, 64, 100, 256, 1000, 4096})
+    {
+        void *p = memory_manager.Allocate(size);
+        STF_ASSERT_NE(nullptr, p);
+        std::memset(p, 0xff, size);
+        allocations.push_back(p);
+    }
+
+    // Requests too large for any descriptor fail
+    STF_ASSERT_EQ(nullptr, memory_manager.Allocate(4097));
+
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(3, stats.size());
+    STF_ASSERT_EQ(64, stats[0].size);
+    STF_ASSERT_EQ(2, stats[0].outstanding);
+    STF_ASSERT_EQ(2, stats[1].outstanding);
+    STF_ASSERT_EQ(2, stats[2].outstanding);
+
+    for (auto *p : allocations) STF_ASSERT_TRUE(memory_manager.Free(p));
+
+    // Freeing nullptr or a foreign block fails
+    STF_ASSERT_FALSE(memory_manager.Free(nullptr));
+    TestMemoryManager other_manager;
+    void *p = other_manager.Allocate(64);
+    STF_ASSERT_FALSE(memory_manager.Free(p));
+    STF_ASSERT_TRUE(other_manager.Free(p));
+
+    stats = memory_manager.GetStatistics();
+    for (const auto &statistic : stats)
+    {
+        STF_ASSERT_EQ(2, statistic.allocations);
+        STF_ASSERT_EQ(2, statistic.deallocations);
+        STF_ASSERT_EQ(0, statistic.outstanding);
+        STF_ASSERT_EQ(0, statistic.corruption_count);
+    }
+}
+
+STF_TEST(StaticMemMgr, SpillPolicies)
+{
+    using Terra::MemoryManager::MemorySource;
+    using Terra::MemoryManager::SpillPolicy;
+
+    // Small requests may use at most two larger blocks at once, and medium
+    // requests never spill to the largest descriptor
+    using SpillMemoryManager = Terra::MemoryManager::StaticMemoryManager<
+        // Size, Minimum, Maximum, Excess Allowed, Slab Blocks, Alignment,
+        // Source, Prefault, Lock Pages, Stripes, Spill, Spill Limit
+        MemoryDescriptor{    64,       2,       2, false,          0,    0,
+                             MemorySource::Heap, false, false, 0,
+                             SpillPolicy::Budget, 2 },
+        MemoryDescriptor{   256,       4,       4, false,          0,    0,
+                             MemorySource::Heap, false, false, 0,
+                             SpillPolicy::Never },
+        MemoryDescriptor{  4096,       1,       1, false }>;
+    SpillMemoryManager memory_manager;
+
+    std::vector<void *> allocations;
+    for (unsigned i = 0; i < 4; i++)
+    {
+        allocations.push_back(memory_manager.Allocate(64));
+        STF_ASSERT_NE(nullptr, allocations.back());
+    }
+    STF_ASSERT_EQ(nullptr, memory_manager.Allocate(64));
+
+    // Freeing a spilled block returns its share of the budget
+    STF_ASSERT_TRUE(memory_manager.Free(allocations.back()));
+    allocations.back() = memory_manager.Allocate(64);
+    STF_ASSERT_NE(nullptr, allocations.back());
+
+    // Medium requests fail once their own descriptor is exhausted
+    allocations.push_back(memory_manager.Allocate(200));
+    allocations.push_back(memory_manager.Allocate(200));
+    STF_ASSERT_NE(nullptr, allocations.back());
+    STF_ASSERT_EQ(nullptr, memory_manager.Allocate(200));
+
+    // The largest block remains available to large requests
+    allocations.push_back(memory_manager.Allocate(4096));
+    STF_ASSERT_NE(nullptr, allocations.back());
+
+    for (auto *p : allocations) STF_ASSERT_TRUE(memory_manager.Free(p));
+
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(3, stats[0].spilled);
+    STF_ASSERT_EQ(0, stats[1].spilled);
+    STF_ASSERT_EQ(5, stats[1].allocations);
+    for (const auto &statistic : stats)
+    {
+        STF_ASSERT_EQ(0, statistic.outstanding);
+    }
+}
+
+STF_TEST(StaticMemMgr, Limits)
+{
+    TestMemoryManager memory_manager;
+
+    // Requests beyond the maximum for a descriptor not allowing excess use
+    // the next larger descriptor
+    std::vector<void *> allocations;
+    for (unsigned i = 0; i < 8; i++)
+    {
+        void *p = memory_manager.Allocate(200);
+        STF_ASSERT_NE(nullptr, p);
+        allocations.push_back(p);
+    }
+
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(4, stats[1].allocations);
+    STF_ASSERT_EQ(4, stats[1].unfulfilled);
+    STF_ASSERT_EQ(4, stats[1].spilled);
+    STF_ASSERT_EQ(4, stats[2].allocations);
+
+    // Blocks are aligned as the descriptor requires
+    for (unsigned i = 4; i < 8; i++)
+    {
+        STF_ASSERT_EQ(
+            0,
+            reinterpret_cast<std::uintptr_t>(allocations[i]) % 4096);
+    }
+
+    // Requests needing stricter alignment use a suitable descriptor
+    void *aligned = memory_manager.Allocate(64, 4096);
+    STF_ASSERT_NE(nullptr, aligned);
+    STF_ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(aligned) % 4096);
+    STF_ASSERT_EQ(nullptr, memory_manager.Allocate(64, 8192));
+    STF_ASSERT_EQ(nullptr, memory_manager.Allocate(64, 3));
+    allocations.push_back(aligned);
+
+    // Excess blocks are returned to the heap when freed
+    for (auto *p : allocations) STF_ASSERT_TRUE(memory_manager.Free(p));
+
+    // A size larger than requested indicates corruption
+    void *p = memory_manager.Allocate(64);
+    STF_ASSERT_TRUE(memory_manager.Free(p, 65));
+
+    stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(1, stats[0].corruption_count);
+    STF_ASSERT_EQ(5, stats[2].allocations);
+    STF_ASSERT_EQ(5, stats[2].deallocations);
+    STF_ASSERT_EQ(5, stats[2].max_outstanding);
+    for (const auto &statistic : stats)
+    {
+        STF_ASSERT_EQ(0, statistic.outstanding);
+    }
+}
+
+STF_TEST(StaticMemMgr, Allocators)
+{
+    auto memory_manager = std::make_shared<TestMemoryManager>();
+
+    {
+        // Use the MemoryAllocator with the StaticMemoryManager
+        using Allocator = Terra::MemoryManager::MemoryAllocator<
+            std::pair<const int, int>,
+            TestMemoryManager>;
+        std::map<int, int, std::less<int>, Allocator> map(memory_manager);
+        for (int i = 0; i < 100; i++) map[i] = i;
+        for (int i = 0; i < 100; i++) STF_ASSERT_EQ(i, map[i]);
+
+        // So may the NonOwningMemoryAllocator
+        std::vector<int,
+                    Terra::MemoryManager::NonOwningMemoryAllocator<
+                        int,
+                        TestMemoryManager>>
+            vector(*memory_manager);
+        for (int i = 0; i < 100; i++) vector.push_back(i);
+        for (int i = 0; i < 100; i++)
+        {
+            STF_ASSERT_EQ(i, vector[static_cast<std::size_t>(i)]);
+        }
+    }
+
+    auto stats = memory_manager->GetStatistics();
+    STF_ASSERT_GE(stats[0].allocations, 100);
+    for (const auto &statistic : stats)
+    {
+        STF_ASSERT_EQ(statistic.allocations, statistic.deallocations);
+        STF_ASSERT_EQ(0, statistic.outstanding);
+    }
+}
+
+STF_TEST(StaticMemMgr, Threads)
+{
+    TestMemoryManager memory_manager;
+
+    // Several threads allocate and free memory
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < 4; t++)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                for (unsigned i = 0; i < 1000; i++)
+                {
+                    void *p = memory_manager.Allocate(i % 2 ? 64 : 4096);
+                    if (p != nullptr) memory_manager.Free(p);
+                }
+            });
+    }
+    for (auto &thread : threads) thread.join();
+
+    auto stats = memory_manager.GetStatistics();
+    STF_ASSERT_EQ(2000, stats[0].allocations);
+    STF_ASSERT_EQ(2000, stats[2].allocations);
+    for (const auto &statistic : stats)
+    {
+        STF_ASSERT_EQ(statistic.allocations, statistic.deallocations);
+        STF_ASSERT_EQ(0, statistic.outstanding);
+    }
+}